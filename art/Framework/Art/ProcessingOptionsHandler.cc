@@ -2,9 +2,9 @@
 
 #include "art/Framework/Art/detail/exists_outside_prolog.h"
 #include "art/Framework/Art/detail/fhicl_key.h"
+#include "art/Utilities/ResourceBudget.h"
 #include "canvas/Utilities/Exception.h"
 #include "fhiclcpp/intermediate_table.h"
-#include "tbb/task_arena.h"
 
 #include <string>
 
@@ -54,7 +54,7 @@ art::ProcessingOptionsHandler::ProcessingOptionsHandler(
     ("parallelism,j",
        bpo::value<int>(),
        "Number of threads AND schedules to use for event processing "
-       "(default = 1, 0 = all cores).")
+       "(default = 1, 0 = all available cores).")
     ("nschedules",
        bpo::value<int>(),
        "Number of schedules to use for event processing (default = 1)")
@@ -62,7 +62,7 @@ art::ProcessingOptionsHandler::ProcessingOptionsHandler(
     ("nthreads",
        bpo::value<int>(),
        "Number of threads to use for event processing (default = 1, 0 = all "
-       "cores)")
+       "available cores)")
     ("default-exceptions",
        "Some exceptions may be handled differently by default (e.g. "
        "ProductNotFound).")
@@ -102,6 +102,10 @@ art::ProcessingOptionsHandler::doCheckOptions(bpo::variables_map const& vm)
     }
   }
 
+  if (vm.count("parallelism") and vm["parallelism"].as<int>() < 0) {
+    throw Exception(errors::Configuration)
+      << "Option -j/--parallelism must be greater than or equal to 0.";
+  }
   if (vm.count("nthreads") and vm["nthreads"].as<int>() < 0) {
     throw Exception(errors::Configuration)
       << "Option --nthreads must greater than or equal to 0.";
@@ -147,7 +151,7 @@ art::ProcessingOptionsHandler::doProcessOptions(
     // 'nthreads' and 'nschedules' are set to the same value.
     auto const j = vm["parallelism"].as<int>();
     auto const nthreads =
-      (j == 0) ? tbb::this_task_arena::max_concurrency() : j;
+      (j == 0) ? static_cast<int>(art::available_cores()) : j;
     raw_config.put(num_schedules_key, nthreads);
     raw_config.put(num_threads_key, nthreads);
     return 0;
@@ -159,7 +163,7 @@ art::ProcessingOptionsHandler::doProcessOptions(
   if (vm.count("nthreads")) {
     auto const nt = vm["nthreads"].as<int>();
     auto const nthreads =
-      (nt == 0) ? tbb::this_task_arena::max_concurrency() : nt;
+      (nt == 0) ? static_cast<int>(art::available_cores()) : nt;
     raw_config.put(num_threads_key, nthreads);
   }
 
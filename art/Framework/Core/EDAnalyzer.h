@@ -22,6 +22,7 @@ namespace art {
     using ModuleType = EDAnalyzer;
 
     using detail::LegacyModule::serialTaskQueueChain;
+    using detail::LegacyModule::serializationStatistics;
     using detail::LegacyModule::sharedResources;
 
   protected:
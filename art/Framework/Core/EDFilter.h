@@ -18,6 +18,7 @@ namespace art {
     using ModuleType = EDFilter;
 
     using detail::LegacyModule::serialTaskQueueChain;
+    using detail::LegacyModule::serializationStatistics;
     using detail::LegacyModule::sharedResources;
 
   protected:
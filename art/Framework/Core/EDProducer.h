@@ -17,6 +17,7 @@ namespace art {
     using ModuleType = EDProducer;
 
     using detail::LegacyModule::serialTaskQueueChain;
+    using detail::LegacyModule::serializationStatistics;
     using detail::LegacyModule::sharedResources;
 
   protected:
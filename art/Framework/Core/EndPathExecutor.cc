@@ -12,6 +12,7 @@
 #include "art/Framework/Principal/Worker.h"
 #include "art/Persistency/Provenance/PathContext.h"
 #include "art/Persistency/Provenance/ScheduleContext.h"
+#include "art/Utilities/FrameworkPhases.h"
 #include "art/Utilities/GlobalTaskGroup.h"
 #include "art/Utilities/ScheduleID.h"
 #include "art/Utilities/TaskDebugMacros.h"
@@ -21,6 +22,7 @@
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include "range/v3/view.hpp"
 
+#include <chrono>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -291,6 +293,7 @@ namespace art {
   {
     auto const sid = sc_.id();
     TDEBUG_BEGIN_FUNC_SI(4, sid);
+    FrameworkPhaseSentry const sentry{FrameworkPhase::TaskSpawning, sid};
     endPathInfo_.reset_for_event();
     endPathInfo_.incrementTotalEventCount();
     try {
@@ -308,22 +311,116 @@ namespace art {
     TDEBUG_END_FUNC_SI(4, sid);
   }
 
+  class EndPathExecutor::WritesDoneTask {
+  public:
+    WritesDoneTask(EndPathExecutor* const endPathExec,
+                   WaitingTaskPtr const eventWrittenTask,
+                   EventPrincipal& principal,
+                   GlobalTaskGroup& taskGroup)
+      : endPathExec_{endPathExec}
+      , eventWrittenTask_{eventWrittenTask}
+      , principal_{principal}
+      , taskGroup_{taskGroup}
+    {}
+
+    void
+    operator()(exception_ptr const ex)
+    {
+      auto const scheduleID = endPathExec_->sc_.id();
+
+      // Note: When we start our parent task is the eventLoop task.
+      TDEBUG_BEGIN_TASK_SI(4, scheduleID);
+
+      if (ex) {
+        taskGroup_.may_run(eventWrittenTask_, ex);
+        TDEBUG_END_TASK_SI(4, scheduleID)
+          << "event writing terminated because of EXCEPTION";
+        return;
+      }
+
+      try {
+        auto const& eid = principal_.eventID();
+        bool const lastInSubRun{principal_.isLastInSubRun()};
+        TDEBUG_FUNC_SI(5, scheduleID)
+          << "eid: " << eid.run() << ", " << eid.subRun() << ", "
+          << eid.event();
+        endPathExec_->runRangeSetHandler_->update(eid, lastInSubRun);
+        endPathExec_->subRunRangeSetHandler_->update(eid, lastInSubRun);
+        taskGroup_.may_run(eventWrittenTask_);
+      }
+      catch (...) {
+        taskGroup_.may_run(eventWrittenTask_, current_exception());
+      }
+      TDEBUG_END_TASK_SI(4, scheduleID);
+    }
+
+  private:
+    EndPathExecutor* const endPathExec_;
+    WaitingTaskPtr const eventWrittenTask_;
+    EventPrincipal& principal_;
+    GlobalTaskGroup& taskGroup_;
+  };
+
+  // Note: We come here as part of the endPath task, our parent task
+  // is the eventLoop task.
   void
-  EndPathExecutor::writeEvent(EventPrincipal& ep)
+  EndPathExecutor::writeEvent(WaitingTaskPtr eventWrittenTask,
+                              EventPrincipal& ep)
   {
-    // We don't worry about providing the sorted list of module names
-    // for the end_path right now.  If users decide it is necessary to
-    // know what they are, then we can provide them.
-    PathContext const pc{sc_, PathContext::end_path_spec(), {}};
-    for (auto ow : outputWorkers_) {
-      ow->writeEvent(ep, pc);
-    }
-    auto const& eid = ep.eventID();
-    bool const lastInSubRun{ep.isLastInSubRun()};
-    TDEBUG_FUNC_SI(5, sc_.id())
-      << "eid: " << eid.run() << ", " << eid.subRun() << ", " << eid.event();
-    runRangeSetHandler_->update(eid, lastInSubRun);
-    subRunRangeSetHandler_->update(eid, lastInSubRun);
+    auto const sid = sc_.id();
+    TDEBUG_BEGIN_FUNC_SI(4, sid);
+    // One count per output worker, plus one that is released once all
+    // writes have been queued.  The extra count also covers the case
+    // where there are no output workers.
+    auto writesDoneTask = std::make_shared<WaitingTask>(
+      WritesDoneTask{this, eventWrittenTask, ep, taskGroup_},
+      outputWorkers_.size() + 1);
+    PathContext const queuedContext{sc_, PathContext::end_path_spec(), {}};
+    std::size_t nQueued{};
+    try {
+      for (auto ow : outputWorkers_) {
+        ow->eventWriteQueued(queuedContext);
+        auto const queued = chrono::steady_clock::now();
+        ow->writeQueue().push([this, ow, &ep, writesDoneTask, queued] {
+          writeWaitTime_ += (chrono::steady_clock::now() - queued).count();
+          TDEBUG_BEGIN_TASK_SI(4, sc_.id());
+          try {
+            // We don't worry about providing the sorted list of module
+            // names for the end_path right now.  If users decide it is
+            // necessary to know what they are, then we can provide
+            // them.
+            PathContext const pc{sc_, PathContext::end_path_spec(), {}};
+            ow->writeEvent(ep, pc);
+            // The closure request must be recorded while we still
+            // have exclusive access to the output module.
+            recordOutputClosureRequest_(ow, Granularity::Event);
+            taskGroup_.may_run(writesDoneTask);
+          }
+          catch (...) {
+            taskGroup_.may_run(writesDoneTask, current_exception());
+          }
+          TDEBUG_END_TASK_SI(4, sc_.id());
+        });
+        ++nQueued;
+      }
+    }
+    catch (...) {
+      // The writes already queued still use the event, so the event
+      // may only be finished by the writesDoneTask.  Release the
+      // counts of the writes that were not queued, with the exception.
+      auto const ex = current_exception();
+      for (auto n = outputWorkers_.size() - nQueued; n != 0; --n) {
+        taskGroup_.may_run(writesDoneTask, ex);
+      }
+    }
+    taskGroup_.may_run(writesDoneTask);
+    TDEBUG_END_FUNC_SI(4, sid);
+  }
+
+  chrono::steady_clock::duration
+  EndPathExecutor::writeWaitTime() const
+  {
+    return chrono::steady_clock::duration{writeWaitTime_.load()};
   }
 
   bool
@@ -394,14 +491,22 @@ namespace art {
   EndPathExecutor::recordOutputClosureRequests(Granularity const atBoundary)
   {
     for (auto ow : outputWorkers_) {
-      if (atBoundary < ow->fileGranularity()) {
-        // The boundary we are checking at is finer than the checks
-        // the output worker needs, nothing to do.
-        continue;
-      }
-      if (ow->requestsToCloseFile()) {
-        outputWorkersToClose_.insert(ow);
-      }
+      recordOutputClosureRequest_(ow, atBoundary);
+    }
+  }
+
+  void
+  EndPathExecutor::recordOutputClosureRequest_(OutputWorker* const ow,
+                                               Granularity const atBoundary)
+  {
+    if (atBoundary < ow->fileGranularity()) {
+      // The boundary we are checking at is finer than the checks the
+      // output worker needs, nothing to do.
+      return;
+    }
+    if (ow->requestsToCloseFile()) {
+      std::lock_guard sentry{outputWorkersToCloseMutex_};
+      outputWorkersToClose_.insert(ow);
     }
   }
 
@@ -28,7 +28,9 @@
 #include "hep_concurrency/WaitingTask.h"
 
 #include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 
@@ -83,7 +85,21 @@ namespace art {
     // first-come first-served basis (FIFO).
     void process_event(hep::concurrency::WaitingTaskPtr finalizeEventTask,
                        EventPrincipal&);
-    void writeEvent(EventPrincipal&);
+
+    // Write Event
+    //
+    // The event is handed to the write queue of each output worker,
+    // so that writes to different output modules are not serialized
+    // with respect to each other.  The eventWrittenTask is launched
+    // once all output modules have written the event.  It is also how
+    // a failure is reported: an exception thrown while queuing the
+    // writes is passed to the eventWrittenTask, once the writes that
+    // were already queued have finished with the event.
+    void writeEvent(hep::concurrency::WaitingTaskPtr eventWrittenTask,
+                    EventPrincipal&);
+    // Total time the events of this schedule have waited in the
+    // write queues of the output workers.
+    std::chrono::steady_clock::duration writeWaitTime() const;
 
     // Output File Switching API
     //
@@ -118,6 +134,9 @@ namespace art {
 
   private:
     class PathsDoneTask;
+    class WritesDoneTask;
+
+    void recordOutputClosureRequest_(OutputWorker*, Granularity);
 
     // Filled by ctor, const after that.
     ScheduleContext const sc_;
@@ -142,6 +161,12 @@ namespace art {
     // to populate the list, then uses the list to do closes, then uses the same
     // list to do opens, then clears the list.
     std::set<OutputWorker*> outputWorkersToClose_{};
+    // Protects outputWorkersToClose_, which may be updated by the
+    // write tasks of different output modules at the same time.
+    std::mutex outputWorkersToCloseMutex_{};
+    // Updated by the write tasks of different output modules at the
+    // same time.
+    std::atomic<std::chrono::steady_clock::rep> writeWaitTime_{0};
   };
 } // namespace art
 
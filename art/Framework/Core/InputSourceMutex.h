@@ -2,20 +2,9 @@
 #define art_Framework_Core_InputSourceMutex_h
 // vim: set sw=2 expandtab :
 
-#include <mutex>
-
-namespace art {
-
-  class InputSourceMutexSentry {
-  public:
-    ~InputSourceMutexSentry() noexcept;
-    InputSourceMutexSentry();
-
-  private:
-    static std::recursive_mutex inputSourceMutex_;
-  };
-
-} // namespace art
+// The input-source lock is also taken by DelayedReader, and so now
+// lives with it in Principal.
+#include "art/Framework/Principal/InputSourceMutex.h"
 
 #endif /* art_Framework_Core_InputSourceMutex_h */
 
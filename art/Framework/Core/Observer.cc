@@ -3,6 +3,7 @@
 
 #include "art/Framework/Principal/Event.h"
 #include "art/Persistency/Provenance/PathSpec.h"
+#include "art/Utilities/FrameworkPhases.h"
 #include "art/Utilities/Globals.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "fhiclcpp/ParameterSetID.h"
@@ -65,6 +66,7 @@ namespace art {
     if (wantAllEvents_) {
       return true;
     }
+    FrameworkPhaseSentry const sentry{FrameworkPhase::OutputSelection, id};
     bool const select_event = selectors_ ? selectors_->matchEvent(id, e) : true;
     bool const reject_event =
       rejectors_ ? rejectors_->matchEvent(id, e) : false;
@@ -240,6 +240,11 @@ The ROOT output module supports the placeholders described at:
     // For diagnostics.
     std::vector<std::string> pluginNames_{};
     PluginCollection_t plugins_;
+
+    // Serializes event writes to this module.  It is created by the
+    // first OutputWorker constructed for this module and is co-owned
+    // by the workers of all schedules.
+    std::shared_ptr<hep::concurrency::SerialTaskQueue> writeQueue_{nullptr};
   };
 
 } // namespace art
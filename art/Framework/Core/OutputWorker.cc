@@ -6,6 +6,7 @@
 #include "art/Framework/Principal/fwd.h"
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Persistency/Provenance/ModuleContext.h"
+#include "art/Utilities/FrameworkPhases.h"
 #include "art/Utilities/OutputFileInfo.h"
 #include "fhiclcpp/ParameterSetRegistry.h"
 
@@ -26,6 +27,11 @@ namespace art {
       module_->registerProducts(wp.producedProducts_);
       wp.resources_.registerSharedResources(module_->sharedResources());
     }
+    if (!module_->writeQueue_) {
+      module_->writeQueue_ =
+        std::make_shared<hep::concurrency::SerialTaskQueue>(wp.taskGroup_);
+    }
+    writeQueue_ = module_->writeQueue_;
     ci_->outputModuleInitiated(
       label(),
       fhicl::ParameterSetRegistry::get(description().parameterSetID()));
@@ -37,6 +43,12 @@ namespace art {
     return module_->serialTaskQueueChain();
   }
 
+  detail::SerializationStatistics*
+  OutputWorker::doSerializationStatistics() const
+  {
+    return module_->serializationStatistics();
+  }
+
   void
   OutputWorker::doBeginJob(detail::SharedResources const& resources)
   {
@@ -156,15 +168,34 @@ namespace art {
     module_->doWriteSubRun(srp);
   }
 
+  // Called when a write of the event has been placed on the write
+  // queue of the module; sPreWriteEvent follows once it has reached
+  // the front of the queue.
+  void
+  OutputWorker::eventWriteQueued(PathContext const& pc) const
+  {
+    actReg_.sModuleQueued.invoke(ModuleContext{pc, description()});
+  }
+
   void
   OutputWorker::writeEvent(EventPrincipal& ep, PathContext const& pc)
   {
     ModuleContext const mc{pc, description()};
     actReg_.sPreWriteEvent.invoke(mc);
-    module_->doWriteEvent(ep, mc);
+    {
+      FrameworkPhaseSentry const sentry{FrameworkPhase::EventWrite,
+                                        mc.scheduleID()};
+      module_->doWriteEvent(ep, mc);
+    }
     actReg_.sPostWriteEvent.invoke(mc);
   }
 
+  hep::concurrency::SerialTaskQueue&
+  OutputWorker::writeQueue() const
+  {
+    return *writeQueue_;
+  }
+
   void
   OutputWorker::setRunAuxiliaryRangeSetID(RangeSet const& rs)
   {
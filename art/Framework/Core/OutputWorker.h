@@ -7,6 +7,12 @@
 //
 //  According to our current definition, a single output module can
 //  only appear in one worker.
+//
+//  Event writes are not invoked directly by the schedule.  Instead,
+//  they are pushed onto the write queue of the worker, which is
+//  shared by all workers of the same output module.  Writes to a
+//  given output module are thereby serialized, whereas writes to
+//  different output modules may proceed concurrently.
 
 #include "art/Framework/Core/OutputFileGranularity.h"
 #include "art/Framework/Core/OutputFileStatus.h"
@@ -17,6 +23,7 @@
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Persistency/Provenance/fwd.h"
 #include "canvas/Persistency/Provenance/fwd.h"
+#include "hep_concurrency/SerialTaskQueue.h"
 
 #include <memory>
 
@@ -35,7 +42,9 @@ namespace art {
     void openFile(FileBlock const& fb);
     void writeRun(RunPrincipal& rp);
     void writeSubRun(SubRunPrincipal& srp);
+    void eventWriteQueued(PathContext const& pc) const;
     void writeEvent(EventPrincipal& ep, PathContext const& pc);
+    hep::concurrency::SerialTaskQueue& writeQueue() const;
     void setRunAuxiliaryRangeSetID(RangeSet const&);
     void setSubRunAuxiliaryRangeSetID(RangeSet const&);
     void setFileStatus(OutputFileStatus);
@@ -45,6 +54,8 @@ namespace art {
   private:
     hep::concurrency::SerialTaskQueueChain* doSerialTaskQueueChain()
       const override;
+    detail::SerializationStatistics* doSerializationStatistics()
+      const override;
     void doBeginJob(detail::SharedResources const&) override;
     void doEndJob() override;
     void doRespondToOpenInputFile(FileBlock const&) override;
@@ -64,6 +75,7 @@ namespace art {
     ServiceHandle<CatalogInterface> ci_{};
     ActivityRegistry const& actReg_;
     Granularity fileGranularity_{Granularity::Unset};
+    std::shared_ptr<hep::concurrency::SerialTaskQueue> writeQueue_;
   };
 } // namespace art
 
@@ -19,8 +19,11 @@
 #include "hep_concurrency/WaitingTask.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <exception>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -195,6 +198,11 @@ namespace art {
     actReg_.sPreProcessPath.invoke(pc_);
     ++timesRun_;
     state_ = hlt::Ready;
+    if (graph_ && !workers_.empty()) {
+      process_event_graph(ep, pathsDoneTask);
+      TDEBUG_END_FUNC_SI(4, sid);
+      return;
+    }
     size_t idx = 0;
     auto max_idx = workers_.size();
     // Start the task spawn chain going with the first worker on the
@@ -403,4 +411,179 @@ namespace art {
                            << (ex_ptr ? " EXCEPTION" : "");
   }
 
+  void
+  Path::runAsGraph(vector<vector<size_t>> const& predecessors)
+  {
+    assert(predecessors.size() == workers_.size());
+    auto graph = make_unique<Graph>(workers_.size());
+    for (size_t idx = 0; idx < predecessors.size(); ++idx) {
+      for (auto const pred : predecessors[idx]) {
+        assert(pred < idx);
+        graph->successors[pred].push_back(idx);
+      }
+      graph->numPredecessors[idx] = predecessors[idx].size();
+    }
+    graph_ = move(graph);
+  }
+
+  // When the path is run as a graph, every worker whose predecessors
+  // have all run, and passed, is started at once.  A worker that
+  // rejects the event, or throws, does not release its successors.
+  // The path is finished by whichever worker is the last to complete.
+  void
+  Path::process_event_graph(EventPrincipal& ep, WaitingTaskPtr pathsDone)
+  {
+    auto const sid = pc_.scheduleID();
+    TDEBUG_BEGIN_FUNC_SI(4, sid);
+    auto& graph = *graph_;
+    vector<size_t> roots;
+    for (size_t idx = 0; idx < workers_.size(); ++idx) {
+      graph.waitingFor[idx] = graph.numPredecessors[idx];
+      if (graph.numPredecessors[idx] == 0) {
+        roots.push_back(idx);
+      }
+    }
+    graph.failedIdx = numeric_limits<size_t>::max();
+    graph.excepted = false;
+    graph.exception = nullptr;
+    graph.exceptionIdx = 0;
+    // The first worker on the path never has predecessors.
+    assert(!roots.empty());
+    graph.running = roots.size();
+    for (auto const idx : roots) {
+      runGraphWorker_asynch(idx, ep, pathsDone);
+    }
+    TDEBUG_END_FUNC_SI(4, sid) << "roots: " << roots.size();
+  }
+
+  void
+  Path::runGraphWorker_asynch(size_t const idx,
+                              EventPrincipal& ep,
+                              WaitingTaskPtr pathsDone)
+  {
+    taskGroup_.run([this, idx, &ep, pathsDone] {
+      auto const sid = pc_.scheduleID();
+      TDEBUG_BEGIN_TASK_SI(4, sid) << "idx: " << idx;
+      try {
+        auto workerDoneTask =
+          make_waiting_task<GraphWorkerDoneTask>(this, idx, ep, pathsDone);
+        workers_[idx].run(workerDoneTask, ep);
+      }
+      catch (...) {
+        process_event_graphWorkerFinished(
+          idx, false, current_exception(), ep, pathsDone);
+      }
+      TDEBUG_END_TASK_SI(4, sid) << "idx: " << idx;
+    });
+  }
+
+  class Path::GraphWorkerDoneTask {
+  public:
+    GraphWorkerDoneTask(Path* path,
+                        size_t const idx,
+                        EventPrincipal& ep,
+                        WaitingTaskPtr pathsDone)
+      : path_{path}, idx_{idx}, ep_{ep}, pathsDone_{pathsDone}
+    {}
+    void
+    operator()(exception_ptr ex)
+    {
+      // Note: This will only be set false by a filter which has rejected.
+      bool const should_continue = path_->workers_[idx_].returnCode();
+      path_->process_event_graphWorkerFinished(
+        idx_, should_continue, ex, ep_, pathsDone_);
+    }
+
+  private:
+    Path* path_;
+    size_t const idx_;
+    EventPrincipal& ep_;
+    WaitingTaskPtr pathsDone_;
+  };
+
+  void
+  Path::process_event_graphWorkerFinished(size_t const idx,
+                                          bool should_continue,
+                                          exception_ptr ex,
+                                          EventPrincipal& ep,
+                                          WaitingTaskPtr pathsDone)
+  {
+    auto const sid = pc_.scheduleID();
+    TDEBUG_BEGIN_FUNC_SI(4, sid) << "idx: " << idx
+                                 << " should_continue: " << should_continue;
+    auto& graph = *graph_;
+    if (ex) {
+      exception_ptr path_ex;
+      try {
+        rethrow_exception(ex);
+      }
+      catch (cet::exception& e) {
+        auto action = actionTable_.find(e.root_cause());
+        assert(action != actions::FailModule);
+        if (action != actions::FailPath) {
+          // Possible actions: IgnoreCompletely, Rethrow, SkipEvent
+          path_ex = make_exception_ptr(
+            Exception{
+              errors::ScheduleExecutionFailure, "Path: ProcessingStopped.", e}
+            << "Exception going through path " << name() << '\n');
+        } else {
+          mf::LogWarning(e.category()) << "Failing path " << name()
+                                       << ", due to exception, message:\n"
+                                       << e.what();
+        }
+      }
+      catch (...) {
+        mf::LogError("PassingThrough")
+          << "Exception passing through path " << name();
+        path_ex = current_exception();
+      }
+      should_continue = false;
+      if (path_ex && !graph.excepted.exchange(true)) {
+        graph.exception = path_ex;
+        graph.exceptionIdx = idx;
+      }
+    }
+
+    if (should_continue) {
+      if (!graph.excepted) {
+        for (auto const next : graph.successors[idx]) {
+          if (--graph.waitingFor[next] == 0) {
+            ++graph.running;
+            runGraphWorker_asynch(next, ep, pathsDone);
+          }
+        }
+      }
+    } else {
+      auto failed = graph.failedIdx.load();
+      while (idx + 1 < failed &&
+             !graph.failedIdx.compare_exchange_weak(failed, idx + 1)) {
+      }
+    }
+
+    if (--graph.running == 0) {
+      process_event_graphFinished(pathsDone);
+    }
+    TDEBUG_END_FUNC_SI(4, sid) << "idx: " << idx;
+  }
+
+  void
+  Path::process_event_graphFinished(WaitingTaskPtr pathsDone)
+  {
+    auto& graph = *graph_;
+    if (graph.excepted) {
+      ++timesExcept_;
+      state_ = hlt::Exception;
+      if (trptr_) {
+        // Not the end path.
+        trptr_->at(pathPosition_) = HLTPathStatus(state_, graph.exceptionIdx);
+      }
+      taskGroup_.may_run(pathsDone, graph.exception);
+      return;
+    }
+    auto const failed = graph.failedIdx.load();
+    bool const passed = failed == numeric_limits<size_t>::max();
+    process_event_pathFinished(
+      passed ? workers_.size() : failed, passed, pathsDone);
+  }
+
 } // namespace art
@@ -21,7 +21,10 @@
 #include "cetlib/exempt_ptr.h"
 #include "hep_concurrency/WaitingTask.h"
 
+#include <atomic>
 #include <cstddef>
+#include <exception>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -53,8 +56,35 @@ namespace art {
     void process(hep::concurrency::WaitingTaskPtr pathsDoneTask,
                  EventPrincipal&);
 
+    // Run the workers of this path for events as a graph instead of
+    // one after the other.  For each worker, the indices of the
+    // workers on this path that must have run, and passed, before it
+    // may start are given.
+    void runAsGraph(std::vector<std::vector<std::size_t>> const& predecessors);
+
   private:
     class WorkerDoneTask;
+    class GraphWorkerDoneTask;
+
+    // The static dependencies between the workers and the state of
+    // the event being processed when the path is run as a graph.
+    struct Graph {
+      explicit Graph(std::size_t const nworkers)
+        : successors(nworkers)
+        , numPredecessors(nworkers)
+        , waitingFor(nworkers)
+      {}
+      std::vector<std::vector<std::size_t>> successors;
+      std::vector<std::size_t> numPredecessors;
+      std::vector<std::atomic<std::size_t>> waitingFor;
+      std::atomic<std::size_t> running{};
+      // One past the index of the first worker that rejected the
+      // event, or the largest size_t if none has.
+      std::atomic<std::size_t> failedIdx{};
+      std::atomic<bool> excepted{false};
+      std::exception_ptr exception{};
+      std::size_t exceptionIdx{};
+    };
 
     void runWorkerTask(size_t idx,
                        size_t max_idx,
@@ -79,6 +109,20 @@ namespace art {
                                     bool should_continue,
                                     hep::concurrency::WaitingTaskPtr pathsDone);
 
+    void process_event_graph(EventPrincipal&,
+                             hep::concurrency::WaitingTaskPtr pathsDone);
+    void runGraphWorker_asynch(size_t idx,
+                               EventPrincipal&,
+                               hep::concurrency::WaitingTaskPtr pathsDone);
+    void process_event_graphWorkerFinished(
+      size_t idx,
+      bool should_continue,
+      std::exception_ptr ex,
+      EventPrincipal&,
+      hep::concurrency::WaitingTaskPtr pathsDone);
+    void process_event_graphFinished(
+      hep::concurrency::WaitingTaskPtr pathsDone);
+
     ActionTable const& actionTable_;
     ActivityRegistry const& actReg_;
     PathContext const pc_;
@@ -91,6 +135,9 @@ namespace art {
 
     GlobalTaskGroup& taskGroup_;
 
+    // Set only if the workers are run as a graph.
+    std::unique_ptr<Graph> graph_{nullptr};
+
     // These are adjusted in a serialized context.
     hlt::HLTState state_{hlt::Ready};
     std::size_t timesRun_{};
@@ -42,6 +42,8 @@
 #include <cassert>
 #include <map>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <regex>
 #include <set>
 #include <sstream>
@@ -66,6 +68,45 @@ namespace art {
       return wcis | views::transform(to_label) | to<std::vector>() |
              ranges::actions::sort;
     }
+
+    // A worker on a path must wait for the most recent filter before
+    // it and for the modules before it whose products it consumes.
+    // The consumed products of a module on more than one trigger path
+    // are only recorded for one of them, so such a module waits for
+    // every module before it.
+    std::vector<std::vector<std::size_t>>
+    path_predecessors(Path const& path, detail::ModuleGraphInfoMap const& infos)
+    {
+      auto const& wips = path.workersInPath();
+      std::vector<std::vector<std::size_t>> result(wips.size());
+      std::vector<std::string> labels;
+      labels.reserve(wips.size());
+      std::optional<std::size_t> last_filter;
+      for (std::size_t i = 0; i != wips.size(); ++i) {
+        auto const& label = wips[i].getWorker()->label();
+        auto const& info = infos.info(label);
+        auto& preds = result[i];
+        if (info.paths.size() > 1u) {
+          preds.resize(i);
+          std::iota(begin(preds), end(preds), 0u);
+        } else {
+          std::set<std::string> consumed_labels;
+          for (auto const& prod : info.consumed_products) {
+            consumed_labels.insert(prod.label);
+          }
+          for (std::size_t j = 0; j != i; ++j) {
+            if (j == last_filter || consumed_labels.count(labels[j])) {
+              preds.push_back(j);
+            }
+          }
+        }
+        if (info.module_type == ModuleType::filter) {
+          last_filter = i;
+        }
+        labels.push_back(label);
+      }
+      return result;
+    }
   } // anonymous namespace
 
   PathManager::PathManager(ParameterSet const& procPS,
@@ -170,7 +211,8 @@ namespace art {
   PathManager::createModulesAndWorkers(
     GlobalTaskGroup& task_group,
     detail::SharedResources& resources,
-    std::vector<std::string> const& producing_services)
+    std::vector<std::string> const& producing_services,
+    bool const run_paths_as_graphs)
   {
     // For each configured schedule, create the trigger paths and the
     // workers on each path.
@@ -262,6 +304,14 @@ namespace art {
       throw Exception{errors::Configuration} << err << '\n';
     }
 
+    if (run_paths_as_graphs) {
+      for (auto& pinfo : triggerPathsInfo_) {
+        for (auto& path : pinfo.paths()) {
+          path.runAsGraph(path_predecessors(path, modInfos));
+        }
+      }
+    }
+
     // No longer need worker/module config objects.
     protoTrigPathLabels_.clear();
     protoEndPathLabels_.clear();
@@ -66,7 +66,8 @@ namespace art {
     void createModulesAndWorkers(
       GlobalTaskGroup& task_group,
       detail::SharedResources& resources,
-      std::vector<std::string> const& producing_services);
+      std::vector<std::string> const& producing_services,
+      bool run_paths_as_graphs);
     std::unique_ptr<Worker> releaseTriggerResultsInserter(ScheduleID);
     PathsInfo& triggerPathsInfo(ScheduleID);
     PerScheduleContainer<PathsInfo> const& triggerPathsInfo();
@@ -20,6 +20,7 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <memory>
 #include <utility>
 
@@ -99,13 +100,20 @@ namespace art {
       epExec_.closeSomeOutputFiles();
     }
 
+    // The event principal must be kept alive until the
+    // eventWrittenTask is launched, at which point it can be released
+    // by calling reset_event_principal().
     void
-    writeEvent()
+    writeEvent(hep::concurrency::WaitingTaskPtr eventWrittenTask)
     {
       assert(eventPrincipal_);
-      epExec_.writeEvent(*eventPrincipal_);
-      // Delete principal
-      eventPrincipal_.reset();
+      epExec_.writeEvent(eventWrittenTask, *eventPrincipal_);
+    }
+
+    std::chrono::steady_clock::duration
+    writeWaitTime() const
+    {
+      return epExec_.writeWaitTime();
     }
 
     void
@@ -188,6 +196,12 @@ namespace art {
       return *eventPrincipal_;
     }
 
+    void
+    reset_event_principal()
+    {
+      eventPrincipal_.reset();
+    }
+
     class EndPathRunnerTask;
 
   private:
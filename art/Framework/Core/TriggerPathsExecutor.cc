@@ -10,6 +10,7 @@
 #include "art/Persistency/Provenance/ModuleDescription.h"
 #include "art/Persistency/Provenance/PathContext.h"
 #include "art/Persistency/Provenance/ScheduleContext.h"
+#include "art/Utilities/FrameworkPhases.h"
 #include "art/Utilities/GlobalTaskGroup.h"
 #include "art/Utilities/ScheduleID.h"
 #include "art/Utilities/TaskDebugMacros.h"
@@ -219,6 +220,8 @@ namespace art {
       event_principal.makeEvent(ModuleContext::invalid()), sc_);
     auto const scheduleID = sc_.id();
     TDEBUG_BEGIN_FUNC_SI(4, scheduleID);
+    FrameworkPhaseSentry const sentry{FrameworkPhase::TaskSpawning,
+                                      scheduleID};
     if (results_inserter_) {
       results_inserter_->reset();
     }
@@ -269,6 +272,8 @@ namespace art {
                              PathContext::art_path_spec(),
                              {resultsInserterDesc.moduleLabel()}};
         ModuleContext const mc{pc, resultsInserterDesc};
+        FrameworkPhaseSentry const sentry{FrameworkPhase::TriggerResults,
+                                          scheduleID};
         results_inserter_->doWork_event(principal, mc);
       }
     }
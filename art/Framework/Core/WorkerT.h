@@ -23,6 +23,8 @@ namespace art {
   private:
     hep::concurrency::SerialTaskQueueChain* doSerialTaskQueueChain()
       const override;
+    detail::SerializationStatistics* doSerializationStatistics()
+      const override;
     void doBeginJob(detail::SharedResources const&) override;
     void doEndJob() override;
     void doRespondToOpenInputFile(FileBlock const&) override;
@@ -82,6 +84,17 @@ namespace art {
     }
   }
 
+  template <typename T>
+  detail::SerializationStatistics*
+  WorkerT<T>::doSerializationStatistics() const
+  {
+    if constexpr (std::is_base_of_v<detail::SharedModule, T>) {
+      return module_->serializationStatistics();
+    } else {
+      return nullptr;
+    }
+  }
+
   template <typename T>
   void
   WorkerT<T>::doBeginJob(detail::SharedResources const& resources)
@@ -24,6 +24,12 @@ namespace art::detail {
     return chain_.get();
   }
 
+  SerializationStatistics*
+  SharedModule::serializationStatistics() const
+  {
+    return statistics_.get();
+  }
+
   std::set<std::string> const&
   SharedModule::sharedResources() const
   {
@@ -54,6 +60,8 @@ namespace art::detail {
                                          cend(resourceNames_));
     auto queues = resources.createQueues(names);
     chain_ = std::make_unique<SerialTaskQueueChain>(queues);
+    statistics_ = std::make_unique<SerializationStatistics>();
+    statistics_->resources = resources.queueStatistics(names);
   }
 
   void
@@ -22,6 +22,7 @@ namespace art::detail {
     explicit SharedModule(std::string const& moduleLabel);
 
     hep::concurrency::SerialTaskQueueChain* serialTaskQueueChain() const;
+    SerializationStatistics* serializationStatistics() const;
     std::set<std::string> const& sharedResources() const;
 
     void createQueues(SharedResources const& resources);
@@ -76,6 +77,7 @@ namespace art::detail {
     std::set<std::string> resourceNames_{};
     bool asyncDeclared_{false};
     std::unique_ptr<hep::concurrency::SerialTaskQueueChain> chain_{nullptr};
+    std::unique_ptr<SerializationStatistics> statistics_{nullptr};
   };
 
   template <BranchType, typename... T>
@@ -6,18 +6,19 @@
 #include "art/Framework/Core/InputSource.h"
 #include "art/Framework/Core/InputSourceDescription.h"
 #include "art/Framework/Core/InputSourceFactory.h"
-#include "art/Framework/Core/InputSourceMutex.h"
 #include "art/Framework/Core/ReplicatedProducer.h"
 #include "art/Framework/EventProcessor/detail/writeSummary.h"
 #include "art/Framework/Principal/ClosedRangeSetHandler.h"
 #include "art/Framework/Principal/ConsumesInfo.h"
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/EventPrincipal.h"
+#include "art/Framework/Principal/InputSourceMutex.h"
 #include "art/Framework/Principal/RangeSetHandler.h"
 #include "art/Framework/Principal/Run.h"
 #include "art/Framework/Principal/RunPrincipal.h"
 #include "art/Framework/Principal/SubRun.h"
 #include "art/Framework/Principal/SubRunPrincipal.h"
+#include "art/Framework/Principal/detail/ResolvedProducts.h"
 #include "art/Framework/Services/Optional/RandomNumberGenerator.h"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Framework/Services/Registry/ServiceRegistry.h"
@@ -27,12 +28,14 @@
 #include "art/Framework/Services/System/TriggerNamesService.h"
 #include "art/Persistency/Provenance/ProcessConfigurationRegistry.h"
 #include "art/Persistency/Provenance/ProcessHistoryRegistry.h"
+#include "art/Utilities/FrameworkPhases.h"
 #include "art/Utilities/Globals.h"
 #include "art/Utilities/ScheduleID.h"
 #include "art/Utilities/SharedResource.h"
 #include "art/Utilities/TaskDebugMacros.h"
 #include "art/Utilities/Transition.h"
 #include "art/Utilities/UnixSignalHandlers.h"
+#include "art/Utilities/detail/SpanStarts.h"
 #include "art/Version/GetReleaseVersion.h"
 #include "canvas/Persistency/Provenance/ParentageRegistry.h"
 #include "canvas/Persistency/Provenance/ProcessConfiguration.h"
@@ -46,11 +49,17 @@
 #include "hep_concurrency/WaitingTask.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <exception>
 #include <functional>
+#include <iomanip>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -79,6 +88,38 @@ namespace art {
     }
 
     auto const invalid_module_context = ModuleContext::invalid();
+
+    // Start times of the modules running on this thread.
+    thread_local detail::SpanStarts<std::chrono::steady_clock::time_point>
+      moduleStarts;
+
+    // The number of schedules beyond which more schedules are not
+    // expected to help: if s of the m modules of a schedule are
+    // serialized, and all modules take about the same time, the
+    // speed-up is limited to about m/s.
+    ScheduleID::size_type
+    estimated_schedules(PathManager& pm, ScheduleID::size_type const max)
+    {
+      std::set<std::string> modules;
+      std::set<std::string> serialized;
+      auto collect = [&modules, &serialized](PathsInfo const& pi) {
+        for (auto const& [module_label, worker] : pi.workers()) {
+          modules.insert(module_label);
+          if (worker->serialTaskQueueChain() != nullptr) {
+            serialized.insert(module_label);
+          }
+        }
+      };
+      collect(pm.triggerPathsInfo(ScheduleID::first()));
+      collect(pm.endPathInfo(ScheduleID::first()));
+      if (serialized.empty()) {
+        return max;
+      }
+      auto const limit = (modules.size() + serialized.size() - 1) /
+                         serialized.size();
+      return static_cast<ScheduleID::size_type>(
+        std::min<std::size_t>(limit, max));
+    }
   }
 
   EventProcessor::~EventProcessor() = default;
@@ -99,7 +140,37 @@ namespace art {
                    std::move(enabled_modules)}
     , handleEmptyRuns_{scheduler_->handleEmptyRuns()}
     , handleEmptySubRuns_{scheduler_->handleEmptySubRuns()}
+    , pipelineSubRuns_{scheduler_->pipelineSubRuns()}
+    , subRunReadAheadDepth_{scheduler_->subRunReadAheadDepth() != 0u ?
+                              scheduler_->subRunReadAheadDepth() :
+                              scheduler_->num_schedules()}
+    , eventPrefetchDepth_{scheduler_->eventPrefetchDepth()}
+    , takePrefetchedEvents_{eventPrefetchDepth_ != 0u || pipelineSubRuns_}
+    , reuseEventGroups_{scheduler_->reuseEventGroups()}
+    , recycledGroups_(scheduler_->num_schedules())
+    , accountFrameworkPhases_{scheduler_->frameworkOverhead()}
+    , frameworkPhaseRecords_(scheduler_->num_schedules())
+    , scalingReport_{scheduler_->scalingReport()}
+    , scheduleActivity_(scheduler_->num_schedules())
   {
+    if (scalingReport_) {
+      auto start = [](ModuleContext const& mc) {
+        moduleStarts.open(&mc.moduleDescription(),
+                          std::chrono::steady_clock::now());
+      };
+      auto stop = [this](ModuleContext const& mc) {
+        auto const start = moduleStarts.close(&mc.moduleDescription());
+        if (!start) {
+          return;
+        }
+        auto const elapsed = std::chrono::steady_clock::now() - *start;
+        scheduleActivity_[mc.scheduleID()].moduleTime += elapsed.count();
+      };
+      actReg_.sPreModule.watch(start);
+      actReg_.sPostModule.watch(stop);
+      actReg_.sPreWriteEvent.watch(start);
+      actReg_.sPostWriteEvent.watch(stop);
+    }
     auto services_pset = pset.get<ParameterSet>("services");
     auto const scheduler_pset = services_pset.get<ParameterSet>("scheduler");
     {
@@ -154,7 +225,10 @@ namespace art {
     auto const producing_services = servicesManager_->registerProducts(
       producedProductDescriptions_, psSignals_, pc);
     pathManager_->createModulesAndWorkers(
-      *taskGroup_, sharedResources_, producing_services);
+      *taskGroup_,
+      sharedResources_,
+      producing_services,
+      scheduler_->dataDependencyScheduling());
 
     ServiceHandle<TriggerNamesService> trigger_names [[maybe_unused]];
     auto const end = Globals::instance()->nschedules();
@@ -254,6 +328,13 @@ namespace art {
   bool
   EventProcessor::levelsToProcess()
   {
+    if (L == most_deeply_nested_level() && takePrefetchedEvents_ &&
+        prefetchedEventsAvailable()) {
+      // Events of this subrun were read ahead before it began.  The
+      // item type after them has already been advanced to, and is
+      // handled by the schedules once they have taken the events.
+      return true;
+    }
     if (nextLevel_.load() == Level::ReadyToAdvance) {
       nextLevel_ = advanceItemType();
       // Consider reading right here?
@@ -462,6 +543,21 @@ namespace art {
     scheduleIteration_.for_each_schedule([this](ScheduleID const sid) {
       schedule(sid).beginJob(sharedResources_);
     });
+    if (accountFrameworkPhases_) {
+      activateFrameworkPhaseAccounting(scheduler_->num_schedules());
+    }
+    if (scalingReport_) {
+      threadPoolObserver_ = std::make_unique<ThreadPoolObserver>();
+    }
+    // The serialization of the modules is known once their queues
+    // have been set up in the beginJob of the schedules.
+    if (scheduler_->autoConcurrency()) {
+      auto const nschedules = scheduler_->num_schedules();
+      concurrencyTuner_ = std::make_unique<detail::ConcurrencyTuner>(
+        nschedules,
+        estimated_schedules(pathManager_, nschedules),
+        scheduler_->tuningEvents());
+    }
     actReg_.sPostBeginJob.invoke();
     invokePostBeginJobWorkers_();
   }
@@ -472,11 +568,28 @@ namespace art {
     FDEBUG(1) << string(8, ' ') << "endJob\n";
     ec_->call([this] { endJobAllSchedules(); });
     ec_->call([] { ConsumesInfo::instance()->showMissingConsumes(); });
+    if (accountFrameworkPhases_) {
+      deactivateFrameworkPhaseAccounting();
+      ec_->call([this] { reportFrameworkPhases(); });
+    }
+    if (scalingReport_) {
+      ec_->call([this] { reportScaling(); });
+    }
+    if (concurrencyTuner_) {
+      ec_->call([this] { reportConcurrencyTuning(); });
+    }
+    if (eventPrefetchDepth_ != 0u) {
+      ec_->call([this] { reportEventPrefetching(); });
+    }
+    if (reuseEventGroups_ && scheduler_->wantSummary()) {
+      ec_->call([this] { reportGroupReuse(); });
+    }
     ec_->call([this] { input_->doEndJob(); });
     ec_->call([this] { actReg_.sPostEndJob.invoke(); });
     ec_->call([] { mf::LogStatistics(); });
     ec_->call([this] {
-      detail::writeSummary(pathManager_, scheduler_->wantSummary(), timer_);
+      detail::writeSummary(
+        pathManager_, sharedResources_, scheduler_->wantSummary(), timer_);
     });
   }
 
@@ -495,6 +608,9 @@ namespace art {
   {
     actReg_.sPreOpenFile.invoke();
     FDEBUG(1) << string(8, ' ') << "openInputFile\n";
+    // The product tables of the new file invalidate any cached
+    // product lookups.
+    detail::advance_product_tables_generation();
     fb_.reset(input_->readFile().release());
     if (fb_ == nullptr) {
       throw Exception(errors::LogicError)
@@ -596,6 +712,9 @@ namespace art {
   void
   EventProcessor::respondToOpenInputFile()
   {
+    // The product tables of the new file may reuse the addresses of
+    // the old ones.
+    consumedEventProductsTable_ = nullptr;
     scheduleIteration_.for_each_schedule([this](ScheduleID const sid) {
       schedule(sid).respondToOpenInputFile(*fb_);
     });
@@ -808,30 +927,51 @@ namespace art {
   EventProcessor::readSubRun()
   {
     actReg_.sPreSourceSubRun.invoke();
-    subRunPrincipal_.reset(input_->readSubRun(runPrincipal_.get()).release());
+    if (nextSubRunPrincipal_) {
+      // The subrun was read ahead while the previous one was being
+      // drained.  Its source signals have been held back until now so
+      // that they follow the end of the previous subrun.
+      handOverReadAheadEvents();
+    } else {
+      readNextSubRun();
+    }
+    subRunPrincipal_.reset(nextSubRunPrincipal_.release());
     assert(subRunPrincipal_);
-    auto rsh = input_->subRunRangeSetHandler();
-    assert(rsh);
-    auto seed_range_set = [this, &rsh](ScheduleID const sid) {
-      schedule(sid).seedSubRunRangeSet(*rsh);
+    {
+      auto const sr =
+        std::as_const(*subRunPrincipal_).makeSubRun(invalid_module_context);
+      actReg_.sPostSourceSubRun.invoke(sr);
+    }
+    // The range sets of the previous subrun have been written by now,
+    // so the schedules can be seeded for this one.
+    auto seed_range_set = [this](ScheduleID const sid) {
+      schedule(sid).seedSubRunRangeSet(*nextSubRunRangeSetHandler_);
     };
     scheduleIteration_.for_each_schedule(seed_range_set);
+    nextSubRunRangeSetHandler_.reset();
+    FDEBUG(1) << string(8, ' ') << "readSubRun..................("
+              << subRunPrincipal_->subRunID() << ")\n";
+  }
+
+  // Reads the next subrun into nextSubRunPrincipal_.  The source
+  // signals are emitted by readSubRun once the subrun becomes active.
+  void
+  EventProcessor::readNextSubRun()
+  {
+    assert(!nextSubRunPrincipal_);
+    nextSubRunPrincipal_ = input_->readSubRun(runPrincipal_.get());
+    assert(nextSubRunPrincipal_);
+    nextSubRunRangeSetHandler_ = input_->subRunRangeSetHandler();
+    assert(nextSubRunRangeSetHandler_);
     // The intended behavior here is that the producing services which
     // are called during the sPostReadSubRun cannot see each others
     // put products. We enforce this by creating the groups for the
     // produced products, but do not allow the lookups to find them
     // until after the callbacks have run.
-    subRunPrincipal_->createGroupsForProducedProducts(
+    nextSubRunPrincipal_->createGroupsForProducedProducts(
       producedProductLookupTables_);
-    psSignals_->sPostReadSubRun.invoke(*subRunPrincipal_);
-    subRunPrincipal_->enableLookupOfProducedProducts();
-    {
-      auto const sr =
-        std::as_const(*subRunPrincipal_).makeSubRun(invalid_module_context);
-      actReg_.sPostSourceSubRun.invoke(sr);
-    }
-    FDEBUG(1) << string(8, ' ') << "readSubRun..................("
-              << subRunPrincipal_->subRunID() << ")\n";
+    psSignals_->sPostReadSubRun.invoke(*nextSubRunPrincipal_);
+    nextSubRunPrincipal_->enableLookupOfProducedProducts();
   }
 
   void
@@ -1041,13 +1181,19 @@ namespace art {
       return;
     }
     // Note: This loop is to allow output file switching to happen in
-    // the main thread.
-    firstEvent_ = true;
+    // the main thread.  If events were read ahead for this subrun,
+    // the item type has not been consumed by levelsToProcess and
+    // every schedule must check it before reading.
+    firstEvent_ = !(takePrefetchedEvents_ && prefetchedEventsAvailable());
     bool done = false;
     while (!done) {
       beginRunIfNotDoneAlready();
       beginSubRunIfNotDoneAlready();
 
+      beginEventLoopRound();
+      if (concurrencyTuner_) {
+        concurrencyTuner_->beginRound();
+      }
       auto const last_schedule_index = scheduler_->num_schedules() - 1;
       for (ScheduleID::size_type i = 0; i != last_schedule_index; ++i) {
         taskGroup_->run([this, i] { processAllEventsAsync(ScheduleID(i)); });
@@ -1055,6 +1201,7 @@ namespace art {
       taskGroup_->native_group().run_and_wait([this, last_schedule_index] {
         processAllEventsAsync(ScheduleID(last_schedule_index));
       });
+      endEventLoopRound();
 
       // If anything bad happened during event processing, let the
       // user know.
@@ -1119,12 +1266,48 @@ namespace art {
       TDEBUG_END_FUNC_SI(4, sid) << "CLEAN SHUTDOWN";
       return;
     }
+    if (scalingReport_) {
+      scheduleActivity_[sid].lastActive = std::chrono::steady_clock::now();
+    }
+
+    if (concurrencyTuner_ && !concurrencyTuner_->mayContinue(sid)) {
+      // This schedule is not among the active ones; it is restarted
+      // if the number of active schedules is raised.
+      TDEBUG_END_FUNC_SI(4, sid) << "SCHEDULE PARKED";
+      return;
+    }
+
+    auto const waitStart = std::chrono::steady_clock::now();
+    auto recordSourceWait = [this, waitStart] {
+      sourceWaitTime_ += (std::chrono::steady_clock::now() - waitStart).count();
+    };
+    if (takePrefetchedEvents_) {
+      // A schedule that must close output files takes the slow path
+      // below so that the file switch is initiated.  Once a switch is
+      // in progress, no event may be started until the output files
+      // have been switched; the queued events are taken afterwards.
+      if (!fileSwitchInProgress_.load() && !schedule(sid).outputsToClose() &&
+          takePrefetchedEvent(sid)) {
+        ++prefetchHits_;
+        recordSourceWait();
+        prefetchEventsAsync();
+        processEventAsync(sid);
+        TDEBUG_END_FUNC_SI(4, sid) << "PREFETCHED EVENT";
+        return;
+      }
+      prefetchEventsAsync();
+    }
 
     // The item type advance and the event read must be done with the
     // input source lock held; however event-processing must not
     // serialized.
     {
+      auto const lockRequested = std::chrono::steady_clock::now();
       InputSourceMutexSentry lock_input;
+      if (scalingReport_) {
+        scheduleActivity_[sid].inputLockWait +=
+          std::chrono::steady_clock::now() - lockRequested;
+      }
       if (fileSwitchInProgress_.load()) {
         // We must avoid advancing the iterator after a schedule has
         // noticed it is time to switch files.  After the switch, we
@@ -1142,6 +1325,22 @@ namespace art {
         TDEBUG_END_FUNC_SI(4, sid) << "FILE SWITCH";
         return;
       }
+      if (takePrefetchedEvents_ && !schedule(sid).outputsToClose() &&
+          prefetchedEventsAvailable()) {
+        // The prefetching task read more events while we were waiting
+        // for the lock, or events read ahead of this subrun are left.
+        // They must be taken before this schedule may see the end of
+        // the subrun.
+        taskGroup_->run([this, sid] { processAllEventsAsync(sid); });
+        TDEBUG_END_FUNC_SI(4, sid) << "PREFETCHED EVENTS AVAILABLE";
+        return;
+      }
+      if (nextSubRunPrincipal_) {
+        // Another schedule has already crossed into the next subrun.
+        readAheadEvents(sid);
+        TDEBUG_END_FUNC_SI(4, sid) << "END OF SUBRUN";
+        return;
+      }
       // Check the next item type and exit this task if it is not an
       // event, or if the user has asynchronously requested a
       // shutdown.
@@ -1158,6 +1357,9 @@ namespace art {
         if ((nextLevel_.load() < most_deeply_nested_level()) ||
             (nextLevel_.load() == highest_level())) {
           // We are popping up, end event processing and this task.
+          // While the other schedules drain the current subrun, this
+          // one may start reading the next.
+          readAheadEvents(sid);
           TDEBUG_END_FUNC_SI(4, sid) << "END OF SUBRUN";
           return;
         }
@@ -1179,29 +1381,16 @@ namespace art {
       }
 
       // Now we can read the event from the source.
-      ScheduleContext const sc{sid};
       assert(subRunPrincipal_);
       assert(subRunPrincipal_->subRunID().isValid());
-      actReg_.sPreSourceEvent.invoke(sc);
-      TDEBUG_FUNC_SI(5, sid) << "Calling input_->readEvent(subRunPrincipal_)";
-      auto ep = input_->readEvent(subRunPrincipal_.get());
-      assert(ep);
-      // The intended behavior here is that the producing services
-      // which are called during the sPostReadEvent cannot see each
-      // others put products.  We enforce this by creating the groups
-      // for the produced products, but do not allow the lookups to
-      // find them until after the callbacks have run.
-      ep->createGroupsForProducedProducts(producedProductLookupTables_);
-      psSignals_->sPostReadEvent.invoke(*ep);
-      ep->enableLookupOfProducedProducts();
-      actReg_.sPostSourceEvent.invoke(
-        std::as_const(*ep).makeEvent(invalid_module_context), sc);
-      FDEBUG(1) << string(8, ' ') << "readEvent...................("
-                << ep->eventID() << ")\n";
-      schedule(sid).accept_principal(move(ep));
+      schedule(sid).accept_principal(readEvent(sid, subRunPrincipal_.get()));
       // Now we drop the input source lock by exiting the guarded
       // scope.
     }
+    if (eventPrefetchDepth_ != 0u) {
+      ++prefetchMisses_;
+      recordSourceWait();
+    }
     if (schedule(sid).event_principal().eventID().isFlush()) {
       // No processing to do, start next event handling task.
       processAllEventsAsync(sid);
@@ -1214,6 +1403,424 @@ namespace art {
     TDEBUG_END_FUNC_SI(4, sid);
   }
 
+  // Must be called with the input source lock held.
+  unique_ptr<EventPrincipal>
+  EventProcessor::readEvent(ScheduleID const sid, SubRunPrincipal* srp)
+  {
+    ScheduleContext const sc{sid};
+    actReg_.sPreSourceEvent.invoke(sc);
+    TDEBUG_FUNC_SI(5, sid) << "Calling input_->readEvent(subRunPrincipal_)";
+    auto ep = readEventFromSource(sid, srp, move(recycledGroups_[sid]));
+    actReg_.sPostSourceEvent.invoke(
+      std::as_const(*ep).makeEvent(invalid_module_context), sc);
+    FDEBUG(1) << string(8, ' ') << "readEvent...................("
+              << ep->eventID() << ")\n";
+    return ep;
+  }
+
+  // Must be called with the input source lock held.
+  unique_ptr<EventPrincipal>
+  EventProcessor::readEventFromSource(
+    ScheduleID const sid,
+    SubRunPrincipal* srp,
+    vector<unique_ptr<Group>>&& recycledGroups)
+  {
+    unique_ptr<EventPrincipal> ep;
+    {
+      FrameworkPhaseSentry const sentry{FrameworkPhase::PrincipalCreation,
+                                        sid};
+      ep = input_->readEvent(srp);
+      assert(ep);
+      if (ep->prefetchesProducts()) {
+        ep->prefetchProducts(consumedEventProducts(*ep));
+      }
+    }
+    // The intended behavior here is that the producing services
+    // which are called during the sPostReadEvent cannot see each
+    // others put products.  We enforce this by creating the groups
+    // for the produced products, but do not allow the lookups to
+    // find them until after the callbacks have run.
+    std::size_t reused{};
+    {
+      FrameworkPhaseSentry const sentry{FrameworkPhase::GroupCreation, sid};
+      reused = ep->createGroupsForProducedProducts(
+        producedProductLookupTables_, move(recycledGroups));
+    }
+    if (reuseEventGroups_) {
+      eventGroupsCreated_ +=
+        producedProductLookupTables_->get(InEvent).descriptions.size();
+      eventGroupsReused_ += reused;
+    }
+    psSignals_->sPostReadEvent.invoke(*ep);
+    ep->enableLookupOfProducedProducts();
+    return ep;
+  }
+
+  // The present products of the event that are consumed by any
+  // module.  They only change with the product tables of the input.
+  // Must be called with the input source lock held.
+  vector<ProductID> const&
+  EventProcessor::consumedEventProducts(EventPrincipal const& ep)
+  {
+    auto const* present = ep.presentProducts();
+    if (present != consumedEventProductsTable_) {
+      consumedEventProducts_.clear();
+      if (present != nullptr) {
+        consumedEventProducts_ =
+          ConsumesInfo::instance()->consumedProducts(InEvent, *present);
+      }
+      consumedEventProductsTable_ = present;
+    }
+    return consumedEventProducts_;
+  }
+
+  // Starts the prefetching task unless it is not configured or is
+  // already running.
+  void
+  EventProcessor::prefetchEventsAsync()
+  {
+    if (eventPrefetchDepth_ == 0u || prefetchInProgress_.exchange(true)) {
+      return;
+    }
+    taskGroup_->run([this] { prefetchEvents(); });
+  }
+
+  // The prefetching task.  It reads events of the active subrun until
+  // eventPrefetchDepth_ of them are waiting, or until the next item
+  // is not an event; the schedules handle all other transitions.
+  void
+  EventProcessor::prefetchEvents()
+  {
+    try {
+      InputSourceMutexSentry lock_input;
+      while (!shutdown_flag && !fileSwitchInProgress_.load() &&
+             !nextSubRunPrincipal_) {
+        {
+          std::lock_guard sentry{prefetchedEventsMutex_};
+          if (prefetchedEvents_.size() >= eventPrefetchDepth_) {
+            break;
+          }
+        }
+        auto expected = true;
+        if (!firstEvent_.compare_exchange_strong(expected, false)) {
+          if (nextLevel_.load() == Level::ReadyToAdvance) {
+            nextLevel_ = advanceItemType();
+          }
+          if (nextLevel_.load() != most_deeply_nested_level()) {
+            break;
+          }
+          nextLevel_ = Level::ReadyToAdvance;
+        }
+        assert(subRunPrincipal_);
+        // Events read ahead of the schedules are not charged to the
+        // framework time of any of them.
+        auto ep = readEventFromSource(ScheduleID{}, subRunPrincipal_.get());
+        FDEBUG(1) << string(8, ' ') << "readEvent...................("
+                  << ep->eventID() << ")\n";
+        if (ep->eventID().isFlush()) {
+          continue;
+        }
+        std::lock_guard sentry{prefetchedEventsMutex_};
+        prefetchedEvents_.push_back(move(ep));
+      }
+    }
+    catch (...) {
+      sharedException_.store_current();
+    }
+    prefetchInProgress_ = false;
+  }
+
+  bool
+  EventProcessor::prefetchedEventsAvailable()
+  {
+    std::lock_guard sentry{prefetchedEventsMutex_};
+    return !prefetchedEvents_.empty();
+  }
+
+  // Hands the oldest prefetched event, if any, to the schedule.  The
+  // source signals are emitted for the schedule here, so that the
+  // time reported for reading the event is the time the schedule
+  // waited for it.
+  bool
+  EventProcessor::takePrefetchedEvent(ScheduleID const sid)
+  {
+    unique_ptr<EventPrincipal> ep;
+    {
+      std::lock_guard sentry{prefetchedEventsMutex_};
+      if (prefetchedEvents_.empty()) {
+        return false;
+      }
+      ep = move(prefetchedEvents_.front());
+      prefetchedEvents_.pop_front();
+    }
+    ScheduleContext const sc{sid};
+    actReg_.sPreSourceEvent.invoke(sc);
+    actReg_.sPostSourceEvent.invoke(
+      std::as_const(*ep).makeEvent(invalid_module_context), sc);
+    schedule(sid).accept_principal(move(ep));
+    return true;
+  }
+
+  void
+  EventProcessor::reportGroupReuse() const
+  {
+    mf::LogPrint("ArtSummary")
+      << "EventGroupReport  Groups = " << eventGroupsCreated_.load()
+      << " Reused = " << eventGroupsReused_.load() << '\n';
+  }
+
+  void
+  EventProcessor::recordFrameworkPhases(ScheduleID const sid)
+  {
+    auto const times = takeFrameworkPhaseTimes(sid);
+    auto& records = frameworkPhaseRecords_[sid];
+    std::chrono::steady_clock::duration total{};
+    for (std::size_t i{}; i != num_framework_phases; ++i) {
+      records.totals[i] += times[i];
+      total += times[i];
+    }
+    records.perEvent.push_back(total.count());
+  }
+
+  void
+  EventProcessor::reportFrameworkPhases() const
+  {
+    using namespace std::chrono;
+    vector<steady_clock::rep> perEvent;
+    FrameworkPhaseTimes totals{};
+    for (auto const& records : frameworkPhaseRecords_) {
+      perEvent.insert(
+        end(perEvent), cbegin(records.perEvent), cend(records.perEvent));
+      for (std::size_t i{}; i != num_framework_phases; ++i) {
+        totals[i] += records.totals[i];
+      }
+    }
+    if (perEvent.empty()) {
+      return;
+    }
+    std::sort(begin(perEvent), end(perEvent));
+    auto const n = perEvent.size();
+    auto usec = [](auto const ticks) {
+      return duration<double, std::micro>{steady_clock::duration{ticks}}
+        .count();
+    };
+    auto quantile = [&perEvent, n](double const q) {
+      return perEvent[static_cast<std::size_t>(q * (n - 1))];
+    };
+    auto const sum =
+      std::accumulate(cbegin(perEvent), cend(perEvent), steady_clock::rep{});
+
+    using std::setw;
+    mf::LogPrint("ArtSummary")
+      << "FrameworkReport ---------- Framework time per event [usec] -------";
+    mf::LogPrint("ArtSummary")
+      << "FrameworkReport " << setw(10) << "Events" << ' ' << setw(10)
+      << "Mean" << ' ' << setw(10) << "Min" << ' ' << setw(10) << "Median"
+      << ' ' << setw(10) << "90%" << ' ' << setw(10) << "99%" << ' '
+      << setw(10) << "Max";
+    mf::LogPrint("ArtSummary")
+      << "FrameworkReport " << std::fixed << std::setprecision(1) << setw(10)
+      << n << ' ' << setw(10) << usec(sum) / n << ' ' << setw(10)
+      << usec(perEvent.front()) << ' ' << setw(10) << usec(quantile(0.5))
+      << ' ' << setw(10) << usec(quantile(0.9)) << ' ' << setw(10)
+      << usec(quantile(0.99)) << ' ' << setw(10) << usec(perEvent.back());
+    mf::LogPrint("ArtSummary") << "";
+    mf::LogPrint("ArtSummary")
+      << "FrameworkReport ---------- Framework time by phase -----------------";
+    mf::LogPrint("ArtSummary")
+      << "FrameworkReport " << setw(12) << "Total [sec]" << ' ' << setw(12)
+      << "Mean [usec]" << ' ' << "Phase";
+    for (std::size_t i{}; i != num_framework_phases; ++i) {
+      mf::LogPrint("ArtSummary")
+        << "FrameworkReport " << std::fixed << std::setprecision(6)
+        << setw(12) << duration<double>{totals[i]}.count() << ' '
+        << std::setprecision(1) << setw(12) << usec(totals[i].count()) / n
+        << ' ' << to_string(static_cast<FrameworkPhase>(i));
+    }
+  }
+
+  // Schedules that have left the event loop idle until the main
+  // thread has handled the transition that ended the round and
+  // started the next one.
+  void
+  EventProcessor::beginEventLoopRound()
+  {
+    if (!scalingReport_) {
+      return;
+    }
+    auto const now = std::chrono::steady_clock::now();
+    if (eventLoopRounds_++ == 0u) {
+      eventLoopStart_ = now;
+      return;
+    }
+    for (auto& activity : scheduleActivity_) {
+      activity.barrierIdle += now - lastRoundEnd_;
+    }
+  }
+
+  void
+  EventProcessor::endEventLoopRound()
+  {
+    if (!scalingReport_) {
+      return;
+    }
+    lastRoundEnd_ = std::chrono::steady_clock::now();
+    for (auto& activity : scheduleActivity_) {
+      if (activity.lastActive > eventLoopStart_) {
+        activity.barrierIdle += lastRoundEnd_ - activity.lastActive;
+      }
+    }
+  }
+
+  void
+  EventProcessor::reportScaling()
+  {
+    using namespace std::chrono;
+    if (eventLoopRounds_ == 0u) {
+      return;
+    }
+    auto const wall = duration<double>{lastRoundEnd_ - eventLoopStart_};
+    auto secs = [](auto const d) { return duration<double>{d}.count(); };
+    auto percent = [&wall](double const s) {
+      return wall.count() > 0. ? 100. * s / wall.count() : 0.;
+    };
+
+    using std::setw;
+    mf::LogPrint("ArtSummary")
+      << "ScalingReport ---------- Schedule activity [sec] -----------------";
+    mf::LogPrint("ArtSummary")
+      << "ScalingReport " << setw(8) << "Schedule" << ' ' << setw(10)
+      << "Modules" << ' ' << setw(10) << "Input lock" << ' ' << setw(10)
+      << "Output" << ' ' << setw(10) << "Idle" << ' ' << setw(8) << "Busy %";
+    double moduleTotal{};
+    auto const end = scheduler_->num_schedules();
+    for (ScheduleID::size_type i = 0; i != end; ++i) {
+      ScheduleID const sid{i};
+      auto const& activity = scheduleActivity_[sid];
+      auto const modules =
+        secs(steady_clock::duration{activity.moduleTime.load()});
+      moduleTotal += modules;
+      mf::LogPrint("ArtSummary")
+        << "ScalingReport " << std::fixed << std::setprecision(3) << setw(8)
+        << i << ' ' << setw(10) << modules << ' ' << setw(10)
+        << secs(activity.inputLockWait) << ' ' << setw(10)
+        << secs(activity.outputMutexWait +
+                schedule(sid).writeWaitTime())
+        << ' ' << setw(10) << secs(activity.barrierIdle) << ' '
+        << std::setprecision(1) << setw(8) << percent(modules);
+    }
+    mf::LogPrint("ArtSummary") << "";
+    mf::LogPrint("ArtSummary")
+      << "ScalingReport ---------- Thread pool -----------------------------";
+    auto const threads = scheduler_->num_threads();
+    mf::LogPrint("ArtSummary")
+      << "ScalingReport Threads configured = " << threads;
+    if (threadPoolObserver_) {
+      auto const pool = threadPoolObserver_->summary();
+      mf::LogPrint("ArtSummary")
+        << "ScalingReport Threads seen = " << pool.threads
+        << " Max concurrent = " << pool.maxConcurrent;
+      mf::LogPrint("ArtSummary")
+        << "ScalingReport Time in arena = " << std::fixed
+        << std::setprecision(3) << secs(pool.inArena) << " sec";
+    }
+    mf::LogPrint("ArtSummary")
+      << "ScalingReport Event loop = " << std::fixed << std::setprecision(3)
+      << wall.count() << " sec in " << eventLoopRounds_ << " round(s)";
+    mf::LogPrint("ArtSummary")
+      << "ScalingReport Module time = " << std::fixed << std::setprecision(3)
+      << moduleTotal << " sec ("
+      << std::setprecision(1) << percent(moduleTotal) / threads
+      << "% of threads x event loop)";
+  }
+
+  void
+  EventProcessor::reportConcurrencyTuning() const
+  {
+    mf::LogInfo log{"MTconfig"};
+    log << "Automatic concurrency: " << concurrencyTuner_->active() << " of "
+        << scheduler_->num_schedules() << " schedules were active.";
+    for (auto const& step : concurrencyTuner_->history()) {
+      log << "\n  " << step.schedules << " schedules: " << std::fixed
+          << std::setprecision(1) << step.eventsPerSecond << " events/s";
+    }
+  }
+
+  void
+  EventProcessor::reportEventPrefetching() const
+  {
+    using namespace std::chrono;
+    auto const hits = prefetchHits_.load();
+    auto const misses = prefetchMisses_.load();
+    auto const wait =
+      duration<double>{steady_clock::duration{sourceWaitTime_.load()}};
+    mf::LogInfo("EventPrefetch")
+      << "Events taken from the prefetch queue: " << hits
+      << "\nEvents read by the schedules themselves: " << misses
+      << "\nTotal time the schedules waited for events: " << wait.count()
+      << " s";
+  }
+
+  // Called by a schedule that has run out of events in the current
+  // subrun, with the input source lock held.  If the next item is a
+  // subrun of the same run, that subrun is read, and then its events
+  // until subRunReadAheadDepth_ of them are waiting, so that the
+  // schedules can start on them as soon as the subrun has begun.  The
+  // events are not processed before then, and their source signals
+  // are only emitted when a schedule takes them.
+  void
+  EventProcessor::readAheadEvents(ScheduleID const sid)
+  {
+    if (!pipelineSubRuns_ || schedule(sid).outputsToClose()) {
+      return;
+    }
+    if (!nextSubRunPrincipal_) {
+      if (nextLevel_.load() != Level::SubRun) {
+        return;
+      }
+      // The current subrun stays over for the other schedules; the
+      // position of the input source after the read-ahead is kept in
+      // levelAfterReadAhead_.
+      readNextSubRun();
+      levelAfterReadAhead_ = Level::ReadyToAdvance;
+    }
+    while (!shutdown_flag && readAheadEvents_.size() < subRunReadAheadDepth_) {
+      if (levelAfterReadAhead_.load() == Level::ReadyToAdvance) {
+        TDEBUG_FUNC_SI(5, sid) << "Calling advanceItemType()";
+        levelAfterReadAhead_ = advanceItemType();
+      }
+      if (levelAfterReadAhead_.load() != most_deeply_nested_level()) {
+        return;
+      }
+      levelAfterReadAhead_ = Level::ReadyToAdvance;
+      // Events read ahead are not charged to the framework time of
+      // the schedule that happens to read them.
+      auto ep = readEventFromSource(ScheduleID{}, nextSubRunPrincipal_.get());
+      FDEBUG(1) << string(8, ' ') << "readEvent...................("
+                << ep->eventID() << ")\n";
+      if (ep->eventID().isFlush()) {
+        continue;
+      }
+      readAheadEvents_.push_back(move(ep));
+    }
+  }
+
+  // Called by the main thread once all schedules have drained the
+  // previous subrun.  The read-ahead events are queued for the
+  // schedules as if the prefetching task had read them, and the input
+  // source is picked up where the read-ahead left it.
+  void
+  EventProcessor::handOverReadAheadEvents()
+  {
+    InputSourceMutexSentry lock_input;
+    nextLevel_ = levelAfterReadAhead_.load();
+    levelAfterReadAhead_ = Level::ReadyToAdvance;
+    std::lock_guard sentry{prefetchedEventsMutex_};
+    assert(prefetchedEvents_.empty());
+    prefetchedEvents_ = move(readAheadEvents_);
+    readAheadEvents_.clear();
+  }
+
   // ----------------------------------------------------------------------------
   class EventProcessor::EndPathRunnerTask {
   public:
@@ -1406,6 +2013,55 @@ namespace art {
     TDEBUG_END_FUNC_SI(4, sid) << "terminate event loop because of EXCEPTION";
   }
 
+  // ----------------------------------------------------------------------------
+  class EventProcessor::EventWrittenTask {
+  public:
+    EventWrittenTask(EventProcessor* evp, ScheduleID const sid)
+      : evp_{evp}, sid_{sid}
+    {}
+
+    void
+    operator()(std::exception_ptr ex) const
+    {
+      TDEBUG_BEGIN_TASK_SI(4, sid_);
+      if (ex) {
+        try {
+          rethrow_exception(ex);
+        }
+        catch (cet::exception& e) {
+          if (evp_->error_action(e) != actions::IgnoreCompletely) {
+            evp_->sharedException_.store<Exception>(
+              errors::EventProcessorFailure,
+              "EventProcessor: an exception occurred "
+              "during current event processing",
+              e);
+            TDEBUG_END_TASK_SI(4, sid_) << "EXCEPTION";
+            return;
+          }
+          mf::LogWarning(e.category())
+            << "exception being ignored for current event:\n"
+            << cet::trim_right_copy(e.what(), " \n");
+          // WARNING: We continue processing after the catch blocks!!!
+        }
+        catch (...) {
+          mf::LogError("PassingThrough")
+            << "an exception occurred during current event processing";
+          evp_->sharedException_.store_current();
+          TDEBUG_END_TASK_SI(4, sid_) << "EXCEPTION";
+          return;
+        }
+      }
+
+      evp_->eventWrittenAsync(sid_);
+
+      TDEBUG_END_TASK_SI(4, sid_);
+    }
+
+  private:
+    EventProcessor* evp_;
+    ScheduleID const sid_;
+  };
+
   void
   EventProcessor::finishEventAsync(ScheduleID const sid)
   {
@@ -1418,32 +2074,33 @@ namespace art {
     TDEBUG_BEGIN_FUNC_SI(4, sid);
     FDEBUG(1) << string(8, ' ') << "processEvent................("
               << ep.eventID() << ")\n";
+    // Flush events never make it to the end path.
+    assert(!ep.eventID().isFlush());
     try {
       // Ask the output workers if they have reached their limits, and
       // if so setup to end the job the next time around the event
       // loop.
       FDEBUG(1) << string(8, ' ') << "shouldWeStop\n";
-      static std::mutex m;
-      std::lock_guard sentry{m};
-      // Now we can write the results of processing to the outputs,
-      // and delete the event principal.
-      if (!ep.eventID().isFlush()) {
-        // Possibly open new output files.  This is safe to do because
-        // EndPathExecutor functions are called in a serialized
-        // context.
+      // Possibly open new output files.  Only the opening needs to be
+      // serialized across schedules--output files are closed only on
+      // the main thread, once all schedules have drained.
+      {
+        auto const lockRequested = std::chrono::steady_clock::now();
+        std::lock_guard sentry{openOutputFilesMutex_};
+        if (scalingReport_) {
+          scheduleActivity_[sid].outputMutexWait +=
+            std::chrono::steady_clock::now() - lockRequested;
+        }
         TDEBUG_FUNC_SI(5, sid) << "Calling openSomeOutputFiles()";
         openSomeOutputFiles();
-        TDEBUG_FUNC_SI(5, sid) << "Calling schedule(sid).writeEvent()";
-
-        auto const id = ep.eventID();
-        schedule(sid).writeEvent();
-        FDEBUG(1) << string(8, ' ') << "writeEvent..................(" << id
-                  << ")\n";
       }
-      TDEBUG_FUNC_SI(5, sid)
-        << "Calling schedules_->"
-           "recordOutputClosureRequests(Granularity::Event)";
-      schedule(sid).recordOutputClosureRequests(Granularity::Event);
+      // Now we can hand the event to the output modules.  Each output
+      // module has its own write queue; once every output module has
+      // written the event, the eventWrittenTask starts the next event
+      // processing task for this schedule.
+      TDEBUG_FUNC_SI(5, sid) << "Calling schedule(sid).writeEvent()";
+      auto eventWrittenTask = make_waiting_task<EventWrittenTask>(this, sid);
+      schedule(sid).writeEvent(eventWrittenTask);
     }
     catch (cet::exception& e) {
       if (error_action(e) != actions::IgnoreCompletely) {
@@ -1459,7 +2116,10 @@ namespace art {
       mf::LogWarning(e.category())
         << "exception being ignored for current event:\n"
         << cet::trim_right_copy(e.what(), " \n");
-      // WARNING: We continue processing after the catch blocks!!!
+      // Nothing was queued for writing--writeEvent reports its own
+      // failures through the eventWrittenTask--so the event is done
+      // with; start the next event processing task.
+      eventWrittenAsync(sid);
     }
     catch (...) {
       mf::LogError("PassingThrough")
@@ -1469,6 +2129,38 @@ namespace art {
       TDEBUG_END_FUNC_SI(4, sid) << "EXCEPTION";
       return;
     }
+    TDEBUG_END_FUNC_SI(4, sid);
+  }
+
+  // This function is executed as part of the eventWrittenTask, which is
+  // launched once all output modules have written the event.  The
+  // closure requests of the output modules have already been recorded
+  // by the write tasks.
+  void
+  EventProcessor::eventWrittenAsync(ScheduleID const sid)
+  {
+    TDEBUG_BEGIN_FUNC_SI(4, sid);
+    FDEBUG(1) << string(8, ' ') << "writeEvent..................("
+              << schedule(sid).event_principal().eventID() << ")\n";
+    if (accountFrameworkPhases_) {
+      recordFrameworkPhases(sid);
+    }
+    // Keep the groups of the produced products for the next event
+    // this schedule reads, unless it already has some.
+    if (reuseEventGroups_ && recycledGroups_[sid].empty()) {
+      recycledGroups_[sid] =
+        schedule(sid).event_principal().releaseProducedGroups();
+    }
+    // Delete the event principal.
+    schedule(sid).reset_event_principal();
+
+    if (concurrencyTuner_) {
+      auto const now = std::chrono::steady_clock::now();
+      for (auto const restarted : concurrencyTuner_->eventFinished(now)) {
+        taskGroup_->run(
+          [this, restarted] { processAllEventsAsync(restarted); });
+      }
+    }
 
     // The next event processing task is a continuation of this task.
     processAllEventsAsync(sid);
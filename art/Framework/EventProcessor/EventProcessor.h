@@ -17,6 +17,7 @@
 #include "art/Framework/Core/detail/EnabledModules.h"
 #include "art/Framework/Core/fwd.h"
 #include "art/Framework/EventProcessor/Scheduler.h"
+#include "art/Framework/EventProcessor/detail/ConcurrencyTuner.h"
 #include "art/Framework/EventProcessor/detail/ExceptionCollector.h"
 #include "art/Framework/Principal/Actions.h"
 #include "art/Framework/Principal/EventPrincipal.h"
@@ -25,18 +26,25 @@
 #include "art/Framework/Principal/fwd.h"
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Framework/Services/Registry/ServicesManager.h"
+#include "art/Utilities/FrameworkPhases.h"
 #include "art/Utilities/GlobalTaskGroup.h"
 #include "art/Utilities/PerScheduleContainer.h"
 #include "art/Utilities/ScheduleID.h"
 #include "art/Utilities/ScheduleIteration.h"
 #include "art/Utilities/SharedResource.h"
+#include "art/Utilities/ThreadPoolObserver.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
 #include "canvas/Persistency/Provenance/ProductTables.h"
 #include "cetlib/cpu_timer.h"
 #include "fhiclcpp/fwd.h"
 #include "hep_concurrency/thread_sanitize.h"
 
 #include <atomic>
+#include <chrono>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace art {
 
@@ -76,12 +84,14 @@ namespace art {
   private:
     class EndPathTask;
     class EndPathRunnerTask;
+    class EventWrittenTask;
 
     // Event-loop infrastructure
     void processAllEventsAsync(ScheduleID sid);
     void readAndProcessAsync(ScheduleID sid);
     void processEventAsync(ScheduleID sid);
     void finishEventAsync(ScheduleID sid);
+    void eventWrittenAsync(ScheduleID sid);
 
     template <Level L>
     bool levelsToProcess();
@@ -123,12 +133,32 @@ namespace art {
     void endRun();
     void writeRun();
     void readSubRun();
+    void readNextSubRun();
     void beginSubRun();
     void beginSubRunIfNotDoneAlready();
     void setSubRunAuxiliaryRangeSetID();
     void endSubRun();
     void writeSubRun();
-    void readEvent();
+    std::unique_ptr<EventPrincipal> readEvent(ScheduleID, SubRunPrincipal*);
+    std::unique_ptr<EventPrincipal> readEventFromSource(
+      ScheduleID,
+      SubRunPrincipal*,
+      std::vector<std::unique_ptr<Group>>&& recycledGroups = {});
+    std::vector<ProductID> const& consumedEventProducts(EventPrincipal const&);
+    void readAheadEvents(ScheduleID);
+    void handOverReadAheadEvents();
+    void prefetchEventsAsync();
+    void prefetchEvents();
+    bool prefetchedEventsAvailable();
+    bool takePrefetchedEvent(ScheduleID);
+    void reportEventPrefetching() const;
+    void reportGroupReuse() const;
+    void recordFrameworkPhases(ScheduleID);
+    void reportFrameworkPhases() const;
+    void beginEventLoopRound();
+    void endEventLoopRound();
+    void reportScaling();
+    void reportConcurrencyTuning() const;
     void processEvent();
     void writeEvent();
     void setOutputFileStatus(OutputFileStatus);
@@ -251,6 +281,110 @@ namespace art {
     // Are we configured to process empty subruns?
     bool const handleEmptySubRuns_;
 
+    // Are we configured to read across subrun boundaries while the
+    // current subrun is still being drained?
+    bool const pipelineSubRuns_;
+
+    // Maximum number of events of the next subrun that are read
+    // ahead.
+    std::size_t const subRunReadAheadDepth_;
+
+    // The subrun (and its range-set handler) that has been read ahead
+    // of the currently active one.  Both are handed over to the
+    // schedules by readSubRun.
+    std::unique_ptr<SubRunPrincipal> nextSubRunPrincipal_{nullptr};
+    std::unique_ptr<RangeSetHandler> nextSubRunRangeSetHandler_{nullptr};
+
+    // The events of the read-ahead subrun, in the order in which they
+    // were read.  They are only used with the input source lock held,
+    // or by the main thread once all schedules have drained.
+    std::deque<std::unique_ptr<EventPrincipal>> readAheadEvents_{};
+
+    // The item type that was found after the read-ahead events.  It
+    // is restored once the read-ahead subrun becomes active.
+    std::atomic<Level> levelAfterReadAhead_{Level::ReadyToAdvance};
+
+    // Maximum number of events read ahead of the schedules by the
+    // prefetching task; zero if there is no such task.
+    std::size_t const eventPrefetchDepth_;
+
+    // Do the schedules take events from prefetchedEvents_?  Besides
+    // the prefetching task, the subrun read-ahead hands its events
+    // over through that queue.
+    bool const takePrefetchedEvents_;
+
+    // The events read by the prefetching task, or handed over after
+    // a subrun read-ahead, in the order in which they were read.  They
+    // are only added with the input source lock held, and only for
+    // the currently active subrun.
+    std::deque<std::unique_ptr<EventPrincipal>> prefetchedEvents_{};
+    std::mutex prefetchedEventsMutex_{};
+    std::atomic<bool> prefetchInProgress_{false};
+
+    // How often the schedules found a prefetched event, how often
+    // they had to read one themselves, and how long they waited for
+    // their events in total.
+    std::atomic<std::size_t> prefetchHits_{0u};
+    std::atomic<std::size_t> prefetchMisses_{0u};
+    std::atomic<std::chrono::steady_clock::rep> sourceWaitTime_{0};
+
+    // The consumed products among the present event products of the
+    // input, and the product table they were found in.  Both are
+    // only used with the input source lock held.
+    std::vector<ProductID> consumedEventProducts_{};
+    ProductTable const* consumedEventProductsTable_{nullptr};
+
+    // Are the groups of the produced event products reused?
+    bool const reuseEventGroups_;
+
+    // The groups released by the last event each schedule has
+    // written.  A slot is only used by the tasks of its schedule.
+    PerScheduleContainer<std::vector<std::unique_ptr<Group>>>
+      recycledGroups_{};
+
+    // The number of produced-product groups created for events, and
+    // how many of them were reused.
+    std::atomic<std::size_t> eventGroupsCreated_{0u};
+    std::atomic<std::size_t> eventGroupsReused_{0u};
+
+    // Is the framework time of each event accounted by phase?
+    bool const accountFrameworkPhases_;
+
+    // The framework time of each event written by a schedule, and the
+    // time of each phase summed over those events.  A slot is only
+    // used by the tasks of its schedule.
+    struct FrameworkPhaseRecords {
+      std::vector<std::chrono::steady_clock::rep> perEvent{};
+      FrameworkPhaseTimes totals{};
+    };
+    PerScheduleContainer<FrameworkPhaseRecords> frameworkPhaseRecords_{};
+
+    // Is the scaling report printed at the end of the job?
+    bool const scalingReport_;
+
+    // How each schedule spent the event loop.  The module time is
+    // updated by concurrently running modules, everything else only
+    // by the tasks of the schedule.
+    struct ScheduleActivity {
+      std::chrono::steady_clock::duration inputLockWait{};
+      std::chrono::steady_clock::duration outputMutexWait{};
+      std::chrono::steady_clock::duration barrierIdle{};
+      std::atomic<std::chrono::steady_clock::rep> moduleTime{0};
+      std::chrono::steady_clock::time_point lastActive{};
+    };
+    PerScheduleContainer<ScheduleActivity> scheduleActivity_{};
+
+    // The event loop is run in rounds, between which the main thread
+    // handles run and subrun transitions and output-file switches.
+    std::size_t eventLoopRounds_{0u};
+    std::chrono::steady_clock::time_point eventLoopStart_{};
+    std::chrono::steady_clock::time_point lastRoundEnd_{};
+    std::unique_ptr<ThreadPoolObserver> threadPoolObserver_{nullptr};
+
+    // Chooses the number of schedules that process events if the
+    // concurrency is configured automatically.
+    std::unique_ptr<detail::ConcurrencyTuner> concurrencyTuner_{nullptr};
+
     // Used to communicate exceptions from worker threads to the main
     // thread.
     SharedException sharedException_;
@@ -264,6 +398,11 @@ namespace art {
 
     // Are we current switching output files?
     std::atomic<bool> fileSwitchInProgress_{false};
+
+    // Serializes the opening of output files by the schedules.  The
+    // event writes themselves are serialized per output module by the
+    // output workers' write queues.
+    std::mutex openOutputFilesMutex_{};
   };
 
 } // namespace art
@@ -3,11 +3,15 @@
 
 #include "art/Utilities/GlobalTaskGroup.h"
 #include "art/Utilities/Globals.h"
+#include "art/Utilities/ResourceBudget.h"
+#include "canvas/Utilities/Exception.h"
 #include "cetlib/HorizontalRule.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include "tbb/global_control.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <optional>
 #include <string>
 
 using fhicl::ParameterSet;
@@ -18,7 +22,8 @@ namespace {
   {
     char const* p = std::getenv("OMP_NUM_THREADS");
     if (p == nullptr) {
-      return specified_num_threads;
+      return specified_num_threads == 0 ? art::available_cores() :
+                                          specified_num_threads;
     }
 
     auto const max_threads = std::stoul(p);
@@ -40,6 +45,48 @@ namespace {
     return max_threads;
   }
 
+  using AutoConcurrencyConfig = art::Scheduler::Config::AutoConcurrencyConfig;
+
+  std::optional<AutoConcurrencyConfig>
+  auto_concurrency(art::Scheduler::Parameters const& ps)
+  {
+    AutoConcurrencyConfig config;
+    if (ps().autoConcurrency(config)) {
+      return config;
+    }
+    return std::nullopt;
+  }
+
+  unsigned
+  num_threads(art::Scheduler::Parameters const& ps)
+  {
+    if (auto_concurrency(ps).has_value()) {
+      return adjust_num_threads(0);
+    }
+    return adjust_num_threads(ps().num_threads());
+  }
+
+  // At most one schedule per thread, and no more than fit into the
+  // memory budget.
+  unsigned
+  num_schedules(art::Scheduler::Parameters const& ps, unsigned const nthreads)
+  {
+    auto const config = auto_concurrency(ps);
+    if (!config) {
+      return ps().num_schedules();
+    }
+    auto const per_schedule = config->memoryPerSchedule();
+    if (per_schedule == 0u) {
+      return nthreads;
+    }
+    std::size_t const mb = 1024 * 1024;
+    auto const budget = config->memoryBudget() != 0u ?
+                          config->memoryBudget() :
+                          art::available_memory() / mb;
+    return std::clamp(
+      static_cast<unsigned>(budget / per_schedule), 1u, nthreads);
+  }
+
   constexpr auto max_parallelism = tbb::global_control::max_allowed_parallelism;
   constexpr auto thread_stack_size = tbb::global_control::thread_stack_size;
 }
@@ -48,18 +95,45 @@ namespace art {
 
   Scheduler::Scheduler(Parameters const& ps)
     : actionTable_{ps().actionTable()}
-    , nThreads_{adjust_num_threads(ps().num_threads())}
-    , nSchedules_{ps().num_schedules()}
+    , autoConcurrency_{auto_concurrency(ps).has_value()}
+    , tuningEvents_{autoConcurrency_ ?
+                      auto_concurrency(ps)->tuningEvents() :
+                      0u}
+    , nThreads_{num_threads(ps)}
+    , nSchedules_{num_schedules(ps, nThreads_)}
     , stackSize_{ps().stack_size()}
+    , threadPinning_{art::thread_pinning(ps().threadPinning())}
     , handleEmptyRuns_{ps().handleEmptyRuns()}
     , handleEmptySubRuns_{ps().handleEmptySubRuns()}
+    , pipelineSubRuns_{ps().pipelineSubRuns()}
+    , subRunReadAheadDepth_{ps().subRunReadAheadDepth()}
+    , eventPrefetchDepth_{ps().eventPrefetchDepth()}
+    , reuseEventGroups_{ps().reuseEventGroups()}
+    , frameworkOverhead_{ps().frameworkOverhead()}
+    , scalingReport_{ps().scalingReport()}
     , errorOnMissingConsumes_{ps().errorOnMissingConsumes()}
     , wantSummary_{ps().wantSummary()}
     , dataDependencyGraph_{ps().dataDependencyGraph()}
+    , dataDependencyScheduling_{ps().dataDependencyScheduling()}
   {
+    // Modules of a path are ordered only by their declared 'consumes'
+    // statements, so an undeclared read could otherwise run before the
+    // module that produces the product.
+    if (dataDependencyScheduling_ && !errorOnMissingConsumes_) {
+      throw Exception{errors::Configuration}
+        << "The 'services.scheduler.dataDependencyScheduling' parameter "
+           "requires
+"
+        << "'services.scheduler.errorOnMissingConsumes' to be true.\n";
+    }
     auto& globals = *Globals::instance();
     globals.setNThreads(nThreads_);
     globals.setNSchedules(nSchedules_);
+    if (autoConcurrency_) {
+      mf::LogInfo("MTconfig")
+        << "Automatic concurrency: " << nThreads_ << " threads and up to "
+        << nSchedules_ << " schedules.";
+    }
   }
 
   std::unique_ptr<GlobalTaskGroup>
@@ -70,6 +144,10 @@ namespace art {
       return global_control::active_value(field);
     };
     auto group = std::make_unique<GlobalTaskGroup>(nThreads_, stackSize_);
+    if (threadPinning_ != ThreadPinning::none) {
+      threadPinningObserver_ =
+        std::make_unique<ThreadPinningObserver>(threadPinning_);
+    }
     mf::LogInfo("MTdiagnostics")
       << "TBB has been configured to use:\n"
       << "  - a maximum of " << value_of(max_parallelism) << " threads\n"
@@ -4,11 +4,13 @@
 #include "art/Framework/Principal/Actions.h"
 #include "art/Utilities/GlobalTaskGroup.h"
 #include "art/Utilities/ScheduleID.h"
+#include "art/Utilities/ThreadPinning.h"
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/OptionalTable.h"
 #include "fhiclcpp/types/Table.h"
 #include "fhiclcpp/types/TableFragment.h"
 
+#include <memory>
 #include <string>
 
 namespace art {
@@ -30,9 +32,42 @@ namespace art {
       //        specified in the program-options handlers.
       using Name = fhicl::Name;
       using Comment = fhicl::Comment;
-      fhicl::Atom<unsigned> num_threads{Name{"num_threads"}, 1};
+      fhicl::Atom<unsigned> num_threads{
+        Name{"num_threads"},
+        Comment{"If zero, one thread is used per core the process may use,\n"
+                "as limited by its affinity mask and the CPU quota of its\n"
+                "cgroup (and by OMP_NUM_THREADS, if set)."},
+        1};
       fhicl::Atom<ScheduleID::size_type> num_schedules{Name{"num_schedules"},
                                                        1};
+      struct AutoConcurrencyConfig {
+        fhicl::Atom<unsigned> memoryBudget{
+          Name{"memoryBudget"},
+          Comment{"The memory (in MB) the job may use.  If zero, the memory\n"
+                  "limit of the cgroup of the process, or else the physical\n"
+                  "memory, is used."},
+          0u};
+        fhicl::Atom<unsigned> memoryPerSchedule{
+          Name{"memoryPerSchedule"},
+          Comment{"The memory (in MB) each additional schedule is expected\n"
+                  "to need.  If zero, memory does not limit the number of\n"
+                  "schedules."},
+          500u};
+        fhicl::Atom<unsigned> tuningEvents{
+          Name{"tuningEvents"},
+          Comment{"The number of events during which the number of active\n"
+                  "schedules is adjusted to the measured throughput."},
+          200u};
+      };
+      fhicl::OptionalTable<AutoConcurrencyConfig> autoConcurrency{
+        Name{"autoConcurrency"},
+        Comment{"If present, 'num_threads' and 'num_schedules' are ignored.\n"
+                "One thread is used per core available to the process, and\n"
+                "as many schedules are created as fit into the memory\n"
+                "budget, up to one per thread.  How many of the schedules\n"
+                "process events is first estimated from the number of\n"
+                "modules that are serialized, and is then tuned during the\n"
+                "first events of the job."}};
       fhicl::Atom<unsigned> stack_size{
         Name{"stack_size"},
         Comment{"The stack size (in bytes) that the TBB scheduler will use for "
@@ -43,8 +78,61 @@ namespace art {
                 "10 MB, which\n"
                 "more closely approximates the stack size of the main thread."},
         10 * mb()};
+      fhicl::Atom<std::string> threadPinning{
+        Name{"threadPinning"},
+        Comment{"How the worker threads are bound to CPUs: 'none', 'cores'\n"
+                "(each thread to one CPU, using every physical core before\n"
+                "any hardware-thread sibling), or 'numa' (each thread to\n"
+                "the CPUs of one NUMA node).  The threads are spread over\n"
+                "the CPUs or nodes in turn."},
+        "none"};
       fhicl::Atom<bool> handleEmptyRuns{Name{"handleEmptyRuns"}, true};
       fhicl::Atom<bool> handleEmptySubRuns{Name{"handleEmptySubRuns"}, true};
+      fhicl::Atom<bool> pipelineSubRuns{
+        Name{"pipelineSubRuns"},
+        Comment{"If true, the schedules that have run out of events of the\n"
+                "current subrun read the next subrun of the same run, and\n"
+                "up to 'subRunReadAheadDepth' of its events, while the\n"
+                "other schedules are still processing.  The read-ahead\n"
+                "events are started as soon as the next subrun has begun.\n"
+                "The subrun transitions themselves are still executed in\n"
+                "order: endSubRun for a subrun is called after all of its\n"
+                "events have been processed, and before beginSubRun for\n"
+                "the next one."},
+        false};
+      fhicl::Atom<unsigned> subRunReadAheadDepth{
+        Name{"subRunReadAheadDepth"},
+        Comment{"The maximum number of events of the next subrun that are\n"
+                "read ahead if 'pipelineSubRuns' is true.  If zero, one\n"
+                "event per schedule is read."},
+        0u};
+      fhicl::Atom<unsigned> eventPrefetchDepth{
+        Name{"eventPrefetchDepth"},
+        Comment{"The number of events that are read from the input source\n"
+                "ahead of the schedules.  If zero, each schedule reads its\n"
+                "own events while holding the input-source lock."},
+        0u};
+      fhicl::Atom<bool> reuseEventGroups{
+        Name{"reuseEventGroups"},
+        Comment{"If true, the groups that hold the products produced for\n"
+                "an event are kept by the schedule after the event has\n"
+                "been written, and reused for the next event it reads."},
+        false};
+      fhicl::Atom<bool> frameworkOverhead{
+        Name{"frameworkOverhead"},
+        Comment{"If true, the time the framework spends on each event\n"
+                "outside of module code is accounted by phase (e.g.\n"
+                "principal creation, product lookup, event writing), and\n"
+                "its distribution is summarized at the end of the job."},
+        false};
+      fhicl::Atom<bool> scalingReport{
+        Name{"scalingReport"},
+        Comment{"If true, a report is printed at the end of the job of how\n"
+                "each schedule spent the event loop (executing modules,\n"
+                "waiting for the input source lock or for the outputs, or\n"
+                "idle at run and subrun boundaries), and of how busy the\n"
+                "threads of the task pool were."},
+        false};
       fhicl::Atom<bool> errorOnMissingConsumes{Name{"errorOnMissingConsumes"},
                                                false};
       fhicl::Atom<bool> errorOnSIGINT{Name{"errorOnSIGINT"}, true};
@@ -53,6 +141,15 @@ namespace art {
       fhicl::Atom<bool> reportUnused{Name{"reportUnused"}, true};
       fhicl::Atom<std::string> dataDependencyGraph{Name{"dataDependencyGraph"},
                                                    {}};
+      fhicl::Atom<bool> dataDependencyScheduling{
+        Name{"dataDependencyScheduling"},
+        Comment{"If true, each module of a trigger path is started as soon\n"
+                "as the modules whose products it consumes, and the\n"
+                "preceding filter on the path, have run.  Independent\n"
+                "modules on the same path then run concurrently.  This\n"
+                "relies on complete 'consumes' declarations, and so\n"
+                "requires 'errorOnMissingConsumes' to be true."},
+        false};
       struct DebugConfig {
         fhicl::Atom<std::string> fileName{Name{"fileName"}};
         fhicl::Atom<std::string> option{Name{"option"}};
@@ -86,6 +183,16 @@ namespace art {
       return nSchedules_;
     }
     bool
+    autoConcurrency() const noexcept
+    {
+      return autoConcurrency_;
+    }
+    unsigned
+    tuningEvents() const noexcept
+    {
+      return tuningEvents_;
+    }
+    bool
     handleEmptyRuns() const noexcept
     {
       return handleEmptyRuns_;
@@ -96,6 +203,36 @@ namespace art {
       return handleEmptySubRuns_;
     }
     bool
+    pipelineSubRuns() const noexcept
+    {
+      return pipelineSubRuns_;
+    }
+    unsigned
+    subRunReadAheadDepth() const noexcept
+    {
+      return subRunReadAheadDepth_;
+    }
+    unsigned
+    eventPrefetchDepth() const noexcept
+    {
+      return eventPrefetchDepth_;
+    }
+    bool
+    reuseEventGroups() const noexcept
+    {
+      return reuseEventGroups_;
+    }
+    bool
+    frameworkOverhead() const noexcept
+    {
+      return frameworkOverhead_;
+    }
+    bool
+    scalingReport() const noexcept
+    {
+      return scalingReport_;
+    }
+    bool
     errorOnMissingConsumes() const noexcept
     {
       return errorOnMissingConsumes_;
@@ -110,6 +247,11 @@ namespace art {
     {
       return dataDependencyGraph_;
     }
+    bool
+    dataDependencyScheduling() const noexcept
+    {
+      return dataDependencyScheduling_;
+    }
 
     std::unique_ptr<GlobalTaskGroup> global_task_group();
 
@@ -117,14 +259,25 @@ namespace art {
     // A table of responses to be taken on reception of thrown
     // exceptions.
     ActionTable actionTable_;
+    bool const autoConcurrency_;
+    unsigned const tuningEvents_;
     unsigned const nThreads_;
     unsigned const nSchedules_;
     unsigned const stackSize_;
+    ThreadPinning const threadPinning_;
+    std::unique_ptr<ThreadPinningObserver> threadPinningObserver_{nullptr};
     bool const handleEmptyRuns_;
     bool const handleEmptySubRuns_;
+    bool const pipelineSubRuns_;
+    unsigned const subRunReadAheadDepth_;
+    unsigned const eventPrefetchDepth_;
+    bool const reuseEventGroups_;
+    bool const frameworkOverhead_;
+    bool const scalingReport_;
     bool const errorOnMissingConsumes_;
     bool const wantSummary_;
     std::string const dataDependencyGraph_;
+    bool const dataDependencyScheduling_;
   };
 }
 
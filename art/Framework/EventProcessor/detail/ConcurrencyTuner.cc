@@ -0,0 +1,157 @@
+#include "art/Framework/EventProcessor/detail/ConcurrencyTuner.h"
+// vim: set sw=2 expandtab :
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+  // A different number of schedules must improve the throughput by
+  // more than this fraction to be preferred; smaller differences are
+  // within the fluctuations of the measurement.
+  constexpr double tolerance{0.05};
+
+  // The tuning is done in windows of this fraction of the tuning
+  // events, each measuring one number of active schedules.
+  constexpr std::size_t windows_per_tuning{8};
+}
+
+namespace art::detail {
+
+  ConcurrencyTuner::ConcurrencyTuner(size_type const max_schedules,
+                                     size_type const initial_schedules,
+                                     std::size_t const tuning_events)
+    : maxSchedules_{max_schedules}
+    , tuningEvents_{tuning_events}
+    , windowEvents_{std::max(tuning_events / windows_per_tuning,
+                             std::size_t{1})}
+    , active_{std::clamp(initial_schedules, size_type{1}, max_schedules)}
+    , tuning_{tuning_events != 0u && max_schedules > 1}
+    , parked_(max_schedules)
+    , best_{active_.load()}
+    , direction_{best_ == maxSchedules_ ? -1 : 1}
+    , reversed_{best_ == maxSchedules_}
+  {
+    assert(max_schedules > 0);
+  }
+
+  ConcurrencyTuner::size_type
+  ConcurrencyTuner::active() const noexcept
+  {
+    return active_.load();
+  }
+
+  bool
+  ConcurrencyTuner::tuning() const noexcept
+  {
+    return tuning_.load();
+  }
+
+  void
+  ConcurrencyTuner::beginRound()
+  {
+    std::lock_guard sentry{mutex_};
+    std::fill(begin(parked_), end(parked_), false);
+    // The time between rounds is not part of the measurement.
+    eventsInWindow_ = 0u;
+  }
+
+  bool
+  ConcurrencyTuner::mayContinue(ScheduleID const sid)
+  {
+    if (!tuning_.load()) {
+      // The number of active schedules no longer changes.
+      return sid.id() < active_.load();
+    }
+    std::lock_guard sentry{mutex_};
+    if (sid.id() < active_.load()) {
+      return true;
+    }
+    parked_[sid.id()] = true;
+    return false;
+  }
+
+  std::vector<ScheduleID>
+  ConcurrencyTuner::eventFinished(clock_type::time_point const now)
+  {
+    if (!tuning_.load()) {
+      return {};
+    }
+    std::lock_guard sentry{mutex_};
+    if (!tuning_.load()) {
+      return {};
+    }
+    if (++events_ >= tuningEvents_) {
+      return finish_();
+    }
+    // The window starts with the first event that finished after the
+    // number of active schedules was changed.
+    if (eventsInWindow_++ == 0u) {
+      windowStart_ = now;
+      return {};
+    }
+    if (eventsInWindow_ <= windowEvents_) {
+      return {};
+    }
+    std::chrono::duration<double> const elapsed{now - windowStart_};
+    return windowFinished_(elapsed.count() > 0. ?
+                             windowEvents_ / elapsed.count() :
+                             0.);
+  }
+
+  std::vector<ConcurrencyTuner::Step>
+  ConcurrencyTuner::history() const
+  {
+    std::lock_guard sentry{mutex_};
+    return history_;
+  }
+
+  // Climbs in the direction of higher throughput, one schedule at a
+  // time.  If the first step away from the initial estimate (upward
+  // unless all schedules were active) does not pay, the other
+  // direction is tried once.
+  std::vector<ScheduleID>
+  ConcurrencyTuner::windowFinished_(double const events_per_second)
+  {
+    auto const n = active_.load();
+    history_.push_back({n, events_per_second});
+    if (history_.size() == 1u ||
+        events_per_second > bestRate_ * (1. + tolerance)) {
+      best_ = n;
+      bestRate_ = events_per_second;
+    } else if (!reversed_ && history_.size() == 2u) {
+      direction_ = -direction_;
+      reversed_ = true;
+    } else {
+      return finish_();
+    }
+    auto const next = static_cast<int>(best_) + direction_;
+    if (next < 1 || next > static_cast<int>(maxSchedules_)) {
+      return finish_();
+    }
+    return setActive_(static_cast<size_type>(next));
+  }
+
+  std::vector<ScheduleID>
+  ConcurrencyTuner::setActive_(size_type const n)
+  {
+    active_ = n;
+    eventsInWindow_ = 0u;
+    std::vector<ScheduleID> restarted;
+    for (size_type i = 0; i != n; ++i) {
+      if (parked_[i]) {
+        parked_[i] = false;
+        restarted.emplace_back(i);
+      }
+    }
+    return restarted;
+  }
+
+  std::vector<ScheduleID>
+  ConcurrencyTuner::finish_()
+  {
+    auto restarted = setActive_(best_);
+    tuning_ = false;
+    return restarted;
+  }
+
+} // namespace art::detail
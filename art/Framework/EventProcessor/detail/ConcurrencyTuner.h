@@ -0,0 +1,86 @@
+#ifndef art_Framework_EventProcessor_detail_ConcurrencyTuner_h
+#define art_Framework_EventProcessor_detail_ConcurrencyTuner_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// ConcurrencyTuner
+//
+// Chooses how many of the configured schedules process events.  The
+// job starts with an estimate of the best number of schedules; during
+// the first events, the measured event throughput is compared for
+// neighboring numbers of active schedules, and the best one is kept
+// for the rest of the job.
+//
+// A schedule asks mayContinue before reading its next event; if it
+// is not among the active schedules, it stops and is parked.  When
+// the number of active schedules is raised, eventFinished returns the
+// parked schedules that must be restarted.
+// ======================================================================
+
+#include "art/Utilities/ScheduleID.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace art::detail {
+
+  class ConcurrencyTuner {
+  public:
+    using clock_type = std::chrono::steady_clock;
+    using size_type = ScheduleID::size_type;
+
+    struct Step {
+      size_type schedules;
+      double eventsPerSecond;
+    };
+
+    ConcurrencyTuner(size_type max_schedules,
+                     size_type initial_schedules,
+                     std::size_t tuning_events);
+
+    size_type active() const noexcept;
+    bool tuning() const noexcept;
+
+    // Called by the main thread before the schedules are started for
+    // a new round of the event loop.
+    void beginRound();
+
+    bool mayContinue(ScheduleID);
+    std::vector<ScheduleID> eventFinished(clock_type::time_point);
+
+    std::vector<Step> history() const;
+
+  private:
+    std::vector<ScheduleID> windowFinished_(double events_per_second);
+    std::vector<ScheduleID> setActive_(size_type);
+    std::vector<ScheduleID> finish_();
+
+    size_type const maxSchedules_;
+    std::size_t const tuningEvents_;
+    std::size_t const windowEvents_;
+    std::atomic<size_type> active_;
+    std::atomic<bool> tuning_;
+
+    // Protected by the mutex.
+    mutable std::mutex mutex_{};
+    std::vector<bool> parked_;
+    std::size_t events_{};
+    std::size_t eventsInWindow_{};
+    clock_type::time_point windowStart_{};
+    size_type best_;
+    double bestRate_{};
+    int direction_;
+    bool reversed_;
+    std::vector<Step> history_{};
+  };
+
+} // namespace art::detail
+
+#endif /* art_Framework_EventProcessor_detail_ConcurrencyTuner_h */
+
+// Local Variables:
+// mode: c++
+// End:
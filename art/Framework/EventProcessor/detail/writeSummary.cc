@@ -6,10 +6,16 @@
 #include "art/Framework/EventProcessor/detail/memoryReport.h"
 #include "art/Framework/Principal/Worker.h"
 #include "art/Utilities/PerScheduleContainer.h"
+#include "art/Utilities/SharedResource.h"
 #include "cetlib/cpu_timer.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
+#include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 using mf::LogPrint;
@@ -72,6 +78,27 @@ namespace {
     }
   }
 
+  double
+  seconds(art::detail::SerialQueueStatistics::duration const d)
+  {
+    return std::chrono::duration<double>{d}.count();
+  }
+
+  void
+  serializationLine(std::string const& name,
+                    art::detail::SerialQueueStatistics const& stats)
+  {
+    auto const tasks = stats.tasks();
+    LogPrint("ArtSummary")
+      << "TimeReport " << std::right << setw(10) << tasks << " " << std::right
+      << setw(10) << stats.maxDepth() << " " << std::right << setw(12)
+      << setprecision(6) << fixed << seconds(stats.waitTime()) << " "
+      << std::right << setw(12) << seconds(stats.runTime()) << " "
+      << std::right << setw(12)
+      << (tasks == 0 ? 0. : 1000. * seconds(stats.waitTime()) / tasks) << " "
+      << name;
+  }
+
   void
   workersInEndPathTriggerReport(WorkersInPathCounts const& workersInPathCounts)
   {
@@ -87,6 +114,7 @@ namespace {
 
 void
 art::detail::writeSummary(PathManager& pm,
+                          SharedResources const& resources,
                           bool const wantSummary,
                           cet::cpu_timer const& jobTimer)
 {
@@ -96,6 +124,9 @@ art::detail::writeSummary(PathManager& pm,
   triggerReport(epis, tpis, wantSummary);
   LogPrint("ArtSummary") << "";
   timeReport(jobTimer);
+  if (wantSummary) {
+    serializationReport(pm, resources);
+  }
   LogPrint("ArtSummary") << "";
   memoryReport();
 }
@@ -303,3 +334,54 @@ art::detail::timeReport(cet::cpu_timer const& timer)
                          << "CPU = " << timer.cpuTime()
                          << " Real = " << timer.realTime();
 }
+
+void
+art::detail::serializationReport(PathManager& pm,
+                                 SharedResources const& resources)
+{
+  // A shared module has one worker per schedule, all of which refer
+  // to the statistics of the module.
+  std::map<std::string, SerializationStatistics const*> per_module;
+  auto collect = [&per_module](auto const& pathInfos) {
+    for (auto const& pi : pathInfos) {
+      for (auto const& [module_label, worker] : pi.workers()) {
+        if (auto const stats = worker->serializationStatistics()) {
+          per_module.try_emplace(module_label, stats);
+        }
+      }
+    }
+  };
+  collect(pm.triggerPathsInfo());
+  collect(pm.endPathInfo());
+  if (per_module.empty()) {
+    return;
+  }
+
+  // Most expensive first.
+  std::vector<std::pair<std::string, SerialQueueStatistics const*>> rows;
+  for (auto const& [name, stats] : resources.resourceStatistics()) {
+    if (stats->tasks() != 0) {
+      rows.emplace_back("resource " + name, stats.get());
+    }
+  }
+  for (auto const& [module_label, stats] : per_module) {
+    rows.emplace_back("module " + module_label, &stats->module);
+  }
+  std::stable_sort(rows.begin(), rows.end(), [](auto const& a, auto const& b) {
+    return a.second->waitTime() > b.second->waitTime();
+  });
+
+  LogPrint("ArtSummary") << "";
+  LogPrint("ArtSummary") << "TimeReport "
+                         << "---------- Serialization summary [sec] -------";
+  LogPrint("ArtSummary") << "TimeReport " << std::right << setw(10) << "Tasks"
+                         << " " << std::right << setw(10) << "Max depth"
+                         << " " << std::right << setw(12) << "Wait"
+                         << " " << std::right << setw(12) << "Run"
+                         << " " << std::right << setw(12) << "Wait/task[ms]"
+                         << " "
+                         << "Name";
+  for (auto const& [name, stats] : rows) {
+    serializationLine(name, *stats);
+  }
+}
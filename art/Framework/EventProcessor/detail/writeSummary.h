@@ -15,13 +15,18 @@ namespace art {
 
   namespace detail {
 
+    class SharedResources;
+
     void writeSummary(PathManager& pm,
+                      SharedResources const& resources,
                       bool wantSummary,
                       cet::cpu_timer const& timer);
     void triggerReport(PerScheduleContainer<PathsInfo> const& endPathInfo,
                        PerScheduleContainer<PathsInfo> const& triggerPathsInfo,
                        bool wantSummary);
     void timeReport(cet::cpu_timer const& timer);
+    void serializationReport(PathManager& pm,
+                             SharedResources const& resources);
 
   } // namespace detail
 
@@ -6,6 +6,7 @@
 #include "cetlib/container_algorithms.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include "range/v3/view.hpp"
+#include "tbb/parallel_for.h"
 
 #include <algorithm>
 #include <cassert>
@@ -73,6 +74,91 @@ namespace {
     art::EventIDIndex const& index_;
   };
 
+  art::EntryNumberSequence
+  random_entries(CLHEP::RandFlat& dist,
+                 std::size_t const nSecondaries,
+                 std::size_t const nEvents)
+  {
+    art::EntryNumberSequence result;
+    std::generate_n(std::back_inserter(result), nSecondaries, [&dist, nEvents] {
+      return dist.fireInt(nEvents);
+    });
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  art::EntryNumberSequence
+  unique_random_entries(CLHEP::RandFlat& dist,
+                        std::size_t const nSecondaries,
+                        std::size_t const nEvents)
+  {
+    std::unordered_set<art::EntryNumberSequence::value_type>
+      entries; // Guaranteed unique.
+    while (entries.size() < nSecondaries) {
+      std::generate_n(std::inserter(entries, entries.begin()),
+                      nSecondaries - entries.size(),
+                      [&dist, nEvents] { return dist.fireInt(nEvents); });
+    }
+    art::EntryNumberSequence result(cbegin(entries), cend(entries));
+    std::sort(begin(result), end(result));
+    // Since we need to sort at the end anyway, it's unclear whether
+    // unordered_set is faster than set even though inserts are
+    // approximately linear time. Since the complexity of the sort is
+    // NlogN, we'd need a profile run for it all to come out in the
+    // wash.
+    assert(result.size() == nSecondaries); // Should be true by construction.
+    return result;
+  }
+
+  art::EntryNumberSequence
+  shuffled_entries(std::size_t const nEvents)
+  {
+    art::EntryNumberSequence result(nEvents);
+    std::iota(result.begin(), result.end(), 0);
+    std::random_device rd;
+    std::mt19937 g{rd()};
+    std::shuffle(result.begin(), result.end(), g);
+    return result;
+  }
+
+  // The replicas of a mixing module on schedules other than the first
+  // offset the seed by the schedule number, so that they do not choose
+  // the same secondaries.
+  using seed_t = art::RandomNumberGenerator::seed_t;
+
+  seed_t
+  schedule_seed(seed_t const seed, art::ScheduleID const sid)
+  {
+    if (sid == art::ScheduleID::first()) {
+      return seed;
+    }
+    auto const offset = static_cast<seed_t>(sid.id());
+    return seed == art::RandomNumberGenerator::useDefaultSeed ? offset :
+                                                                seed + offset;
+  }
+
+  unsigned
+  initLookAhead(unsigned const nEvents,
+                art::MixHelper::Mode const readMode,
+                std::size_t const poolSize)
+  {
+    if (nEvents == 0) {
+      return 0;
+    }
+    if (poolSize != 0) {
+      mf::LogWarning("Configuration")
+        << "lookAhead is ignored since a secondary-event pool is used.";
+      return 0;
+    }
+    if (readMode != art::MixHelper::Mode::SEQUENTIAL &&
+        readMode != art::MixHelper::Mode::RANDOM_NO_REPLACE) {
+      mf::LogWarning("Configuration")
+        << "lookAhead is ignored for a read mode of " << readMode << '.';
+      return 0;
+    }
+    return nEvents;
+  }
+
   double
   initCoverageFraction(double fraction)
   {
@@ -89,41 +175,67 @@ namespace {
 art::MixHelper::MixHelper(fhicl::ParameterSet const& pset,
                           std::string const& moduleLabel,
                           ProducesCollector& collector,
-                          std::unique_ptr<MixIOPolicy> ioHandle)
-  : EngineCreator{moduleLabel, ScheduleID::first()}
+                          std::unique_ptr<MixIOPolicy> ioHandle,
+                          ScheduleID const sid)
+  : EngineCreator{moduleLabel, sid}
   , collector_{collector}
   , moduleLabel_{moduleLabel}
   , filenames_{pset.get<std::vector<std::string>>("fileNames", {})}
   , compactMissingProducts_{pset.get<bool>("compactMissingProducts", false)}
   , fileIter_{filenames_.begin()}
+  , scheduleID_{sid}
   , readMode_{initReadMode_(pset.get<std::string>("readMode", "sequential"))}
   , coverageFraction_{initCoverageFraction(
       pset.get<double>("coverageFraction", 1.0))}
   , canWrapFiles_{pset.get<bool>("wrapFiles", false)}
-  , engine_{initEngine_(pset.get<long>("seed", -1), readMode_)}
+  , engine_{initEngine_(pset.get<long>("seed", -1), readMode_, sid)}
   , dist_{initDist_(engine_)}
+  , poolSize_{pset.get<std::size_t>("poolSize", 0)}
+  , sharedPool_{poolSize_ != 0 ? sharedSecondaryEventPool(moduleLabel) :
+                                 nullptr}
+  , lookAheadEvents_{initLookAhead(pset.get<unsigned>("lookAhead", 0),
+                                   readMode_,
+                                   poolSize_)}
+  , concurrentMixOps_{pset.get<bool>("concurrentMixOps", false)}
   , ioHandle_{move(ioHandle)}
 {}
 
 art::MixHelper::MixHelper(Config const& config,
                           std::string const& moduleLabel,
                           ProducesCollector& collector,
-                          std::unique_ptr<MixIOPolicy> ioHandle)
-  : EngineCreator{moduleLabel, ScheduleID::first()}
+                          std::unique_ptr<MixIOPolicy> ioHandle,
+                          ScheduleID const sid)
+  : EngineCreator{moduleLabel, sid}
   , collector_{collector}
   , moduleLabel_{moduleLabel}
   , filenames_{config.filenames()}
   , compactMissingProducts_{config.compactMissingProducts()}
   , fileIter_{filenames_.begin()}
+  , scheduleID_{sid}
   , readMode_{initReadMode_(config.readMode())}
   , coverageFraction_{initCoverageFraction(config.coverageFraction())}
   , canWrapFiles_{config.wrapFiles()}
-  , engine_{initEngine_(config.seed(), readMode_)}
+  , engine_{initEngine_(config.seed(), readMode_, sid)}
   , dist_{initDist_(engine_)}
+  , poolSize_{config.poolSize()}
+  , sharedPool_{poolSize_ != 0 ? sharedSecondaryEventPool(moduleLabel) :
+                                 nullptr}
+  , lookAheadEvents_{
+      initLookAhead(config.lookAhead(), readMode_, poolSize_)}
+  , concurrentMixOps_{config.concurrentMixOps()}
   , ioHandle_{move(ioHandle)}
 {}
 
-art::MixHelper::~MixHelper() = default;
+art::MixHelper::~MixHelper()
+{
+  // Reading ahead must finish before the I/O handle goes away; any
+  // error it met no longer matters.
+  try {
+    lookAheadTasks_.wait();
+  }
+  catch (...) {
+  }
+}
 
 std::ostream&
 art::operator<<(std::ostream& os, MixHelper::Mode const mode)
@@ -196,6 +308,10 @@ art::MixHelper::generateEventSequence(size_t const nSecondaries,
 {
   assert(enSeq.empty());
   assert(eIDseq.empty());
+  if (poolSize_ != 0) {
+    return generatePoolSequence_(nSecondaries, enSeq, eIDseq);
+  }
+  waitForLookAhead_();
   if (not ioHandle_->fileOpen() and not openNextFile_()) {
     return false;
   }
@@ -237,30 +353,11 @@ art::MixHelper::generateEventSequence(size_t const nSecondaries,
     std::iota(begin(enSeq), end(enSeq), nEventsReadThisFile_);
     break;
   case Mode::RANDOM_REPLACE:
-    std::generate_n(
-      std::back_inserter(enSeq), nSecondaries, [this, nEventsInFile] {
-        return dist_.get()->fireInt(nEventsInFile);
-      });
-    std::sort(enSeq.begin(), enSeq.end());
+    enSeq = random_entries(*dist_, nSecondaries, nEventsInFile);
+    break;
+  case Mode::RANDOM_LIM_REPLACE:
+    enSeq = unique_random_entries(*dist_, nSecondaries, nEventsInFile);
     break;
-  case Mode::RANDOM_LIM_REPLACE: {
-    std::unordered_set<EntryNumberSequence::value_type>
-      entries; // Guaranteed unique.
-    while (entries.size() < nSecondaries) {
-      std::generate_n(
-        std::inserter(entries, entries.begin()),
-        nSecondaries - entries.size(),
-        [this, nEventsInFile] { return dist_.get()->fireInt(nEventsInFile); });
-    }
-    enSeq.assign(cbegin(entries), cend(entries));
-    std::sort(begin(enSeq), end(enSeq));
-    // Since we need to sort at the end anyway, it's unclear whether
-    // unordered_set is faster than set even though inserts are
-    // approximately linear time. Since the complexity of the sort is
-    // NlogN, we'd need a profile run for it all to come out in the
-    // wash.
-    assert(enSeq.size() == nSecondaries); // Should be true by construction.
-  } break;
   case Mode::RANDOM_NO_REPLACE: {
     auto i = shuffledSequence_.cbegin() + nEventsReadThisFile_;
     enSeq.assign(i, i + nSecondaries);
@@ -275,9 +372,67 @@ art::MixHelper::generateEventSequence(size_t const nSecondaries,
   return true;
 }
 
+bool
+art::MixHelper::generatePoolSequence_(std::size_t const nSecondaries,
+                                      EntryNumberSequence& enSeq,
+                                      EventIDSequence& eIDseq)
+{
+  if (!pool_ && !fillPool_()) {
+    return false;
+  }
+
+  auto const nEventsInPool = pool_->size();
+  if (nSecondaries > nEventsInPool) {
+    throw Exception{errors::Configuration,
+                    "An error occurred while preparing product-mixing for "
+                    "the current event.\n"}
+      << "The number of requested secondaries (" << nSecondaries
+      << ") exceeds the number of events (" << nEventsInPool
+      << ") in the\nsecondary-event pool.  Please increase the poolSize "
+         "parameter or provide more\nsecondary events.\n";
+  }
+
+  switch (readMode_) {
+  case Mode::SEQUENTIAL:
+    for (std::size_t i{}; i != nSecondaries; ++i) {
+      enSeq.push_back((poolCursor_ + i) % nEventsInPool);
+    }
+    poolCursor_ = (poolCursor_ + nSecondaries) % nEventsInPool;
+    break;
+  case Mode::RANDOM_REPLACE:
+    enSeq = random_entries(*dist_, nSecondaries, nEventsInPool);
+    break;
+  case Mode::RANDOM_LIM_REPLACE:
+    enSeq = unique_random_entries(*dist_, nSecondaries, nEventsInPool);
+    break;
+  case Mode::RANDOM_NO_REPLACE: {
+    if (poolCursor_ + nSecondaries > shuffledSequence_.size()) {
+      // Every pooled event has been used once: start a new pass.
+      shuffledSequence_ = shuffled_entries(nEventsInPool);
+      poolCursor_ = 0;
+    }
+    auto i = shuffledSequence_.cbegin() + poolCursor_;
+    enSeq.assign(i, i + nSecondaries);
+    poolCursor_ += nSecondaries;
+  } break;
+  default:
+    throw Exception(errors::LogicError)
+      << "Unrecognized read mode " << static_cast<int>(readMode_)
+      << ". Contact the art developers.\n";
+  }
+  eIDseq = pool_->eventIDs(enSeq);
+  return true;
+}
+
 art::EventAuxiliarySequence
 art::MixHelper::generateEventAuxiliarySequence(EntryNumberSequence const& enSeq)
 {
+  if (pool_) {
+    return pool_->auxiliaries(enSeq);
+  }
+  if (lookAheadCovers_(enSeq.size())) {
+    return lookAhead_->auxiliaries(lookAheadIndices_(enSeq.size()));
+  }
   return ioHandle_->generateEventAuxiliarySequence(enSeq);
 }
 
@@ -290,60 +445,108 @@ art::MixHelper::mixAndPut(EntryNumberSequence const& eventEntries,
                           EventIDSequence const& eIDseq,
                           Event& e)
 {
+  // Populate the remapper in case we need to remap any Ptrs.
+  ptrRemapper_ = ptpBuilder_.getRemapper(e);
+
+  // Do the branch-wise read, mix and put.
+  auto const products = readProducts_(eventEntries, eIDseq);
+  auto mixAndPutOne = [this, &e, &products](std::size_t const i) {
+    auto const& op = mixOps_[i];
+    // Ptrs not supported for subrun or run product mixing.
+    op->mixAndPut(
+      e, products[i], op->branchType() == InEvent ? ptrRemapper_ : nopRemapper);
+  };
+  if (concurrentMixOps_) {
+    tbb::parallel_for(std::size_t{}, mixOps_.size(), mixAndPutOne);
+  } else {
+    for (std::size_t i{}; i != mixOps_.size(); ++i) {
+      mixAndPutOne(i);
+    }
+  }
+
+  if (!pool_) {
+    nEventsReadThisFile_ += eventEntries.size();
+    startLookAhead_(eventEntries.size());
+  }
+  totalEventsRead_ += eventEntries.size();
+}
+
+art::EntryNumberSequence
+art::MixHelper::secondaryEntries_(BranchType const bt,
+                                  EventIDSequence const& eIDseq) const
+{
+  assert(bt == InSubRun || bt == InRun);
+  EntryNumberSequence result;
+  result.reserve(eIDseq.size());
+  auto const& fileIndex = ioHandle_->fileIndex();
+  for (auto const& eID : eIDseq) {
+    auto const it = bt == InSubRun ?
+                      fileIndex.findPosition(eID.subRunID(), true) :
+                      fileIndex.findPosition(eID.runID(), true);
+    if (it == std::cend(fileIndex)) {
+      throw Exception(errors::NotFound, bt == InSubRun ? "NO_SUBRUN" : "NO_RUN")
+        << "- Unable to find an entry in the " << BranchTypeToString(bt)
+        << " tree corresponding to event ID " << eID
+        << " in secondary mixing input file " << currentFilename_ << ".\n";
+    }
+    result.emplace_back(it->entry);
+  }
+  return result;
+}
+
+// Returns the products of each mix operation, in the order of
+// mixOps_.  Once the pool has been filled, the products are taken
+// from it and the event entries are indices into the pool.
+std::vector<art::SpecProdList>
+art::MixHelper::readProducts_(EntryNumberSequence const& eventEntries,
+                              EventIDSequence const& eIDseq) const
+{
+  std::vector<SpecProdList> result;
+  result.reserve(mixOps_.size());
+  if (pool_) {
+    for (std::size_t i{}; i != mixOps_.size(); ++i) {
+      result.push_back(pool_->products(i, eventEntries));
+    }
+    return result;
+  }
+  if (lookAheadCovers_(eventEntries.size())) {
+    auto const indices = lookAheadIndices_(eventEntries.size());
+    for (std::size_t i{}; i != mixOps_.size(); ++i) {
+      result.push_back(lookAhead_->products(i, indices));
+    }
+    return result;
+  }
+  return readFromFile_(eventEntries, eIDseq);
+}
+
+std::vector<art::SpecProdList>
+art::MixHelper::readFromFile_(EntryNumberSequence const& eventEntries,
+                              EventIDSequence const& eIDseq) const
+{
+  std::vector<SpecProdList> result;
+  result.reserve(mixOps_.size());
+
   // Create required info only if we're likely to need it.
   EntryNumberSequence subRunEntries;
   EntryNumberSequence runEntries;
-  auto const& fileIndex = ioHandle_->fileIndex();
   if (haveSubRunMixOps_) {
-    subRunEntries.reserve(eIDseq.size());
-    for (auto const& eID : eIDseq) {
-      auto const it = fileIndex.findPosition(eID.subRunID(), true);
-      if (it == std::cend(fileIndex)) {
-        throw Exception(errors::NotFound, "NO_SUBRUN")
-          << "- Unable to find an entry in the SubRun tree corresponding to "
-             "event ID "
-          << eID << " in secondary mixing input file " << *fileIter_ << ".\n";
-      }
-      subRunEntries.emplace_back(it->entry);
-    }
+    subRunEntries = secondaryEntries_(InSubRun, eIDseq);
   }
   if (haveRunMixOps_) {
-    runEntries.reserve(eIDseq.size());
-    for (auto const& eID : eIDseq) {
-      auto const it = fileIndex.findPosition(eID.runID(), true);
-      if (it == std::cend(fileIndex)) {
-        throw Exception(errors::NotFound, "NO_RUN")
-          << "- Unable to find an entry in the Run tree corresponding to "
-             "event ID "
-          << eID << " in secondary mixing input file " << *fileIter_ << ".\n";
-      }
-      runEntries.emplace_back(it->entry);
-    }
+    runEntries = secondaryEntries_(InRun, eIDseq);
   }
 
-  // Populate the remapper in case we need to remap any Ptrs.
-  ptrRemapper_ = ptpBuilder_.getRemapper(e);
-
-  // Do the branch-wise read, mix and put.
   for (auto const& op : mixOps_) {
     switch (op->branchType()) {
-    case InEvent: {
-      auto const inProducts = ioHandle_->readFromFile(*op, eventEntries);
-      op->mixAndPut(e, inProducts, ptrRemapper_);
+    case InEvent:
+      result.push_back(ioHandle_->readFromFile(*op, eventEntries));
       continue;
-    }
-    case InSubRun: {
-      auto const inProducts = ioHandle_->readFromFile(*op, subRunEntries);
-      // Ptrs not supported for subrun product mixing.
-      op->mixAndPut(e, inProducts, nopRemapper);
+    case InSubRun:
+      result.push_back(ioHandle_->readFromFile(*op, subRunEntries));
       continue;
-    }
-    case InRun: {
-      auto const inProducts = ioHandle_->readFromFile(*op, runEntries);
-      // Ptrs not support for run product mixing.
-      op->mixAndPut(e, inProducts, nopRemapper);
+    case InRun:
+      result.push_back(ioHandle_->readFromFile(*op, runEntries));
       continue;
-    }
     default:
       throw Exception(errors::LogicError, "Unsupported BranchType")
         << "- MixHelper::mixAndPut() attempted to handle unsupported branch "
@@ -351,9 +554,142 @@ art::MixHelper::mixAndPut(EntryNumberSequence const& eventEntries,
         << op->branchType() << ".\n";
     }
   }
+  return result;
+}
 
-  nEventsReadThisFile_ += eventEntries.size();
-  totalEventsRead_ += eventEntries.size();
+// Whether the secondaries of the current event, which are the next
+// nSecondaries in the read order of the file, have been read ahead.
+bool
+art::MixHelper::lookAheadCovers_(std::size_t const nSecondaries) const
+{
+  return lookAhead_ && nEventsReadThisFile_ >= lookAheadFirst_ &&
+         nEventsReadThisFile_ + nSecondaries <=
+           lookAheadFirst_ + lookAhead_->size();
+}
+
+art::EntryNumberSequence
+art::MixHelper::lookAheadIndices_(std::size_t const nSecondaries) const
+{
+  EntryNumberSequence result(nSecondaries);
+  std::iota(begin(result), end(result), nEventsReadThisFile_ - lookAheadFirst_);
+  return result;
+}
+
+// Once the events read ahead cannot serve the next primary event,
+// starts reading the secondaries of the next lookAheadEvents_ primary
+// events, assuming each needs as many as the last one.
+void
+art::MixHelper::startLookAhead_(std::size_t const nSecondaries)
+{
+  if (lookAheadEvents_ == 0 || nSecondaries == 0 ||
+      lookAheadCovers_(nSecondaries)) {
+    return;
+  }
+  auto const first = nEventsReadThisFile_;
+  auto const nEventsInFile = ioHandle_->nEventsInFile();
+  if (first >= nEventsInFile) {
+    return;
+  }
+  auto const n =
+    std::min(lookAheadEvents_ * nSecondaries, nEventsInFile - first);
+  lookAhead_ = std::make_unique<SecondaryEventPool>(mixOps_.size());
+  lookAheadFirst_ = first;
+  lookAheadTasks_.run([this, first, n] { readAhead_(first, n); });
+}
+
+// Runs on a background task: only the I/O handle and the read order
+// of the current file are used, which do not change until the task
+// has been waited for.
+void
+art::MixHelper::readAhead_(std::size_t const first, std::size_t const n)
+{
+  EntryNumberSequence entries(n);
+  std::iota(begin(entries), end(entries), first);
+  if (readMode_ == Mode::RANDOM_NO_REPLACE) {
+    for (auto& entry : entries) {
+      entry = shuffledSequence_[entry];
+    }
+  }
+  EventIDSequence eIDs;
+  eIDs.reserve(n);
+  cet::transform_all(
+    entries, back_inserter(eIDs), EventIDLookup{eventIDIndex_});
+  lookAhead_->add(eIDs,
+                  ioHandle_->generateEventAuxiliarySequence(entries),
+                  readFromFile_(entries, eIDs));
+}
+
+void
+art::MixHelper::waitForLookAhead_()
+{
+  if (lookAheadEvents_ != 0) {
+    lookAheadTasks_.wait();
+  }
+}
+
+// Obtains the pool shared by the replicas of the module, filling it
+// if no replica has done so yet.
+bool
+art::MixHelper::fillPool_()
+{
+  auto pool = sharedPool_->get([this] { return readPool_(); });
+  if (!pool) {
+    return false;
+  }
+  // A replica that did not fill the pool has opened no file, and so
+  // takes the product-ID translation from the pool.
+  auto transMap = pool->productIDTransMap();
+  ptpBuilder_.prepareTranslationTables(transMap);
+  // From now on, entries are indices into the pool rather than into
+  // the last file opened.
+  if (readMode_ == Mode::RANDOM_NO_REPLACE) {
+    shuffledSequence_ = shuffled_entries(pool->size());
+  }
+  // The replicas of a module hold the same pool: in sequential mode,
+  // each starts at a different position.
+  poolCursor_ = readMode_ == Mode::SEQUENTIAL ?
+                  pool->size() * scheduleID_.id() / nSchedules_ :
+                  0;
+  pool_ = std::move(pool);
+  return true;
+}
+
+// Reads up to poolSize_ secondary events, starting with the first
+// secondary file, into a new pool.  Each file is read at most once.
+// Returns null if no event could be read.
+std::shared_ptr<art::SecondaryEventPool const>
+art::MixHelper::readPool_()
+{
+  auto pool = std::make_shared<SecondaryEventPool>(mixOps_.size());
+  std::size_t nFiles{};
+  while (pool->size() < poolSize_ && openNextFile_()) {
+    ++nFiles;
+    auto const nEventsInFile = ioHandle_->nEventsInFile();
+    if (nEventsReadThisFile_ < nEventsInFile) {
+      EntryNumberSequence entries(std::min(
+        poolSize_ - pool->size(), nEventsInFile - nEventsReadThisFile_));
+      std::iota(begin(entries), end(entries), nEventsReadThisFile_);
+      EventIDSequence eIDs;
+      eIDs.reserve(entries.size());
+      cet::transform_all(
+        entries, back_inserter(eIDs), EventIDLookup{eventIDIndex_});
+      pool->add(eIDs,
+                ioHandle_->generateEventAuxiliarySequence(entries),
+                readFromFile_(entries, eIDs));
+      nEventsReadThisFile_ += entries.size();
+    }
+    if (!providerFunc_ && nFiles == filenames_.size()) {
+      break;
+    }
+  }
+  if (pool->empty()) {
+    return nullptr;
+  }
+  pool->setProductIDTransMap(buildProductIDTransMap(mixOps_));
+  mf::LogInfo("MixingInput")
+    << "Read " << pool->size() << " secondary events from " << nFiles
+    << " file(s) into the pool of module " << moduleLabel_ << '.';
+  return pool;
 }
 
 void
@@ -362,6 +698,39 @@ art::MixHelper::setEventsToSkipFunction(std::function<size_t()> eventsToSkip)
   eventsToSkip_ = eventsToSkip;
 }
 
+void
+art::MixHelper::distributeSecondaryFiles(std::size_t const nSchedules)
+{
+  nSchedules_ = nSchedules;
+  if (filenames_.empty() || poolSize_ != 0) {
+    return;
+  }
+  if (filenames_.size() < nSchedules) {
+    if (!canWrapFiles_) {
+      throw Exception{errors::Configuration}
+        << "The mixing module " << moduleLabel_
+        << " has fewer secondary files (" << filenames_.size()
+        << ") than there are schedules (" << nSchedules << ").\n"
+        << "Since each file is read by only one schedule at a time, please "
+           "provide more files,\n"
+        << "or set wrapFiles to true so that files may be read by several "
+           "schedules.\n";
+    }
+    if (readMode_ == Mode::SEQUENTIAL || readMode_ == Mode::RANDOM_NO_REPLACE) {
+      throw Exception{errors::Configuration}
+        << "The mixing module " << moduleLabel_
+        << " has fewer secondary files (" << filenames_.size()
+        << ") than there are schedules (" << nSchedules << ").\n"
+        << "For a read mode of '" << readMode_
+        << "', schedules reading the same file would mix the same\n"
+        << "secondary events.  Please provide at least as many files as "
+           "schedules.\n";
+    }
+  }
+  fileDispenser_ =
+    secondaryFileDispenser(moduleLabel_, filenames_, canWrapFiles_);
+}
+
 auto
 art::MixHelper::initReadMode_(std::string const& mode) const -> Mode
 {
@@ -400,6 +769,11 @@ art::MixHelper::openNextFile_()
     }
   } else if (filenames_.empty()) {
     return false;
+  } else if (fileDispenser_) {
+    filename = fileDispenser_->next();
+    if (filename.empty()) {
+      return false;
+    }
   } else {
     if (ioHandle_->fileOpen()) { // Already seen one file.
       ++fileIter_;
@@ -416,6 +790,8 @@ art::MixHelper::openNextFile_()
     }
     filename = *fileIter_;
   }
+  currentFilename_ = filename;
+  lookAhead_.reset();
   nEventsReadThisFile_ = (readMode_ == Mode::SEQUENTIAL && eventsToSkip_) ?
                            eventsToSkip_() :
                            0; // Reset for this file.
@@ -427,11 +803,7 @@ art::MixHelper::openNextFile_()
 
   if (readMode_ == Mode::RANDOM_NO_REPLACE) {
     // Prepare shuffled event sequence.
-    shuffledSequence_.resize(ioHandle_->nEventsInFile());
-    std::iota(shuffledSequence_.begin(), shuffledSequence_.end(), 0);
-    std::random_device rd;
-    std::mt19937 g{rd()};
-    std::shuffle(shuffledSequence_.begin(), shuffledSequence_.end(), g);
+    shuffledSequence_ = shuffled_entries(ioHandle_->nEventsInFile());
   }
 
   return true;
@@ -460,12 +832,15 @@ art::MixHelper::consistentRequest_(std::string const& kind_of_engine_to_make,
 }
 
 cet::exempt_ptr<art::MixHelper::base_engine_t>
-art::MixHelper::initEngine_(seed_t const seed, Mode const readMode)
+art::MixHelper::initEngine_(seed_t const seed,
+                            Mode const readMode,
+                            ScheduleID const sid)
 {
   using namespace art;
   if (readMode > MixHelper::Mode::SEQUENTIAL) {
     if (ServiceRegistry::isAvailable<RandomNumberGenerator>()) {
-      return cet::make_exempt_ptr(&detail::EngineCreator::createEngine(seed));
+      return cet::make_exempt_ptr(
+        &detail::EngineCreator::createEngine(schedule_seed(seed, sid)));
     }
     throw Exception{errors::Configuration, "MixHelper"}
       << "Random event mixing selected but RandomNumberGenerator service "
@@ -34,7 +34,8 @@
 //          modules run in parallel either because of multiple trigger
 //          paths or because of streams when the mixing mode is
 //          Mode::SEQUENTIAL.  For art 3.0, mixing will be entirely
-//          serialized.
+//          serialized.  A ReplicatedMixFilter has one MixHelper per
+//          schedule; see distributeSecondaryFiles() below.
 //
 // coverageFraction (default 1.0).
 //
@@ -55,6 +56,50 @@
 //   the sequence of product pointers passed to the MixOp will be
 //   compacted to remove nullptrs.
 //
+// poolSize (default 0).
+//
+//   If non-zero, up to this many secondary events are read into
+//   memory (together with their subrun and run products) before the
+//   first primary event is mixed, continuing into the next secondary
+//   files as each is exhausted.  Each secondary file is read only
+//   once, irrespective of wrapFiles.  The secondaries are then chosen
+//   from this pool according to readMode, without further reading
+//   from the files: sequential mode cycles through the pool,
+//   randomNoReplace uses each pooled event once before reshuffling
+//   the pool, and coverageFraction is ignored.  A single primary
+//   event may thus be mixed with secondaries from different files.
+//   Since the products are read and deserialized only once, this
+//   suits jobs that mix many secondaries into each primary event
+//   from a sample small enough to be held in memory.  It is an error
+//   to request more secondaries for an event than the pool holds.
+//   The replicas of a replicated module share one pool, which is
+//   filled by the first replica to need it; the others wait for it.
+//   The pool is not shared with other mixing modules.
+//
+// lookAhead (default 0).
+//
+//   If non-zero, and the read mode is sequential or randomNoReplace
+//   (for which the secondaries of the coming events are known in
+//   advance), the products of the secondaries for this many coming
+//   primary events are read on a background task after each batch
+//   has been used up, so that reading overlaps the processing of the
+//   rest of the event.  The number of secondaries of the last event
+//   is taken as the number for each coming event; an event needing
+//   secondaries that have not been read ahead reads them itself.
+//   Reading ahead never crosses into the next secondary file.  It is
+//   ignored for other read modes and if poolSize is set.
+//
+// concurrentMixOps (default false).
+//
+//   If true, the mix operations of an event are run as parallel tasks
+//   once their secondary products have been obtained: products read
+//   from a file are still read one operation after the other, while
+//   those held by the pool or read ahead are simply shared.  Each mix
+//   function then runs, and its product is put into the event,
+//   concurrently with the others, so the mix functions (and any
+//   state of the detail object they use) must be safe to call from
+//   several threads at once.  Their Ptr remapper is shared.
+//
 ////////////////////////////////////////////////////////////////////////
 // readMode()
 //
@@ -227,12 +272,16 @@
 #include "art/Framework/IO/ProductMix/MixOp.h"
 #include "art/Framework/IO/ProductMix/MixTypes.h"
 #include "art/Framework/IO/ProductMix/ProdToProdMapBuilder.h"
+#include "art/Framework/IO/ProductMix/SecondaryEventPool.h"
+#include "art/Framework/IO/ProductMix/SecondaryFileDispenser.h"
 #include "art/Framework/Principal/fwd.h"
+#include "art/Utilities/ScheduleID.h"
 #include "canvas/Persistency/Provenance/BranchType.h"
 #include "cetlib/exempt_ptr.h"
 #include "fhiclcpp/fwd.h"
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/Sequence.h"
+#include "tbb/task_group.h"
 
 #include <functional>
 #include <iosfwd>
@@ -264,16 +313,25 @@ namespace art {
                                            1.0};
       fhicl::Atom<bool> wrapFiles{fhicl::Name{"wrapFiles"}, false};
       fhicl::Atom<seed_t> seed{fhicl::Name{"seed"}, -1};
+      fhicl::Atom<std::size_t> poolSize{fhicl::Name{"poolSize"}, 0};
+      fhicl::Atom<unsigned> lookAhead{fhicl::Name{"lookAhead"}, 0};
+      fhicl::Atom<bool> concurrentMixOps{fhicl::Name{"concurrentMixOps"},
+                                         false};
     };
 
+    // The random number engine, if any, is created for the given
+    // schedule.  On schedules other than the first, the seed is
+    // offset by the schedule number (see ReplicatedMixFilter.h).
     explicit MixHelper(Config const& config,
                        std::string const& moduleLabel,
                        ProducesCollector& collector,
-                       std::unique_ptr<MixIOPolicy> ioHandle);
+                       std::unique_ptr<MixIOPolicy> ioHandle,
+                       ScheduleID sid = ScheduleID::first());
     explicit MixHelper(fhicl::ParameterSet const& pset,
                        std::string const& moduleLabel,
                        ProducesCollector& collector,
-                       std::unique_ptr<MixIOPolicy> ioHandle);
+                       std::unique_ptr<MixIOPolicy> ioHandle,
+                       ScheduleID sid = ScheduleID::first());
     ~MixHelper();
 
     // Returns the current mixing mode.
@@ -375,19 +433,48 @@ namespace art {
                    Event& e);
     void setEventsToSkipFunction(std::function<size_t()> eventsToSkip);
 
+    // Takes the secondary files (if given by fileNames) from the
+    // dispenser shared by the MixHelpers of all nSchedules schedules
+    // running this module, rather than reading all of them.  Throws
+    // if there are fewer files than schedules, unless files may be
+    // wrapped and the read mode allows events to be reused.  With a
+    // secondary-event pool, the pool shared by all schedules is
+    // filled from all of the files.
+    void distributeSecondaryFiles(std::size_t nSchedules);
+
   private:
     MixHelper(MixHelper const&) = delete;
     MixHelper& operator=(MixHelper const&) = delete;
 
     using MixOpList = std::vector<std::unique_ptr<MixOpBase>>;
 
-    cet::exempt_ptr<base_engine_t> initEngine_(seed_t seed, Mode readMode);
+    cet::exempt_ptr<base_engine_t> initEngine_(seed_t seed,
+                                               Mode readMode,
+                                               ScheduleID sid);
     std::unique_ptr<CLHEP::RandFlat> initDist_(
       cet::exempt_ptr<base_engine_t> engine) const;
     bool consistentRequest_(std::string const& kind_of_engine_to_make,
                             label_t const& engine_label) const;
     Mode initReadMode_(std::string const& mode) const;
     bool openNextFile_();
+    bool fillPool_();
+    std::shared_ptr<SecondaryEventPool const> readPool_();
+    bool generatePoolSequence_(std::size_t nSecondaries,
+                               EntryNumberSequence& enSeq,
+                               EventIDSequence& eIDseq);
+    EntryNumberSequence secondaryEntries_(BranchType bt,
+                                          EventIDSequence const& eIDseq) const;
+    std::vector<SpecProdList> readProducts_(
+      EntryNumberSequence const& eventEntries,
+      EventIDSequence const& eIDseq) const;
+    std::vector<SpecProdList> readFromFile_(
+      EntryNumberSequence const& eventEntries,
+      EventIDSequence const& eIDseq) const;
+    bool lookAheadCovers_(std::size_t nSecondaries) const;
+    EntryNumberSequence lookAheadIndices_(std::size_t nSecondaries) const;
+    void startLookAhead_(std::size_t nSecondaries);
+    void readAhead_(std::size_t first, std::size_t n);
+    void waitForLookAhead_();
 
     ProdToProdMapBuilder::ProductIDTransMap buildProductIDTransMap_(
       MixOpList& mixOps);
@@ -400,6 +487,10 @@ namespace art {
     MixOpList mixOps_{};
     PtrRemapper ptrRemapper_{};
     std::vector<std::string>::const_iterator fileIter_;
+    ScheduleID const scheduleID_;
+    std::size_t nSchedules_{1};
+    std::shared_ptr<SecondaryFileDispenser> fileDispenser_{nullptr};
+    std::string currentFilename_{};
     Mode const readMode_;
     double const coverageFraction_;
     std::size_t nEventsReadThisFile_{};
@@ -414,6 +505,19 @@ namespace art {
     bool haveSubRunMixOps_{false};
     bool haveRunMixOps_{false};
     EventIDIndex eventIDIndex_{};
+    std::size_t const poolSize_;
+    std::shared_ptr<SharedSecondaryEventPool> const sharedPool_;
+    std::shared_ptr<SecondaryEventPool const> pool_{nullptr};
+    std::size_t poolCursor_{}; // SEQUENTIAL and RANDOM_NO_REPLACE only.
+    // The events read ahead, starting at position lookAheadFirst_ in
+    // the read order of the current file.  Filled by a task of
+    // lookAheadTasks_, which must be waited for before the I/O handle
+    // or these events are used.
+    unsigned const lookAheadEvents_;
+    std::unique_ptr<SecondaryEventPool> lookAhead_{nullptr};
+    std::size_t lookAheadFirst_{};
+    tbb::task_group lookAheadTasks_{};
+    bool const concurrentMixOps_;
 
     std::unique_ptr<MixIOPolicy> ioHandle_{nullptr};
   };
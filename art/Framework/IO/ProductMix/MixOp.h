@@ -5,9 +5,9 @@
 // Template encapsulating all the attributes and functionality of a
 // product mixing operation.
 
-#include "art/Framework/Core/InputSourceMutex.h"
 #include "art/Framework/IO/ProductMix/MixOpBase.h"
 #include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/InputSourceMutex.h"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Utilities/Globals.h"
 #include "canvas/Persistency/Provenance/BranchKey.h"
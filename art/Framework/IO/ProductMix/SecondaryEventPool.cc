@@ -0,0 +1,127 @@
+#include "art/Framework/IO/ProductMix/SecondaryEventPool.h"
+
+#include "canvas/Utilities/Exception.h"
+
+#include <cassert>
+#include <utility>
+
+namespace art {
+
+  SecondaryEventPool::SecondaryEventPool(std::size_t const nMixOps)
+    : products_(nMixOps)
+  {}
+
+  std::size_t
+  SecondaryEventPool::size() const noexcept
+  {
+    return eventIDs_.size();
+  }
+
+  bool
+  SecondaryEventPool::empty() const noexcept
+  {
+    return eventIDs_.empty();
+  }
+
+  void
+  SecondaryEventPool::add(EventIDSequence const& eventIDs,
+                          EventAuxiliarySequence const& auxiliaries,
+                          std::vector<SpecProdList> const& products)
+  {
+    assert(products.size() == products_.size());
+    auto const n = eventIDs.size();
+    if (auxiliaries.size() != n) {
+      throw Exception{errors::LogicError}
+        << "The number of event auxiliaries (" << auxiliaries.size()
+        << ") read for the secondary-event pool differs\n"
+        << "from the number of events (" << n << ").\n";
+    }
+    for (std::size_t op{}; op != products_.size(); ++op) {
+      if (products[op].size() != n) {
+        throw Exception{errors::LogicError}
+          << "The number of products (" << products[op].size()
+          << ") read for the secondary-event pool differs\n"
+          << "from the number of events (" << n << ").\n";
+      }
+      products_[op].insert(
+        end(products_[op]), cbegin(products[op]), cend(products[op]));
+    }
+    eventIDs_.insert(end(eventIDs_), cbegin(eventIDs), cend(eventIDs));
+    auxiliaries_.insert(
+      end(auxiliaries_), cbegin(auxiliaries), cend(auxiliaries));
+  }
+
+  EventIDSequence
+  SecondaryEventPool::eventIDs(EntryNumberSequence const& seq) const
+  {
+    EventIDSequence result;
+    result.reserve(seq.size());
+    for (auto const i : seq) {
+      result.push_back(eventIDs_.at(i));
+    }
+    return result;
+  }
+
+  EventAuxiliarySequence
+  SecondaryEventPool::auxiliaries(EntryNumberSequence const& seq) const
+  {
+    EventAuxiliarySequence result;
+    result.reserve(seq.size());
+    for (auto const i : seq) {
+      result.push_back(auxiliaries_.at(i));
+    }
+    return result;
+  }
+
+  SpecProdList
+  SecondaryEventPool::products(std::size_t const mixOp,
+                               EntryNumberSequence const& seq) const
+  {
+    auto const& products = products_.at(mixOp);
+    SpecProdList result;
+    result.reserve(seq.size());
+    for (auto const i : seq) {
+      result.push_back(products.at(i));
+    }
+    return result;
+  }
+
+  void
+  SecondaryEventPool::setProductIDTransMap(ProductIDTransMap transMap)
+  {
+    productIDTransMap_ = std::move(transMap);
+  }
+
+  SecondaryEventPool::ProductIDTransMap const&
+  SecondaryEventPool::productIDTransMap() const noexcept
+  {
+    return productIDTransMap_;
+  }
+
+  std::shared_ptr<SecondaryEventPool const>
+  SharedSecondaryEventPool::get(fill_t const& fill)
+  {
+    std::lock_guard sentry{mutex_};
+    if (!pool_) {
+      pool_ = fill();
+    }
+    return pool_;
+  }
+
+  std::shared_ptr<SharedSecondaryEventPool>
+  sharedSecondaryEventPool(std::string const& moduleLabel)
+  {
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<SharedSecondaryEventPool>>
+      pools;
+    std::lock_guard sentry{mutex};
+    auto& entry = pools[moduleLabel];
+    if (auto pool = entry.lock()) {
+      return pool;
+    }
+    auto pool = std::make_shared<SharedSecondaryEventPool>();
+    entry = pool;
+    return pool;
+  }
+
+} // namespace art
@@ -0,0 +1,97 @@
+#ifndef art_Framework_IO_ProductMix_SecondaryEventPool_h
+#define art_Framework_IO_ProductMix_SecondaryEventPool_h
+
+////////////////////////////////////////////////////////////////////////
+// SecondaryEventPool
+//
+// The secondary events that have been read into memory for mixing,
+// possibly from several secondary files.  For each event, the pool
+// holds its ID, its auxiliary, and the (already deserialized)
+// products of every mix operation, including the subrun and run
+// products of the subrun and run the event belongs to.  Events are
+// referred to by their index in the pool.
+//
+// Once filled, the pool is only read, so that it may be used by any
+// number of threads at the same time.  The products are shared with
+// the mix operations rather than copied.  The same class holds the
+// secondary events that MixHelper reads ahead.
+//
+// The pool of a module is shared by all replicas of the module, and
+// is filled only once: use sharedSecondaryEventPool() to obtain the
+// SharedSecondaryEventPool through which it is filled.
+////////////////////////////////////////////////////////////////////////
+
+#include "art/Framework/IO/ProductMix/MixTypes.h"
+#include "canvas/Persistency/Provenance/EventAuxiliary.h"
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace art {
+
+  class SecondaryEventPool {
+  public:
+    explicit SecondaryEventPool(std::size_t nMixOps);
+
+    std::size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    // Adds the events; the products are given per mix operation, in
+    // the order of the events.
+    void add(EventIDSequence const& eventIDs,
+             EventAuxiliarySequence const& auxiliaries,
+             std::vector<SpecProdList> const& products);
+
+    EventIDSequence eventIDs(EntryNumberSequence const& seq) const;
+    EventAuxiliarySequence auxiliaries(EntryNumberSequence const& seq) const;
+    SpecProdList products(std::size_t mixOp,
+                          EntryNumberSequence const& seq) const;
+
+    // The translation of the product IDs of the secondary events into
+    // those of the mixed products, for the remapping of Ptrs.
+    using ProductIDTransMap = std::map<ProductID, ProductID>;
+    void setProductIDTransMap(ProductIDTransMap transMap);
+    ProductIDTransMap const& productIDTransMap() const noexcept;
+
+  private:
+    EventIDSequence eventIDs_{};
+    EventAuxiliarySequence auxiliaries_{};
+    // Indexed by mix operation, then by event.
+    std::vector<SpecProdList> products_;
+    ProductIDTransMap productIDTransMap_{};
+  };
+
+  class SharedSecondaryEventPool {
+  public:
+    using fill_t = std::function<std::shared_ptr<SecondaryEventPool const>()>;
+
+    // Returns the pool, calling fill to create it unless a replica
+    // already has.  Replicas calling at the same time wait for the
+    // one that fills the pool.  A null pool is not kept, so that the
+    // next caller tries again.
+    std::shared_ptr<SecondaryEventPool const> get(fill_t const& fill);
+
+  private:
+    std::mutex mutex_{};
+    std::shared_ptr<SecondaryEventPool const> pool_{nullptr};
+  };
+
+  // The shared pool of the module with the given label, created on
+  // first use.
+  std::shared_ptr<SharedSecondaryEventPool> sharedSecondaryEventPool(
+    std::string const& moduleLabel);
+
+} // namespace art
+
+#endif /* art_Framework_IO_ProductMix_SecondaryEventPool_h */
+
+// Local Variables:
+// mode: c++
+// End:
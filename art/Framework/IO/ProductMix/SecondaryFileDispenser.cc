@@ -0,0 +1,53 @@
+#include "art/Framework/IO/ProductMix/SecondaryFileDispenser.h"
+
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include <map>
+#include <utility>
+
+namespace art {
+
+  SecondaryFileDispenser::SecondaryFileDispenser(
+    std::vector<std::string> fileNames,
+    bool const wrapFiles)
+    : fileNames_{std::move(fileNames)}, wrapFiles_{wrapFiles}
+  {}
+
+  std::string
+  SecondaryFileDispenser::next()
+  {
+    std::lock_guard sentry{mutex_};
+    if (fileNames_.empty()) {
+      return {};
+    }
+    if (next_ == fileNames_.size()) {
+      if (!wrapFiles_) {
+        return {};
+      }
+      mf::LogWarning("MixingInputWrap")
+        << "Wrapping around to initial input file for mixing.";
+      next_ = 0;
+    }
+    return fileNames_[next_++];
+  }
+
+  std::shared_ptr<SecondaryFileDispenser>
+  secondaryFileDispenser(std::string const& moduleLabel,
+                         std::vector<std::string> const& fileNames,
+                         bool const wrapFiles)
+  {
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<SecondaryFileDispenser>>
+      dispensers;
+    std::lock_guard sentry{mutex};
+    auto& entry = dispensers[moduleLabel];
+    if (auto dispenser = entry.lock()) {
+      return dispenser;
+    }
+    auto dispenser =
+      std::make_shared<SecondaryFileDispenser>(fileNames, wrapFiles);
+    entry = dispenser;
+    return dispenser;
+  }
+
+} // namespace art
@@ -0,0 +1,51 @@
+#ifndef art_Framework_IO_ProductMix_SecondaryFileDispenser_h
+#define art_Framework_IO_ProductMix_SecondaryFileDispenser_h
+
+////////////////////////////////////////////////////////////////////////
+// SecondaryFileDispenser
+//
+// Hands out the secondary files of a mixing module, in the configured
+// order, to the MixHelpers of all schedules, so that each file is
+// read by only one schedule at a time.  Once all files have been
+// handed out, they are handed out again from the first one if
+// wrapping is allowed; otherwise an empty name is returned.
+//
+// The dispenser of a module is shared by all replicas of the module:
+// use secondaryFileDispenser() to obtain it.
+////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace art {
+
+  class SecondaryFileDispenser {
+  public:
+    SecondaryFileDispenser(std::vector<std::string> fileNames, bool wrapFiles);
+
+    std::string next();
+
+  private:
+    std::vector<std::string> const fileNames_;
+    bool const wrapFiles_;
+    std::mutex mutex_{};
+    std::size_t next_{};
+  };
+
+  // The dispenser of the secondary files of the module with the given
+  // label, created on first use.
+  std::shared_ptr<SecondaryFileDispenser> secondaryFileDispenser(
+    std::string const& moduleLabel,
+    std::vector<std::string> const& fileNames,
+    bool wrapFiles);
+
+} // namespace art
+
+#endif /* art_Framework_IO_ProductMix_SecondaryFileDispenser_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -374,6 +374,53 @@ namespace art {
       using Parameters = EDFilter::Table<Config>;
     };
 
+    ////////////////////////////////////////////////////////////////////
+    // Mixes the secondaries chosen by the helper into the event: the
+    // filter() steps shared by MixFilter and ReplicatedMixFilter.
+    template <typename T>
+    void
+    mix_secondaries(T& mixDetail, MixHelper& helper, Event& e)
+    {
+      // 1. Call detail object's startEvent() if it exists.
+      if constexpr (has_startEvent<T>::value) {
+        mixDetail.startEvent(e);
+      }
+
+      // 2. Ask detail object how many events to read.
+      size_t const nSecondaries = mixDetail.nSecondaries();
+
+      // 3. Decide which events we're reading and prime the event tree
+      //    cache.
+      EntryNumberSequence enSeq;
+      EventIDSequence eIDseq;
+      enSeq.reserve(nSecondaries);
+      eIDseq.reserve(nSecondaries);
+      if (!helper.generateEventSequence(nSecondaries, enSeq, eIDseq)) {
+        throw Exception(errors::FileReadError)
+          << "Insufficient secondary events available to mix.\n";
+      }
+
+      // 4. Give the event ID sequence to the detail object.
+      if constexpr (has_processEventIDs<T>::value) {
+        mixDetail.processEventIDs(eIDseq);
+      }
+
+      // 5. Give the event auxiliary sequence to the detail object.
+      if constexpr (has_processEventAuxiliaries<T>::value) {
+        auto const auxseq = helper.generateEventAuxiliarySequence(enSeq);
+        mixDetail.processEventAuxiliaries(auxseq);
+      }
+
+      // 6. Make the MixHelper read info into all the products, invoke
+      //    the mix functions and put the products into the event.
+      helper.mixAndPut(enSeq, eIDseq, e);
+
+      // 7. Call detail object's finalizeEvent() if it exists.
+      if constexpr (has_finalizeEvent<T>::value) {
+        mixDetail.finalizeEvent(e);
+      }
+    }
+
   } // namespace detail
 
 } // namespace art
@@ -480,44 +527,7 @@ template <typename T, typename IOPolicy>
 bool
 art::MixFilter<T, IOPolicy>::filter(Event& e)
 {
-  // 1. Call detail object's startEvent() if it exists.
-  if constexpr (detail::has_startEvent<T>::value) {
-    detail_.startEvent(e);
-  }
-
-  // 2. Ask detail object how many events to read.
-  size_t const nSecondaries = detail_.nSecondaries();
-
-  // 3. Decide which events we're reading and prime the event tree
-  //    cache.
-  EntryNumberSequence enSeq;
-  EventIDSequence eIDseq;
-  enSeq.reserve(nSecondaries);
-  eIDseq.reserve(nSecondaries);
-  if (!helper_.generateEventSequence(nSecondaries, enSeq, eIDseq)) {
-    throw Exception(errors::FileReadError)
-      << "Insufficient secondary events available to mix.\n";
-  }
-
-  // 4. Give the event ID sequence to the detail object.
-  if constexpr (detail::has_processEventIDs<T>::value) {
-    detail_.processEventIDs(eIDseq);
-  }
-
-  // 5. Give the event auxiliary sequence to the detail object.
-  if constexpr (detail::has_processEventAuxiliaries<T>::value) {
-    auto const auxseq = helper_.generateEventAuxiliarySequence(enSeq);
-    detail_.processEventAuxiliaries(auxseq);
-  }
-
-  // 6. Make the MixHelper read info into all the products, invoke the
-  //    mix functions and put the products into the event.
-  helper_.mixAndPut(enSeq, eIDseq, e);
-
-  // 7. Call detail object's finalizeEvent() if it exists.
-  if constexpr (detail::has_finalizeEvent<T>::value) {
-    detail_.finalizeEvent(e);
-  }
+  detail::mix_secondaries(detail_, helper_, e);
   return true;
 }
 
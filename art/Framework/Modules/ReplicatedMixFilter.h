@@ -0,0 +1,224 @@
+#ifndef art_Framework_Modules_ReplicatedMixFilter_h
+#define art_Framework_Modules_ReplicatedMixFilter_h
+
+////////////////////////////////////////////////////////////////////////
+//
+// The ReplicatedMixFilter class template creates mixing filters in the
+// same way as MixFilter (see art/Framework/Modules/MixFilter.h for the
+// requirements on the detail type T and the IOPolicy), but as a
+// replicated module: each schedule has its own copy of the detail
+// object and of the MixHelper, with its own secondary-file handle,
+// random number engine, and Ptr remapper.  The filter is thus not
+// serialized against the other modules of the job, and events of
+// different schedules are mixed concurrently.
+//
+// The secondary files given by fileNames are handed out in turn to
+// the schedules as each needs a new file, so that no file is read by
+// two schedules at once.  It is a configuration error to give fewer
+// files than there are schedules, unless wrapFiles is true and the
+// read mode is randomReplace or randomLimReplace: several schedules
+// then read the same file, choosing their secondaries independently.
+// A detail object that registers a secondary file name provider must
+// ensure that the providers of the different schedules cooperate.
+//
+// Notes.
+//
+// 1. In a random read mode, the engine of schedule i is created with
+//    the configured seed plus i (with seed i if no seed is given,
+//    except on the first schedule), so that the schedules choose
+//    different secondaries.  These seeds must not be used by other
+//    modules.
+//
+// 2. The detail object may not declare endSubRun(SubRun&) or
+//    endRun(Run&), since a replicated module cannot put subrun or run
+//    products.  beginSubRun and beginRun receive const references.
+//
+// 3. Copies of the IOPolicy on different schedules are used
+//    concurrently, each with its own file.
+//
+// 4. With a secondary-event pool (poolSize), files are not handed
+//    out: each schedule fills its own pool from all of the files, so
+//    that the job holds one pool per schedule.  In sequential mode,
+//    the schedules start cycling through their pools at different
+//    positions.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "art/Framework/Core/ProcessingFrame.h"
+#include "art/Framework/Core/ReplicatedFilter.h"
+#include "art/Framework/IO/ProductMix/MixHelper.h"
+#include "art/Framework/Modules/MixFilter.h"
+#include "art/Utilities/Globals.h"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace art {
+  template <typename T, typename IOPolicy>
+  class ReplicatedMixFilter;
+}
+
+template <typename T, typename IOPolicy>
+class art::ReplicatedMixFilter : public ReplicatedFilter {
+public:
+  using MixDetail = T;
+
+  using Parameters = typename detail::maybe_has_Parameters<T>::Parameters;
+
+  template <typename U = Parameters>
+  explicit ReplicatedMixFilter(
+    std::enable_if_t<std::is_same_v<U, fhicl::ParameterSet>,
+                     fhicl::ParameterSet> const& p,
+    ProcessingFrame const& frame);
+  template <typename U = Parameters>
+  explicit ReplicatedMixFilter(
+    std::enable_if_t<!std::is_same_v<U, fhicl::ParameterSet>, U> const& p,
+    ProcessingFrame const& frame);
+
+private:
+  static_assert(!detail::has_endSubRun<T>::value,
+                "A ReplicatedMixFilter detail class may not declare "
+                "endSubRun(SubRun&).");
+  static_assert(!detail::has_endRun<T>::value,
+                "A ReplicatedMixFilter detail class may not declare "
+                "endRun(Run&).");
+
+  void initialize_();
+
+  void respondToOpenInputFile(FileBlock const& fb,
+                              ProcessingFrame const&) override;
+  void respondToCloseInputFile(FileBlock const& fb,
+                               ProcessingFrame const&) override;
+  void respondToOpenOutputFiles(FileBlock const& fb,
+                                ProcessingFrame const&) override;
+  void respondToCloseOutputFiles(FileBlock const& fb,
+                                 ProcessingFrame const&) override;
+  bool filter(Event& e, ProcessingFrame const&) override;
+  void beginSubRun(SubRun const& sr, ProcessingFrame const&) override;
+  void beginRun(Run const& r, ProcessingFrame const&) override;
+
+  MixHelper helper_;
+  MixDetail detail_;
+};
+
+template <typename T, typename IOPolicy>
+template <typename U>
+art::ReplicatedMixFilter<T, IOPolicy>::ReplicatedMixFilter(
+  std::enable_if_t<std::is_same_v<U, fhicl::ParameterSet>,
+                   fhicl::ParameterSet> const& p,
+  ProcessingFrame const& frame)
+  : ReplicatedFilter{p, frame}
+  , helper_{p,
+            p.template get<std::string>("module_label"),
+            producesCollector(),
+            std::make_unique<IOPolicy>(),
+            frame.scheduleID()}
+  , detail_{p, helper_}
+{
+  initialize_();
+}
+
+template <typename T, typename IOPolicy>
+template <typename U>
+art::ReplicatedMixFilter<T, IOPolicy>::ReplicatedMixFilter(
+  std::enable_if_t<!std::is_same_v<U, fhicl::ParameterSet>, U> const& p,
+  ProcessingFrame const& frame)
+  : ReplicatedFilter{p, frame}
+  , helper_{p().mixHelper(),
+            p.get_PSet().template get<std::string>("module_label"),
+            producesCollector(),
+            std::make_unique<IOPolicy>(),
+            frame.scheduleID()}
+  , detail_{p().userConfig, helper_}
+{
+  initialize_();
+}
+
+template <typename T, typename IOPolicy>
+void
+art::ReplicatedMixFilter<T, IOPolicy>::initialize_()
+{
+  if constexpr (detail::has_eventsToSkip<T>::value) {
+    helper_.setEventsToSkipFunction([this] { return detail_.eventsToSkip(); });
+  }
+  helper_.distributeSecondaryFiles(Globals::instance()->nschedules());
+}
+
+template <typename T, typename IOPolicy>
+void
+art::ReplicatedMixFilter<T, IOPolicy>::respondToOpenInputFile(
+  FileBlock const& fb,
+  ProcessingFrame const&)
+{
+  if constexpr (detail::has_respondToOpenInputFile<T>::value) {
+    detail_.respondToOpenInputFile(fb);
+  }
+}
+
+template <typename T, typename IOPolicy>
+void
+art::ReplicatedMixFilter<T, IOPolicy>::respondToCloseInputFile(
+  FileBlock const& fb,
+  ProcessingFrame const&)
+{
+  if constexpr (detail::has_respondToCloseInputFile<T>::value) {
+    detail_.respondToCloseInputFile(fb);
+  }
+}
+
+template <typename T, typename IOPolicy>
+void
+art::ReplicatedMixFilter<T, IOPolicy>::respondToOpenOutputFiles(
+  FileBlock const& fb,
+  ProcessingFrame const&)
+{
+  if constexpr (detail::has_respondToOpenOutputFiles<T>::value) {
+    detail_.respondToOpenOutputFiles(fb);
+  }
+}
+
+template <typename T, typename IOPolicy>
+void
+art::ReplicatedMixFilter<T, IOPolicy>::respondToCloseOutputFiles(
+  FileBlock const& fb,
+  ProcessingFrame const&)
+{
+  if constexpr (detail::has_respondToCloseOutputFiles<T>::value) {
+    detail_.respondToCloseOutputFiles(fb);
+  }
+}
+
+template <typename T, typename IOPolicy>
+bool
+art::ReplicatedMixFilter<T, IOPolicy>::filter(Event& e, ProcessingFrame const&)
+{
+  detail::mix_secondaries(detail_, helper_, e);
+  return true;
+}
+
+template <typename T, typename IOPolicy>
+void
+art::ReplicatedMixFilter<T, IOPolicy>::beginSubRun(SubRun const& sr,
+                                                   ProcessingFrame const&)
+{
+  if constexpr (detail::has_beginSubRun<T>::value) {
+    detail_.beginSubRun(sr);
+  }
+}
+
+template <typename T, typename IOPolicy>
+void
+art::ReplicatedMixFilter<T, IOPolicy>::beginRun(Run const& r,
+                                                ProcessingFrame const&)
+{
+  if constexpr (detail::has_beginRun<T>::value) {
+    detail_.beginRun(r);
+  }
+}
+
+#endif /* art_Framework_Modules_ReplicatedMixFilter_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -3,12 +3,14 @@
 #include "art/Framework/Principal/ProcessTag.h"
 #include "art/Framework/Principal/ProductInfo.h"
 #include "art/Persistency/Provenance/ModuleDescription.h"
+#include "canvas/Persistency/Provenance/BranchDescription.h"
 #include "canvas/Persistency/Provenance/BranchType.h"
+#include "canvas/Persistency/Provenance/ProductTables.h"
 #include "canvas/Utilities/TypeID.h"
 #include "cetlib/HorizontalRule.h"
-#include "cetlib/container_algorithms.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <set>
 
@@ -101,20 +103,42 @@ namespace art {
     array<vector<ProductInfo>, NumBranchTypes> const& consumables)
   {
     std::lock_guard sentry{mutex_};
-    consumables_.emplace(module_label, consumables);
+    auto const [it, inserted] = modules_.try_emplace(module_label);
+    if (!inserted) {
+      return;
+    }
+    auto& module_consumes = it->second;
+    module_consumes.consumables = consumables;
+    for (size_t bt = 0; bt != consumables.size(); ++bt) {
+      module_consumes.resolvedProducts[bt] =
+        vector<detail::ResolvedProductsSlot>(consumables[bt].size());
+    }
   }
 
-  void
-  ConsumesInfo::validateConsumedProduct(BranchType const bt,
-                                        ModuleDescription const& md,
-                                        ProductInfo const& productInfo)
+  cet::exempt_ptr<detail::ModuleConsumes>
+  ConsumesInfo::moduleConsumes(string const& module_label)
   {
+    // No entries are added once products are being retrieved.
+    auto const it = modules_.find(module_label);
+    return it != modules_.end() ? &it->second : nullptr;
+  }
 
-    std::lock_guard sentry{mutex_};
-    if (cet::binary_search_all(consumables_[md.moduleLabel()][bt],
-                               productInfo)) {
-      // Found it, everything is ok.
-      return;
+  cet::exempt_ptr<detail::ResolvedProductsSlot>
+  ConsumesInfo::validateConsumedProduct(
+    BranchType const bt,
+    ModuleDescription const& md,
+    cet::exempt_ptr<detail::ModuleConsumes> const module_consumes,
+    ProductInfo const& productInfo)
+  {
+    if (module_consumes) {
+      auto const& consumables = module_consumes->consumables[bt];
+      auto const it =
+        std::lower_bound(consumables.cbegin(), consumables.cend(), productInfo);
+      if (it != consumables.cend() && !(productInfo < *it)) {
+        // Found it, everything is ok.
+        auto const i = static_cast<size_t>(it - consumables.cbegin());
+        return &module_consumes->resolvedProducts[bt][i];
+      }
     }
     if (requireConsumes_.load()) {
       throw Exception(errors::ProductRegistrationFailure,
@@ -124,7 +148,61 @@ namespace art {
         << module_context(md) << ":\n\n"
         << "  " << assemble_consumes_statement(bt, productInfo) << "\n\n";
     }
+    std::lock_guard sentry{mutex_};
     missingConsumes_[md.moduleLabel()][bt].insert(productInfo);
+    return nullptr;
+  }
+
+  namespace {
+    // Unspecified process names, and those that only restrict the
+    // search to the input source, match any process.
+    bool
+    process_matches(ProcessTag const& tag, BranchDescription const& pd)
+    {
+      auto const& name = tag.name();
+      return name.empty() || name == "input_source" ||
+             name == pd.processName();
+    }
+
+    bool
+    consumable_matches(ProductInfo const& pi, BranchDescription const& pd)
+    {
+      switch (pi.consumableType) {
+      case ProductInfo::ConsumableType::Product:
+        return pi.friendlyClassName == pd.friendlyClassName() &&
+               pi.label == pd.moduleLabel() &&
+               pi.instance == pd.productInstanceName() &&
+               process_matches(pi.process, pd);
+      case ProductInfo::ConsumableType::ViewElement:
+        // The product type is not known from the element type.
+        return pi.label == pd.moduleLabel() &&
+               pi.instance == pd.productInstanceName() &&
+               process_matches(pi.process, pd);
+      case ProductInfo::ConsumableType::Many:
+        return pi.friendlyClassName == pd.friendlyClassName();
+      }
+      return false;
+    }
+  }
+
+  vector<ProductID>
+  ConsumesInfo::consumedProducts(BranchType const bt,
+                                 ProductTable const& products) const
+  {
+    vector<ProductID> result;
+    std::lock_guard sentry{mutex_};
+    for (auto const& [pid, pd] : products.descriptions) {
+      for (auto const& per_module : modules_) {
+        auto const& infos = per_module.second.consumables[bt];
+        if (std::any_of(cbegin(infos), cend(infos), [&pd](auto const& pi) {
+              return consumable_matches(pi, pd);
+            })) {
+          result.push_back(pid);
+          break;
+        }
+      }
+    }
+    return result;
   }
 
   void
@@ -70,7 +70,11 @@
 // interface is, therefore, not supported in non-module contexts.
 //============================================================================
 
+#include "art/Framework/Principal/detail/ResolvedProducts.h"
 #include "canvas/Persistency/Provenance/BranchType.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Persistency/Provenance/fwd.h"
+#include "cetlib/exempt_ptr.h"
 
 #include <array>
 #include <atomic>
@@ -85,6 +89,18 @@ namespace art {
   class ModuleDescription;
   class ProductInfo;
 
+  namespace detail {
+    // The consumes declarations of one module, with a lookup cache for
+    // each of them at the same index.  The declarations do not change
+    // once they have been collected, so they may be read without
+    // locking.
+    struct ModuleConsumes {
+      std::array<std::vector<ProductInfo>, NumBranchTypes> consumables;
+      std::array<std::vector<ResolvedProductsSlot>, NumBranchTypes>
+        resolvedProducts;
+    };
+  }
+
   class ConsumesInfo {
   public: // MEMBER FUNCTIONS -- Special Member Functions
     ~ConsumesInfo();
@@ -109,32 +125,49 @@ namespace art {
     consumables_t::mapped_type const&
     consumables(std::string const& module_label) const
     {
-      return consumables_.at(module_label);
+      return modules_.at(module_label).consumables;
     }
 
+    // Must be called for every module before any product is retrieved.
     void collectConsumes(std::string const& module_label,
                          consumables_t::mapped_type const& consumables);
 
-    // This is used by get*() in ProductRetriever.
-    void validateConsumedProduct(BranchType const,
-                                 ModuleDescription const&,
-                                 ProductInfo const& productInfo);
+    // The collected declarations of the module, or null if there are
+    // none.  This is looked up once per ProductRetriever.
+    cet::exempt_ptr<detail::ModuleConsumes> moduleConsumes(
+      std::string const& module_label);
+
+    // This is used by get*() in ProductRetriever.  If the product
+    // was declared by the module, the slot in which the result of
+    // its lookup may be cached is returned.  Only a missing
+    // declaration takes the lock.
+    cet::exempt_ptr<detail::ResolvedProductsSlot> validateConsumedProduct(
+      BranchType const,
+      ModuleDescription const&,
+      cet::exempt_ptr<detail::ModuleConsumes> module_consumes,
+      ProductInfo const& productInfo);
 
     void showMissingConsumes() const;
 
+    // The products of the table that may be retrieved through the
+    // consumes declarations of any module.
+    std::vector<ProductID> consumedProducts(BranchType,
+                                            ProductTable const&) const;
+
   private:
     ConsumesInfo();
 
-    // Protects access to consumables_ and missingConsumes_.
+    // Protects access to modules_ while consumes information is
+    // collected, and to missingConsumes_.
     mutable std::recursive_mutex mutex_{};
 
     std::atomic<bool> requireConsumes_;
 
-    // Maps module label to run, per-branch consumes info.  Note that
-    // there is only one entry per module label.  This is intentional
-    // so that we do not need to store consumes information for each
-    // replicated module object.
-    consumables_t consumables_;
+    // Maps module label to its consumes info.  Note that there is only
+    // one entry per module label.  This is intentional so that we do
+    // not need to store consumes information for each replicated
+    // module object.
+    std::map<std::string const, detail::ModuleConsumes> modules_;
 
     // Maps module label to run, per-branch missing product consumes info.
     std::map<std::string const,
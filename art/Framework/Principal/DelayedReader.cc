@@ -1,13 +1,33 @@
 #include "art/Framework/Principal/DelayedReader.h"
+#include "art/Framework/Principal/InputSourceMutex.h"
 #include "art/Framework/Principal/Principal.h"
+#include "art/Utilities/FrameworkPhases.h"
 // vim: set sw=2 expandtab :
 
 #include "canvas/Persistency/Provenance/ProductProvenance.h"
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+
 using namespace std;
 
 namespace art {
 
+  namespace {
+    // Reads of a branch are serialized across all principals, and
+    // thus across schedules, by a mutex per product ID.  The entries
+    // are never removed, so references to them stay valid.
+    mutex&
+    branch_mutex(ProductID const pid)
+    {
+      static mutex registryMutex;
+      static map<ProductID, mutex> mutexes;
+      lock_guard sentry{registryMutex};
+      return mutexes[pid];
+    }
+  } // unnamed namespace
+
   DelayedReader::DelayedReader() = default;
   DelayedReader::~DelayedReader() noexcept = default;
 
@@ -16,6 +36,13 @@ namespace art {
                             ProductID const pid,
                             RangeSet& rs) const
   {
+    // The read is not part of the lookup that triggers it.
+    FrameworkPhaseSentry const phase{FrameworkPhase::ProductRead};
+    if (concurrentReadsSafe_()) {
+      lock_guard sentry{branch_mutex(pid)};
+      return getProduct_(grp, pid, rs);
+    }
+    InputSourceMutexSentry sentry;
     return getProduct_(grp, pid, rs);
   }
 
@@ -62,4 +89,52 @@ namespace art {
     return nullptr;
   }
 
+  bool
+  DelayedReader::concurrentReadsSafe() const
+  {
+    return concurrentReadsSafe_();
+  }
+
+  bool
+  DelayedReader::concurrentReadsSafe_() const
+  {
+    return false;
+  }
+
+  bool
+  DelayedReader::prefetchesProducts() const
+  {
+    return prefetchesProducts_();
+  }
+
+  bool
+  DelayedReader::prefetchesProducts_() const
+  {
+    return false;
+  }
+
+  void
+  DelayedReader::prefetchProducts(vector<ProductID> const& pids) const
+  {
+    FrameworkPhaseSentry const phase{FrameworkPhase::ProductRead};
+    if (concurrentReadsSafe_()) {
+      // The branch mutexes are taken in product-ID order so that two
+      // prefetches cannot wait on each other.
+      auto sorted = pids;
+      sort(begin(sorted), end(sorted));
+      sorted.erase(unique(begin(sorted), end(sorted)), end(sorted));
+      vector<unique_lock<mutex>> sentries;
+      sentries.reserve(sorted.size());
+      for (auto const pid : sorted) {
+        sentries.emplace_back(branch_mutex(pid));
+      }
+      prefetchProducts_(pids);
+      return;
+    }
+    InputSourceMutexSentry sentry;
+    prefetchProducts_(pids);
+  }
+
+  void DelayedReader::prefetchProducts_(vector<ProductID> const&) const {}
+
 } // namespace art
@@ -8,6 +8,17 @@
 // Abstract interface used by EventPrincipal to request
 // input sources to retrieve EDProducts from external storage.
 //
+// Product reads are serialized with the input source unless the
+// reader declares, by overriding concurrentReadsSafe_, that different
+// products may be read concurrently.  Reads of the same branch are
+// then still serialized, across all principals and schedules.
+//
+// A reader that declares, by overriding prefetchesProducts_, that it
+// can read products in batches is also given, ahead of the first
+// lookups, the set of products that the job consumes so that it can
+// read them in one pass; it then hands them out through getProduct_
+// as usual.  Other readers are not asked.
+//
 
 #include "art/Framework/Principal/fwd.h"
 #include "canvas/Persistency/Common/EDProduct.h"
@@ -32,6 +43,9 @@ namespace art {
     std::vector<ProductProvenance> readProvenance() const;
     bool isAvailableAfterCombine(ProductID) const;
     std::unique_ptr<Principal> readFromSecondaryFile(int& idx);
+    bool concurrentReadsSafe() const;
+    bool prefetchesProducts() const;
+    void prefetchProducts(std::vector<ProductID> const&) const;
 
   private:
     virtual std::unique_ptr<EDProduct> getProduct_(Group const*,
@@ -41,6 +55,9 @@ namespace art {
     virtual std::vector<ProductProvenance> readProvenance_() const;
     virtual bool isAvailableAfterCombine_(ProductID) const;
     virtual std::unique_ptr<Principal> readFromSecondaryFile_(int& idx);
+    virtual bool concurrentReadsSafe_() const;
+    virtual bool prefetchesProducts_() const;
+    virtual void prefetchProducts_(std::vector<ProductID> const&) const;
   };
 
 } // namespace art
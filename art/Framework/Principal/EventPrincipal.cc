@@ -111,11 +111,14 @@ namespace art {
     aux_.setProcessHistoryID(processHistoryID());
   }
 
-  void
+  std::size_t
   EventPrincipal::createGroupsForProducedProducts(
-    ProductTables const& producedProducts)
+    ProductTables const& producedProducts,
+    std::vector<std::unique_ptr<Group>>&& recycled)
   {
-    Principal::createGroupsForProducedProducts(producedProducts);
+    auto const reused = Principal::createGroupsForProducedProducts(
+      producedProducts, move(recycled));
     refreshProcessHistoryID();
+    return reused;
   }
 } // namespace art
@@ -44,7 +44,9 @@ namespace art {
     bool isReal() const;
     bool isLastInSubRun() const;
 
-    void createGroupsForProducedProducts(ProductTables const& producedProducts);
+    std::size_t createGroupsForProducedProducts(
+      ProductTables const& producedProducts,
+      std::vector<std::unique_ptr<Group>>&& recycled = {});
     void refreshProcessHistoryID();
 
   private:
@@ -37,12 +37,30 @@ namespace art {
     , product_{edp.release()}
     , rangeSet_{rs.release()}
     , grpType_{gt}
+    , lockFreeReads_{bd.branchType() != InRun && bd.branchType() != InSubRun}
   {}
 
+  std::unique_lock<std::recursive_mutex>
+  Group::readLock_() const
+  {
+    if (lockFreeReads_) {
+      return std::unique_lock{mutex_, std::defer_lock};
+    }
+    return std::unique_lock{mutex_};
+  }
+
+  void
+  Group::setResolution_(resolution const r) const
+  {
+    if (lockFreeReads_) {
+      resolution_.store(r, std::memory_order_release);
+    }
+  }
+
   EDProduct const*
   Group::getIt_() const
   {
-    std::lock_guard sentry{mutex_};
+    auto sentry = readLock_();
     if (grpType_ == grouptype::normal) {
       resolveProductIfAvailable();
       return product_.load();
@@ -53,7 +71,7 @@ namespace art {
   EDProduct const*
   Group::anyProduct() const
   {
-    std::lock_guard sentry{mutex_};
+    auto sentry = readLock_();
     if (grpType_ == grouptype::normal) {
       return product_.load();
     }
@@ -77,7 +95,7 @@ namespace art {
   EDProduct const*
   Group::uniqueProduct() const
   {
-    std::lock_guard sentry{mutex_};
+    auto sentry = readLock_();
     if (grpType_ == grouptype::normal) {
       return product_.load();
     }
@@ -90,7 +108,7 @@ namespace art {
   EDProduct const*
   Group::uniqueProduct(TypeID const& wanted_wrapper_type) const
   {
-    std::lock_guard sentry{mutex_};
+    auto sentry = readLock_();
     if (product_.load() == nullptr) {
       return nullptr;
     }
@@ -137,14 +155,14 @@ namespace art {
   RangeSet const&
   Group::rangeOfValidity() const
   {
-    std::lock_guard sentry{mutex_};
+    auto sentry = readLock_();
     return *rangeSet_.load();
   }
 
   cet::exempt_ptr<ProductProvenance const>
   Group::productProvenance() const
   {
-    std::lock_guard sentry{mutex_};
+    auto sentry = readLock_();
     return productProvenance_.load();
   }
 
@@ -166,12 +184,36 @@ namespace art {
                                  unique_ptr<RangeSet>&& rs)
   {
     std::lock_guard sentry{mutex_};
+    // The new product must be checked for availability before the
+    // readers may skip the lock again.
+    resolution_ = resolution::unresolved;
     delete productProvenance_.load();
     productProvenance_ = pp.release();
     delete product_.load();
     product_ = edp.release();
-    delete rangeSet_.load();
-    rangeSet_ = rs.release();
+    if (rs) {
+      delete rangeSet_.load();
+      rangeSet_ = rs.release();
+    }
+  }
+
+  void
+  Group::recycle(DelayedReader* reader)
+  {
+    assert(branchDescription_.produced());
+    delayedReader_ = reader;
+    delete productProvenance_.exchange(nullptr);
+    delete product_.exchange(nullptr);
+    delete partnerProduct_.exchange(nullptr);
+    delete baseProduct_.exchange(nullptr);
+    delete partnerBaseProduct_.exchange(nullptr);
+    // The range set object is reused.
+    if (auto rs = rangeSet_.load()) {
+      *rs = RangeSet::invalid();
+    } else {
+      rangeSet_ = new RangeSet{RangeSet::invalid()};
+    }
+    resolution_ = resolution::unresolved;
   }
 
   void
@@ -184,6 +226,7 @@ namespace art {
         << "This routine should only be used to remove large data products "
         << "read from disk (like raw digits).\n";
     }
+    resolution_ = resolution::unresolved;
     delete product_.load();
     product_ = nullptr;
     if (grpType_ == grouptype::normal) {
@@ -211,6 +254,9 @@ namespace art {
       return false;
     }
     assert(branchDescription_.present() || branchDescription_.produced());
+    if (resolution_.load(std::memory_order_acquire) == resolution::resolved) {
+      return true;
+    }
     std::lock_guard sentry{mutex_};
     bool availableAfterCombine{false};
     if ((branchDescription_.branchType() == InSubRun) ||
@@ -286,6 +332,18 @@ namespace art {
   Group::resolveProductIfAvailable(
     TypeID wanted_wrapper_type /*= TypeID{}*/) const
   {
+    switch (resolution_.load(std::memory_order_acquire)) {
+    case resolution::unavailable:
+      return false;
+    case resolution::resolved:
+      if (!wanted_wrapper_type || grpType_ == grouptype::normal) {
+        return true;
+      }
+      // The partner products of an Assns are made under the lock.
+      break;
+    case resolution::unresolved:
+      break;
+    }
     std::lock_guard sentry{mutex_};
     // Now try to get the master product.
     if (product_.load() == nullptr) {
@@ -296,6 +354,7 @@ namespace art {
       }
       if (!productAvailable()) {
         // Not possible to get it, hopeless.
+        setResolution_(resolution::unavailable);
         return false;
       }
       // Now try to read it.
@@ -308,9 +367,15 @@ namespace art {
           .release();
       if (product_.load() == nullptr) {
         // We failed to get the master product, hopeless.
+        setResolution_(resolution::unavailable);
         return false;
       }
     }
+    if (resolution_.load() == resolution::unresolved && productAvailable()) {
+      // A product that has been read but is a dummy filler is not
+      // available; it keeps being checked under the lock.
+      setResolution_(resolution::resolved);
+    }
 
     if (!wanted_wrapper_type) {
       // The type of the product is not known, therefore the on-disk
@@ -376,7 +441,7 @@ namespace art {
   bool
   Group::tryToResolveProduct(TypeID const& wanted_wrapper)
   {
-    std::lock_guard sentry{mutex_};
+    auto sentry = readLock_();
     resolveProductIfAvailable(wanted_wrapper);
 
     // If the product is a dummy filler, it will now be marked unavailable.
@@ -66,25 +66,53 @@ namespace art {
     void setProductProvenance(std::unique_ptr<ProductProvenance const>&&);
 
     // Called by Principal::put
+    // Note: A null range set keeps the current one.
     void setProductAndProvenance(std::unique_ptr<ProductProvenance const>&&,
                                  std::unique_ptr<EDProduct>&&,
                                  std::unique_ptr<RangeSet>&&);
 
+    // Called by Principal::createGroupsForProducedProducts
+    // Clears a group of a produced product so that it can be used by
+    // another principal.  No other thread may be using the group.
+    void recycle(DelayedReader*);
+
   private:
+    // The resolution state of the product.  Once a product has been
+    // resolved, the accessors and resolveProductIfAvailable need only
+    // load the state and the product pointers; the mutex is taken
+    // only while the product is still being resolved, which also
+    // makes other readers wait for a delayed read in flight.
+    //
+    //   unresolved:  nothing is known yet, the mutex must be taken.
+    //   resolved:    the product is present and available.
+    //   unavailable: the product cannot be obtained from the input
+    //                of this principal.
+    //
+    // Run and subRun products may be replaced by a put while they are
+    // combined, so those groups stay unresolved and are always read
+    // under the mutex.
+    enum class resolution : unsigned char { unresolved, resolved, unavailable };
+
+    std::unique_lock<std::recursive_mutex> readLock_() const;
+    void setResolution_(resolution) const;
+
     BranchDescription const& branchDescription_;
 
     // Back pointer to the delayed reader in the principal that owns
     // us.
-    cet::exempt_ptr<DelayedReader const> const delayedReader_;
-    // Used to serialize access to productProvenance_, product_,
-    // rangeSet_, partnerProduct_, baseProduct_, and
+    // Note: Modified by recycle.
+    cet::exempt_ptr<DelayedReader const> delayedReader_;
+    // Used to serialize the modification of productProvenance_,
+    // product_, rangeSet_, partnerProduct_, baseProduct_, and
     // partnerBaseProduct_.  This is recursive because sometimes we
     // may need to replace the product provenance when merging run or
     // subRun data products while checking if the product is
     // available, which we may do while resolving a a product with
     // this locked to make the updating of provenance and product
-    // pointers together one atomic transaction.
+    // pointers together one atomic transaction.  Readers do not take
+    // it once the product has been resolved.
     mutable std::recursive_mutex mutex_{};
+    mutable std::atomic<resolution> resolution_{resolution::unresolved};
     // The product provenance for the data product.
     // Note: Modified by setProductProvenance (called by Principal ctors and
     // Principal::insert_pp (called by Principal::put).
@@ -100,6 +128,8 @@ namespace art {
     mutable std::atomic<RangeSet*> rangeSet_;
     // Are we normal, assns, or assnsWithData?
     grouptype const grpType_;
+    // False for run and subRun products, see resolution.
+    bool const lockFreeReads_;
     //
     //  AssnsGroup
     //
@@ -1,4 +1,4 @@
-#include "art/Framework/Core/InputSourceMutex.h"
+#include "art/Framework/Principal/InputSourceMutex.h"
 // vim: set sw=2 expandtab :
 
 namespace art {
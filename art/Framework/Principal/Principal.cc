@@ -11,6 +11,7 @@
 #include "art/Persistency/Common/GroupQueryResult.h"
 #include "art/Persistency/Provenance/ModuleContext.h"
 #include "art/Persistency/Provenance/ProcessHistoryRegistry.h"
+#include "art/Utilities/FrameworkPhases.h"
 #include "canvas/Persistency/Common/WrappedTypeID.h"
 #include "canvas/Persistency/Provenance/BranchDescription.h"
 #include "canvas/Persistency/Provenance/BranchType.h"
@@ -28,6 +29,7 @@
 #include "cetlib/exempt_ptr.h"
 #include "range/v3/view.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <memory>
@@ -46,6 +48,14 @@ namespace art {
 
   namespace {
 
+    // Only lookups in events are charged to the framework time of the
+    // schedule.
+    ScheduleID
+    lookup_schedule(BranchType const bt, ModuleContext const& mc)
+    {
+      return bt == InEvent ? mc.scheduleID() : ScheduleID{};
+    }
+
     unique_ptr<Group>
     create_group(DelayedReader* reader, BranchDescription const& bd)
     {
@@ -62,6 +72,16 @@ namespace art {
         reader, bd, make_unique<RangeSet>(RangeSet::invalid()), gt);
     }
 
+    // If we are processing a trigger path, the only visible produced
+    // products are those that originate from modules on the same path
+    // we're currently processing.
+    bool
+    visible_on_path(ModuleContext const& mc, BranchDescription const& pd)
+    {
+      return !(mc.onTriggerPath() && pd.produced() &&
+               !mc.onSamePathAs(pd.moduleLabel()));
+    }
+
   } // unnamed namespace
 
   void
@@ -78,11 +98,7 @@ namespace art {
     //       code expects to be able to find a group for dropped
     //       products, so getGroupTryAllFiles ignores groups for
     //       dropped products instead.
-    for (auto const& pd :
-         presentProducts->descriptions | ranges::views::values) {
-      assert(pd.branchType() == branchType_);
-      fillGroup(pd);
-    }
+    fillGroups(*presentProducts);
   }
 
   void
@@ -133,11 +149,27 @@ namespace art {
     ctor_fetch_process_history(hist);
   }
 
+  namespace {
+    auto
+    find_group(Principal::GroupCollection const& groups, ProductID const pid)
+    {
+      auto it = std::lower_bound(cbegin(groups),
+                                 cend(groups),
+                                 pid,
+                                 [](auto const& entry, auto const id) {
+                                   return entry.first < id;
+                                 });
+      if (it != cend(groups) && it->first == pid) {
+        return it;
+      }
+      return cend(groups);
+    }
+  }
+
   void
-  Principal::fillGroup(BranchDescription const& pd)
+  Principal::checkForCollision(BranchDescription const& pd) const
   {
-    std::lock_guard sentry{groupMutex_};
-    auto it = groups_.find(pd.productID());
+    auto it = find_group(groups_, pd.productID());
     if (it != std::cend(groups_)) {
       // The 'combinable' call does not require that the processing
       // history be the same, which is not what we are checking for here.
@@ -158,8 +190,44 @@ namespace art {
            "the product ID collision.\n"
         << "In addition, please notify artists@fnal.gov of this error.\n";
     }
+  }
 
-    groups_[pd.productID()] = create_group(delayedReader_.get(), pd);
+  // Creates the groups for all products of the table in one pass: the
+  // new groups are appended, sorted, and merged with the existing
+  // ones, which keeps the collection ordered by ProductID.  A recycled
+  // group is used in place of a new one if it belongs to the same
+  // product description, in the same position.
+  std::size_t
+  Principal::fillGroups(ProductTable const& products,
+                        std::vector<std::unique_ptr<Group>>* recycled)
+  {
+    for (auto const& pd : products.descriptions | ranges::views::values) {
+      assert(pd.branchType() == branchType_);
+      checkForCollision(pd);
+    }
+    auto const n = groups_.size();
+    groups_.reserve(n + products.descriptions.size());
+    std::size_t i{}, reused{};
+    for (auto const& pd : products.descriptions | ranges::views::values) {
+      if (recycled && i < recycled->size() &&
+          &(*recycled)[i]->productDescription() == &pd) {
+        auto& group = (*recycled)[i++];
+        group->recycle(delayedReader_.get());
+        groups_.emplace_back(pd.productID(), move(group));
+        ++reused;
+        continue;
+      }
+      ++i;
+      groups_.emplace_back(pd.productID(),
+                           create_group(delayedReader_.get(), pd));
+    }
+    auto const middle = begin(groups_) + n;
+    auto by_product_id = [](auto const& a, auto const& b) {
+      return a.first < b.first;
+    };
+    std::sort(middle, end(groups_), by_product_id);
+    std::inplace_merge(begin(groups_), middle, end(groups_), by_product_id);
+    return reused;
   }
 
   // FIXME: This breaks the purpose of the
@@ -197,23 +265,39 @@ namespace art {
     return productGetter(pid);
   }
 
-  void
+  std::size_t
   Principal::createGroupsForProducedProducts(
-    ProductTables const& producedProducts)
+    ProductTables const& producedProducts,
+    std::vector<std::unique_ptr<Group>>&& recycled)
   {
     auto const& produced = producedProducts.get(branchType_);
     producedProducts_ = &produced;
     if (produced.descriptions.empty()) {
-      return;
+      return 0;
     }
     // The process history is expanded if there is a product that is
     // produced in this process.
     addToProcessHistory();
-    for (auto const& pd : produced.descriptions | ranges::views::values) {
-      assert(pd.branchType() == branchType_);
-      // Create a group for the produced product.
-      fillGroup(pd);
+    // Create the groups for the produced products.
+    return fillGroups(produced, &recycled);
+  }
+
+  std::vector<std::unique_ptr<Group>>
+  Principal::releaseProducedGroups()
+  {
+    std::vector<std::unique_ptr<Group>> result;
+    for (auto& group : groups_ | ranges::views::values) {
+      if (group->productDescription().produced()) {
+        result.push_back(move(group));
+      }
     }
+    groups_.erase(std::remove_if(begin(groups_),
+                                 end(groups_),
+                                 [](auto const& entry) {
+                                   return entry.second == nullptr;
+                                 }),
+                  end(groups_));
+    return result;
   }
 
   void
@@ -237,12 +321,37 @@ namespace art {
     //          because the delay read fills the pp_by_pid_ one entry
     //          at a time, and we do not want other threads to find
     //          the info only partly there.
-    std::lock_guard sentry{groupMutex_};
     for (auto const& group : groups_ | ranges::views::values) {
       group->resolveProductIfAvailable();
     }
   }
 
+  void
+  Principal::prefetchProducts(std::vector<ProductID> const& pids) const
+  {
+    if (!prefetchesProducts()) {
+      return;
+    }
+    std::vector<ProductID> available;
+    available.reserve(pids.size());
+    for (auto const pid : pids) {
+      auto group = getGroupLocal(pid);
+      if (group && !group->productDescription().produced() &&
+          group->productAvailable()) {
+        available.push_back(pid);
+      }
+    }
+    if (!available.empty()) {
+      delayedReader_->prefetchProducts(available);
+    }
+  }
+
+  bool
+  Principal::prefetchesProducts() const
+  {
+    return delayedReader_->prefetchesProducts();
+  }
+
   ProcessHistory const&
   Principal::processHistory() const
   {
@@ -262,35 +371,30 @@ namespace art {
   size_t
   Principal::size() const
   {
-    std::lock_guard sentry{groupMutex_};
     return groups_.size();
   }
 
   Principal::const_iterator
   Principal::begin() const
   {
-    std::lock_guard sentry{groupMutex_};
     return groups_.begin();
   }
 
   Principal::const_iterator
   Principal::cbegin() const
   {
-    std::lock_guard sentry{groupMutex_};
     return groups_.cbegin();
   }
 
   Principal::const_iterator
   Principal::end() const
   {
-    std::lock_guard sentry{groupMutex_};
     return groups_.end();
   }
 
   Principal::const_iterator
   Principal::cend() const
   {
-    std::lock_guard sentry{groupMutex_};
     return groups_.cend();
   }
 
@@ -313,27 +417,19 @@ namespace art {
     return ret;
   }
 
-  // Note: threading: The solution chosen for the following
-  // problems is to convert groups_ from type:
+  // Note: threading: groups_ was once a mutex-guarded
   //
   //   std::map<ProductID, std::unique_ptr<Group>>
   //
-  // to type:
-  //
-  //   tbb::concurrent_unordered_map<
-  //     ProductID, std::unique_ptr<Group>>
-  //
-  // We get concurrent insertion and iteration, but not
-  // concurrent erasure (which is not a problem because we never
-  // remove groups).  Note that tbb uses a value for the end()
-  // iterator for this class which is always valid for comparing
-  // against the result of an interation or find (it is
-  // implemented as (<element-ptr>(nullptr), <internal-table>)).
-  //
-  // Note: threading: May be called from producer and filter
-  // module processing tasks! This requires us to protect
-  // groups_ against multiple threads attempting an insert at
-  // the same time.
+  // and it was planned to convert it to a
+  // tbb::concurrent_unordered_map.  It is now a vector sorted by
+  // ProductID that is filled only while the principal is set up:
+  // by the constructor, and by createGroupsForProducedProducts,
+  // which the EventProcessor calls with the input source lock held
+  // before the principal is handed to any module.  Puts never
+  // insert groups, they fill the ones created here.  Lookups are a
+  // lock-free binary search and iterators are never invalidated
+  // while modules run.
   //
   // Note: threading: Also anyone using the iterators over
   // groups_ (which are Principal::begin() and Principal::end())
@@ -490,6 +586,8 @@ namespace art {
                            SelectorBase const& sel,
                            ProcessTag const& processTag) const
   {
+    FrameworkPhaseSentry const sentry{FrameworkPhase::ProductLookup,
+                                      lookup_schedule(branchType_, mc)};
     auto const groups = findGroupsForProduct(mc, wrapped, sel, processTag);
     auto const result = resolve_unique_product(groups, wrapped);
     if (!result.has_value()) {
@@ -503,17 +601,120 @@ namespace art {
   }
 
   GroupQueryResult
-  Principal::getByLabel(ModuleContext const& mc,
-                        WrappedTypeID const& wrapped,
-                        string const& label,
-                        string const& productInstanceName,
-                        ProcessTag const& processTag) const
+  Principal::getByLabel(
+    ModuleContext const& mc,
+    WrappedTypeID const& wrapped,
+    string const& label,
+    string const& productInstanceName,
+    ProcessTag const& processTag,
+    cet::exempt_ptr<detail::ResolvedProductsSlot> const resolved) const
+  {
+    FrameworkPhaseSentry const sentry{FrameworkPhase::ProductLookup,
+                                      lookup_schedule(branchType_, mc)};
+    auto make_selector = [&label, &productInstanceName, &processTag] {
+      return Selector{ModuleLabelSelector{label} &&
+                      ProductInstanceNameSelector{productInstanceName} &&
+                      ProcessNameSelector{processTag.name()}};
+    };
+    if (!resolved || !enableLookupOfProducedProducts_.load()) {
+      return getBySelector(mc, wrapped, make_selector(), processTag);
+    }
+    auto products = resolved->load();
+    if (!products || !products->validFor(productTablesGeneration_,
+                                         producedProducts_.load(),
+                                         presentProducts_.load(),
+                                         processHistoryID())) {
+      products = resolveProducts(wrapped, make_selector(), processTag);
+      resolved->store(products);
+    }
+    std::vector<cet::exempt_ptr<Group>> groups;
+    findVisibleGroups(products->produced, mc, groups);
+    findVisibleGroups(products->present, mc, groups);
+    if (!groups.empty()) {
+      if (auto result = resolve_unique_product(groups, wrapped)) {
+        return *result;
+      }
+    }
+    // Either the product must be looked for in the secondary input
+    // files, or the lookup failed and the full search provides the
+    // diagnostics.
+    return getBySelector(mc, wrapped, make_selector(), processTag);
+  }
+
+  // The selector match does not depend on the module context, so the
+  // result may be shared by all lookups that use the same product
+  // tables and process history.  Secondary input files are not
+  // considered.
+  std::shared_ptr<detail::ResolvedProducts const>
+  Principal::resolveProducts(WrappedTypeID const& wrapped,
+                             SelectorBase const& sel,
+                             ProcessTag const& processTag) const
+  {
+    auto result = std::make_shared<detail::ResolvedProducts>();
+    result->tablesGeneration = productTablesGeneration_;
+    result->producedProducts = producedProducts_.load();
+    result->presentProducts = presentProducts_.load();
+    result->processHistoryID = processHistoryID();
+    auto const& friendlyClassName = wrapped.product_type.friendlyClassName();
+    auto find_product_ids = [this, &friendlyClassName, &sel](
+                              ProductTable const* table, auto& pids) {
+      if (table == nullptr) {
+        return;
+      }
+      auto const& lookup = table->productLookup;
+      if (auto it = lookup.find(friendlyClassName); it != lookup.end()) {
+        findProductIDs(it->second, sel, pids);
+      }
+    };
+    if (processTag.current_process_search_allowed()) {
+      find_product_ids(result->producedProducts, result->produced);
+    }
+    if (processTag.input_source_search_allowed()) {
+      find_product_ids(result->presentProducts, result->present);
+    }
+    return result;
+  }
+
+  void
+  Principal::findProductIDs(ProcessLookup const& pl,
+                            SelectorBase const& sel,
+                            std::vector<ProductID>& pids) const
   {
-    auto const& processName = processTag.name();
-    Selector const sel{ModuleLabelSelector{label} &&
-                       ProductInstanceNameSelector{productInstanceName} &&
-                       ProcessNameSelector{processName}};
-    return getBySelector(mc, wrapped, sel, processTag);
+    // See findGroups for the order in which the processes are visited.
+    std::lock_guard sentry{processHistory_.get_mutex()};
+    for (auto const& h :
+         ranges::views::reverse(processHistory_) | ranges::views::unique) {
+      auto it = pl.find(h.processName());
+      if (it == pl.end()) {
+        continue;
+      }
+      for (auto const pid : it->second) {
+        auto group = getGroupLocal(pid);
+        if (!group) {
+          continue;
+        }
+        auto const& pd = group->productDescription();
+        if (pd.dropped() || !sel.match(pd)) {
+          continue;
+        }
+        pids.push_back(pid);
+      }
+    }
+  }
+
+  void
+  Principal::findVisibleGroups(
+    std::vector<ProductID> const& pids,
+    ModuleContext const& mc,
+    std::vector<cet::exempt_ptr<Group>>& groups) const
+  {
+    for (auto const pid : pids) {
+      auto group = getGroupLocal(pid);
+      if (!group || !visible_on_path(mc, group->productDescription())) {
+        continue;
+      }
+      groups.emplace_back(group);
+    }
   }
 
   std::vector<InputTag>
@@ -522,6 +723,8 @@ namespace art {
                           SelectorBase const& sel,
                           ProcessTag const& processTag) const
   {
+    FrameworkPhaseSentry const sentry{FrameworkPhase::ProductLookup,
+                                      lookup_schedule(branchType_, mc)};
     std::vector<InputTag> tags;
     auto const groups = findGroupsForProduct(mc, wrapped, sel, processTag);
     cet::transform_all(groups, back_inserter(tags), [](auto const g) {
@@ -536,6 +739,8 @@ namespace art {
                      SelectorBase const& sel,
                      ProcessTag const& processTag) const
   {
+    FrameworkPhaseSentry const sentry{FrameworkPhase::ProductLookup,
+                                      lookup_schedule(branchType_, mc)};
     auto const groups = findGroupsForProduct(mc, wrapped, sel, processTag);
     return resolve_products(groups, wrapped.wrapped_product_type);
   }
@@ -551,6 +756,8 @@ namespace art {
                                  SelectorBase const& selector,
                                  ProcessTag const& processTag) const
   {
+    FrameworkPhaseSentry const sentry{FrameworkPhase::ProductLookup,
+                                      lookup_schedule(branchType_, mc)};
     std::vector<cet::exempt_ptr<Group>> groups;
     // Find groups from current process
     if (processTag.current_process_search_allowed() &&
@@ -680,11 +887,7 @@ namespace art {
       if (pd.dropped()) {
         continue;
       }
-      // If we are processing a trigger path, the only visible
-      // produced products are those that originate from modules on
-      // the same path we're currently processing.
-      if (mc.onTriggerPath() && pd.produced() &&
-          !mc.onSamePathAs(pd.moduleLabel())) {
+      if (!visible_on_path(mc, pd)) {
         continue;
       }
       if (!sel.match(pd)) {
@@ -730,8 +933,8 @@ namespace art {
           << "Problem found during put of " << branchType_
           << " product: product already put for " << bd.branchName() << '\n';
       }
-      group->setProductAndProvenance(
-        move(pp), move(edp), make_unique<RangeSet>(RangeSet::invalid()));
+      // The range set of the group is always invalid.
+      group->setProductAndProvenance(move(pp), move(edp), nullptr);
     }
   }
 
@@ -848,8 +1051,7 @@ namespace art {
   cet::exempt_ptr<Group>
   Principal::getGroupLocal(ProductID const pid) const
   {
-    std::lock_guard sentry{groupMutex_};
-    auto it = groups_.find(pid);
+    auto it = find_group(groups_, pid);
     return it != groups_.cend() ? it->second.get() : nullptr;
   }
 
@@ -22,6 +22,7 @@
 #include "art/Framework/Principal/NoDelayedReader.h"
 #include "art/Framework/Principal/OutputHandle.h"
 #include "art/Framework/Principal/ProductInserter.h"
+#include "art/Framework/Principal/detail/ResolvedProducts.h"
 #include "art/Framework/Principal/fwd.h"
 #include "art/Persistency/Common/GroupQueryResult.h"
 #include "art/Persistency/Provenance/fwd.h"
@@ -42,13 +43,16 @@
 #include <mutex>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace art {
 
   class Principal : public PrincipalBase {
   public:
-    using GroupCollection = std::map<ProductID, std::unique_ptr<Group>>;
+    // The groups are kept sorted by ProductID in contiguous storage.
+    using GroupCollection =
+      std::vector<std::pair<ProductID, std::unique_ptr<Group>>>;
     using const_iterator = GroupCollection::const_iterator;
     enum class allowed_processes { current_process, input_source, all };
 
@@ -83,11 +87,16 @@ namespace art {
                                    WrappedTypeID const& wrapped,
                                    SelectorBase const&,
                                    ProcessTag const&) const;
-    GroupQueryResult getByLabel(ModuleContext const& mc,
-                                WrappedTypeID const& wrapped,
-                                std::string const& label,
-                                std::string const& productInstanceName,
-                                ProcessTag const& processTag) const;
+    // If a slot is given, the products matching the label are cached
+    // in it and reused for later principals with the same product
+    // tables, of the same generation, and process history.
+    GroupQueryResult getByLabel(
+      ModuleContext const& mc,
+      WrappedTypeID const& wrapped,
+      std::string const& label,
+      std::string const& productInstanceName,
+      ProcessTag const& processTag,
+      cet::exempt_ptr<detail::ResolvedProductsSlot> resolved = nullptr) const;
     std::vector<GroupQueryResult> getMany(ModuleContext const& mc,
                                           WrappedTypeID const& wrapped,
                                           SelectorBase const&,
@@ -129,8 +138,17 @@ namespace art {
 
     // The product tables data member for produced products is set by
     // the EventProcessor after the Principal is provided by the input
-    // source.
-    void createGroupsForProducedProducts(ProductTables const& producedProducts);
+    // source.  Groups released by an earlier principal of the same
+    // branch type may be given for reuse; the number of groups that
+    // were reused is returned.
+    std::size_t createGroupsForProducedProducts(
+      ProductTables const& producedProducts,
+      std::vector<std::unique_ptr<Group>>&& recycled = {});
+
+    // Removes the groups of the produced products so that they can be
+    // given to another principal.  They are returned in the order in
+    // which createGroupsForProducedProducts accepts them.
+    std::vector<std::unique_ptr<Group>> releaseProducedGroups();
     void enableLookupOfProducedProducts();
 
     // FIXME: This breaks the purpose of the
@@ -142,6 +160,20 @@ namespace art {
     // Read all data products and provenance immediately, if available.
     void readImmediate() const;
 
+    // Whether the delayed reader reads products in batches.
+    bool prefetchesProducts() const;
+
+    // Let the delayed reader read those of the given products that
+    // are available in one pass, ahead of their lookups.  Does
+    // nothing unless the reader reads products in batches.
+    void prefetchProducts(std::vector<ProductID> const&) const;
+
+    ProductTable const*
+    presentProducts() const
+    {
+      return presentProducts_.load();
+    }
+
     ProcessConfiguration const& processConfiguration() const;
 
     ProcessHistoryID const&
@@ -179,6 +211,10 @@ namespace art {
   private:
     // Used by our ctors.
     void ctor_create_groups(cet::exempt_ptr<ProductTable const>);
+    std::size_t fillGroups(ProductTable const&,
+                           std::vector<std::unique_ptr<Group>>* recycled =
+                             nullptr);
+    void checkForCollision(BranchDescription const&) const;
     void ctor_read_provenance();
     void ctor_fetch_process_history(ProcessHistoryID const&);
 
@@ -201,6 +237,16 @@ namespace art {
       ModuleContext const& mc,
       SelectorBase const& selector,
       std::vector<cet::exempt_ptr<Group>>& groups) const;
+    std::shared_ptr<detail::ResolvedProducts const> resolveProducts(
+      WrappedTypeID const& wrapped,
+      SelectorBase const&,
+      ProcessTag const&) const;
+    void findProductIDs(ProcessLookup const&,
+                        SelectorBase const&,
+                        std::vector<ProductID>& pids) const;
+    void findVisibleGroups(std::vector<ProductID> const& pids,
+                           ModuleContext const&,
+                           std::vector<cet::exempt_ptr<Group>>& groups) const;
     bool producedInProcess(ProductID) const;
     bool presentFromSource(ProductID) const;
     auto tryNextSecondaryFile() const;
@@ -217,9 +263,6 @@ namespace art {
     cet::exempt_ptr<Group> getGroupTryAllFiles(ProductID const) const;
 
   protected:
-    // Used to deal with TriggerResults.
-    void fillGroup(BranchDescription const&);
-
     // Used by addToProcessHistory()
     void setProcessHistoryIDcombined(ProcessHistoryID const&);
 
@@ -236,13 +279,13 @@ namespace art {
     std::atomic<ProductTable const*> presentProducts_;
     std::atomic<ProductTable const*> producedProducts_{nullptr};
     std::atomic<bool> enableLookupOfProducedProducts_{false};
+    std::size_t const productTablesGeneration_{
+      detail::product_tables_generation()};
 
-    // Protects access to groups_.
-    mutable std::recursive_mutex groupMutex_{};
-
-    // All of the currently known data products.
-    // tbb::concurrent_unordered_map<ProductID, std::unique_ptr<Group>>
-    // groups_{};
+    // All of the currently known data products.  Groups are only
+    // inserted while the principal is being set up (construction and
+    // createGroupsForProducedProducts), before it is handed to any
+    // module, so lookups and iteration need no lock.
     GroupCollection groups_{};
 
     // Pointer to the reader that will be used to obtain
@@ -75,10 +75,8 @@ namespace art {
     for (auto&& [product, pd, rs] : putProducts_ | ranges::views::values) {
       auto pp = make_unique<ProductProvenance const>(
         pd.productID(), productstatus::present(), retrievedPIDs);
-      principal_->put(pd,
-                      move(pp),
-                      move(product),
-                      make_unique<RangeSet>(RangeSet::invalid()));
+      // Event products have no range set.
+      principal_->put(pd, move(pp), move(product), nullptr);
     }
     putProducts_.clear();
   }
@@ -39,6 +39,7 @@ namespace art {
     , principal_{principal}
     , mc_{mc}
     , md_{mc.moduleDescription()}
+    , consumes_{ConsumesInfo::instance()->moduleConsumes(md_.moduleLabel())}
     , recordParents_{recordParents}
   {}
 
@@ -122,6 +123,7 @@ namespace art {
     ConsumesInfo::instance()->validateConsumedProduct(
       branchType_,
       md_,
+      consumes_,
       ProductInfo{ProductInfo::ConsumableType::ViewElement,
                   typeID,
                   moduleLabel,
@@ -209,9 +211,10 @@ namespace art {
                             tag.label(),
                             tag.instance(),
                             processTag};
-    ConsumesInfo::instance()->validateConsumedProduct(branchType_, md_, pinfo);
+    auto const resolved = ConsumesInfo::instance()->validateConsumedProduct(
+      branchType_, md_, consumes_, pinfo);
     GroupQueryResult qr = principal_.getByLabel(
-      mc_, wrapped, tag.label(), tag.instance(), processTag);
+      mc_, wrapped, tag.label(), tag.instance(), processTag, resolved);
     bool const ok = qr.succeeded() && !qr.failed();
     if (recordParents_ && ok) {
       recordAsParent_(qr.result());
@@ -254,6 +257,7 @@ namespace art {
     ConsumesInfo::instance()->validateConsumedProduct(
       branchType_,
       md_,
+      consumes_,
       ProductInfo{ProductInfo::ConsumableType::Many, wrapped.product_type});
     ProcessTag const processTag{"", md_.processName()};
     auto qrs = principal_.getMany(mc_, wrapped, sel, processTag);
@@ -44,6 +44,7 @@ namespace art {
     class Analyzer;
     class Filter;
     class Producer;
+    struct ModuleConsumes;
   }
 
   class ProductRetriever {
@@ -197,6 +198,9 @@ namespace art {
     // The module we were created for.
     ModuleDescription const& md_;
 
+    // The consumes declarations of that module, if it has any.
+    cet::exempt_ptr<detail::ModuleConsumes> const consumes_;
+
     // If we are constructed as a non-const Event, then we can be used
     // to put products into the Principal, so we need to record
     // retrieved products into retrievedProducts_ to track parentage
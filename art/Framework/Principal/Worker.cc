@@ -9,6 +9,7 @@
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Persistency/Provenance/ModuleContext.h"
 #include "art/Persistency/Provenance/ModuleDescription.h"
+#include "art/Utilities/SharedResource.h"
 #include "art/Utilities/TaskDebugMacros.h"
 #include "art/Utilities/Transition.h"
 #include "canvas/Utilities/Exception.h"
@@ -20,6 +21,7 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <exception>
 #include <memory>
 #include <sstream>
@@ -28,6 +30,7 @@ using namespace hep::concurrency;
 using namespace std;
 
 using mf::LogError;
+using std::chrono::steady_clock;
 
 namespace {
   std::string
@@ -141,6 +144,12 @@ namespace art {
     return doSerialTaskQueueChain();
   }
 
+  detail::SerializationStatistics*
+  Worker::serializationStatistics() const
+  {
+    return doSerializationStatistics();
+  }
+
   // Used by EventProcessor
   // Used by Schedule
   // Used by EndPathExecutor
@@ -617,7 +626,18 @@ namespace art {
       if (auto chain = serialTaskQueueChain()) {
         // Must be a serialized shared module (including legacy).
         TDEBUG_FUNC_SI(4, sid) << "pushing onto chain " << hex << chain << dec;
-        chain->push([&p, &mc, this] { runWorker(p, mc); });
+        actReg_.sModuleQueued.invoke(mc);
+        // The statistics are created along with the chain.
+        auto const stats = serializationStatistics();
+        assert(stats != nullptr);
+        auto const queued = steady_clock::now();
+        stats->enqueued();
+        chain->push([&p, &mc, this, stats, queued] {
+          auto const start = steady_clock::now();
+          stats->started(start - queued);
+          runWorker(p, mc);
+          stats->finished(steady_clock::now() - start);
+        });
         TDEBUG_END_FUNC_SI(4, sid);
         return;
       }
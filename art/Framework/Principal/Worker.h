@@ -42,6 +42,7 @@ namespace art {
   class FileBlock;
   namespace detail {
     class SharedResources;
+    struct SerializationStatistics;
   }
 
   class Worker {
@@ -76,6 +77,7 @@ namespace art {
 
     ModuleDescription const& description() const;
     hep::concurrency::SerialTaskQueueChain* serialTaskQueueChain() const;
+    detail::SerializationStatistics* serializationStatistics() const;
 
     // Used by EventProcessor
     // Used by Schedule
@@ -104,6 +106,8 @@ namespace art {
   private:
     virtual hep::concurrency::SerialTaskQueueChain* doSerialTaskQueueChain()
       const = 0;
+    virtual detail::SerializationStatistics* doSerializationStatistics()
+      const = 0;
     virtual void doBeginJob(detail::SharedResources const& resources) = 0;
     virtual void doEndJob() = 0;
     virtual void doBegin(RunPrincipal& rp, ModuleContext const& mc) = 0;
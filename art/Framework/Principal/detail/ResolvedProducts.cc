@@ -0,0 +1,24 @@
+#include "art/Framework/Principal/detail/ResolvedProducts.h"
+// vim: set sw=2 expandtab :
+
+#include <atomic>
+
+namespace {
+  std::atomic<std::size_t> generation{};
+}
+
+namespace art::detail {
+
+  std::size_t
+  product_tables_generation() noexcept
+  {
+    return generation.load();
+  }
+
+  void
+  advance_product_tables_generation() noexcept
+  {
+    ++generation;
+  }
+
+} // namespace art::detail
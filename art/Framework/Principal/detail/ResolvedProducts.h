@@ -0,0 +1,101 @@
+#ifndef art_Framework_Principal_detail_ResolvedProducts_h
+#define art_Framework_Principal_detail_ResolvedProducts_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// ResolvedProducts
+//
+// The product IDs that matched a consumed, label-based product lookup.
+// The match depends only on the requested type and input tag, the
+// product tables, and the process history, so it can be reused for
+// every principal that shares these.  Whether a produced product is
+// visible on the current trigger path is still checked per lookup.
+//
+// A ResolvedProductsSlot is kept by ConsumesInfo for each consumed
+// product of each module; it may be read and replaced concurrently
+// by the schedules.
+//
+// Since the tables of a new input file may be allocated where those
+// of an earlier one were, a match is also tagged with the generation
+// of the product tables, which is advanced whenever an input file is
+// opened, and which each principal records when it is constructed.
+// ======================================================================
+
+#include "canvas/Persistency/Provenance/ProcessHistoryID.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Persistency/Provenance/fwd.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace art::detail {
+
+  std::size_t product_tables_generation() noexcept;
+  void advance_product_tables_generation() noexcept;
+
+  struct ResolvedProducts {
+    bool
+    validFor(std::size_t const generation,
+             ProductTable const* produced,
+             ProductTable const* present,
+             ProcessHistoryID const& phid) const
+    {
+      return tablesGeneration == generation &&
+             producedProducts == produced && presentProducts == present &&
+             processHistoryID == phid;
+    }
+
+    std::size_t tablesGeneration;
+    ProductTable const* producedProducts;
+    ProductTable const* presentProducts;
+    ProcessHistoryID processHistoryID;
+
+    // In the order in which the lookup would have found them.
+    std::vector<ProductID> produced;
+    std::vector<ProductID> present;
+  };
+
+  class ResolvedProductsSlot {
+  public:
+    std::shared_ptr<ResolvedProducts const>
+    load() const
+    {
+#ifdef __cpp_lib_atomic_shared_ptr
+      return resolved_.load(std::memory_order_acquire);
+#else
+      return std::atomic_load_explicit(&resolved_, std::memory_order_acquire);
+#endif
+    }
+
+    void
+    store(std::shared_ptr<ResolvedProducts const> resolved)
+    {
+#ifdef __cpp_lib_atomic_shared_ptr
+      resolved_.store(std::move(resolved), std::memory_order_release);
+#else
+      std::atomic_store_explicit(
+        &resolved_, std::move(resolved), std::memory_order_release);
+#endif
+    }
+
+  private:
+    // The free atomic functions for shared_ptr are deprecated as of
+    // C++20; they are used only where std::atomic<std::shared_ptr>
+    // is not available.
+#ifdef __cpp_lib_atomic_shared_ptr
+    std::atomic<std::shared_ptr<ResolvedProducts const>> resolved_{};
+#else
+    std::shared_ptr<ResolvedProducts const> resolved_{};
+#endif
+  };
+
+} // namespace art::detail
+
+#endif /* art_Framework_Principal_detail_ResolvedProducts_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -9,10 +9,18 @@
 // external file if the user provides a non-empty file name.
 //
 // Since information that procfs provides is process-specific, the
-// MemoryTracker does not attempt to provide per-module information in
-// the context of multi-threading.  If more than one thread has been
-// enabled for the art process, only the maximum RSS and VSize for the
-// process is reported and the end of the job.
+// MemoryTracker does not attempt to provide per-module procfs
+// information in the context of multi-threading.  If more than one
+// thread has been enabled for the art process, only the maximum RSS
+// and VSize for the process is reported and the end of the job.
+//
+// Per-module memory information is nevertheless available for any
+// number of threads if the AllocationHooks library has been preloaded
+// (see art/Utilities/AllocationHooks.cc).  In that case, the bytes
+// allocated and freed through operator new/delete are counted per
+// thread, and the counts taken on the thread that runs a module are
+// attributed to that module.  They are recorded in the
+// ModuleAllocations and EventAllocations tables.
 // ======================================================================
 
 #ifndef __linux__
@@ -30,6 +38,8 @@
 #include "art/Persistency/Provenance/ModuleContext.h"
 #include "art/Persistency/Provenance/ModuleDescription.h"
 #include "art/Persistency/Provenance/PathContext.h"
+#include "art/Persistency/Provenance/ScheduleContext.h"
+#include "art/Utilities/AllocationCounters.h"
 #include "art/Utilities/Globals.h"
 #include "art/Utilities/LinuxProcData.h"
 #include "art/Utilities/LinuxProcMgr.h"
@@ -44,7 +54,11 @@
 #include "fhiclcpp/types/OptionalAtom.h"
 #include "fhiclcpp/types/Sequence.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
+#include "tbb/enumerable_thread_specific.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <iomanip>
 #include <memory>
 #include <sstream>
@@ -104,6 +118,35 @@ namespace art {
                                                 int,
                                                 int,
                                                 int>;
+    using allocEvent_t = cet::sqlite::
+      Ntuple<uint32_t, uint32_t, uint32_t, double, double, double, double>;
+    using allocModule_t = cet::sqlite::Ntuple<uint32_t,
+                                              uint32_t,
+                                              uint32_t,
+                                              string,
+                                              string,
+                                              string,
+                                              double,
+                                              double,
+                                              double,
+                                              double>;
+
+    // The state of the calling thread's allocation counters when a
+    // module started.
+    struct AllocationMark {
+      ModuleDescription const* md;
+      uint64_t allocated;
+      uint64_t freed;
+      int64_t highWater;
+    };
+
+    // Modules on the same schedule may run concurrently.
+    struct ScheduleAllocations {
+      EventID eventID{EventID::invalidEvent()};
+      atomic<uint64_t> allocated{};
+      atomic<uint64_t> freed{};
+      atomic<int64_t> highWater{};
+    };
 
   public:
     static constexpr bool service_handle_allowed{false};
@@ -132,6 +175,10 @@ namespace art {
     void recordOtherData(ModuleContext const& mc, string const& step);
     void recordEventData(Event const& e, string const& step);
     void recordModuleData(ModuleContext const& mc, string const& step);
+    void startEventAllocations(Event const& e, ScheduleContext sc);
+    void recordEventAllocations(ScheduleContext sc);
+    void startModuleAllocations(ModuleContext const& mc);
+    void recordModuleAllocations(ModuleContext const& mc);
     void postEndJob();
     bool checkMallocConfig_(string const&, bool);
     void recordPeakUsages_();
@@ -143,6 +190,7 @@ namespace art {
     unique_ptr<cet::sqlite::Connection> const db_;
     bool const overwriteContents_;
     bool const includeMallocInfo_;
+    bool const trackAllocations_;
 
     // NB: using "current" semantics for the MemoryTracker is valid
     // since per-module/event information are retrieved only in a
@@ -187,12 +235,33 @@ namespace art {
                                         "hblks",
                                         "uordblks",
                                         "fordblks"}};
+    name_array<7u> eventAllocColumns_{{"Run",
+                                       "SubRun",
+                                       "Event",
+                                       "Allocated",
+                                       "Freed",
+                                       "Live",
+                                       "HighWater"}};
+    name_array<10u> moduleAllocColumns_{{"Run",
+                                         "SubRun",
+                                         "Event",
+                                         "Path",
+                                         "ModuleLabel",
+                                         "ModuleType",
+                                         "Allocated",
+                                         "Freed",
+                                         "Live",
+                                         "HighWater"}};
     peakUsage_t peakUsageTable_;
     otherInfo_t otherInfoTable_;
     memEvent_t eventTable_;
     memModule_t moduleTable_;
     unique_ptr<memEventHeap_t> eventHeapTable_;
     unique_ptr<memModuleHeap_t> moduleHeapTable_;
+    unique_ptr<allocEvent_t> eventAllocTable_;
+    unique_ptr<allocModule_t> moduleAllocTable_;
+    vector<ScheduleAllocations> scheduleAllocations_;
+    tbb::enumerable_thread_specific<vector<AllocationMark>> allocationMarks_{};
   };
 
   MemoryTracker::MemoryTracker(ServiceTable<Config> const& config,
@@ -202,6 +271,7 @@ namespace art {
     , overwriteContents_{config().dbOutput().overwrite()}
     , includeMallocInfo_{checkMallocConfig_(config().dbOutput().filename(),
                                             config().includeMallocInfo())}
+    , trackAllocations_{!fileName_.empty() && allocationTrackingActive()}
     // Fix so that a value of 'false' is an error if filename => in-memory db.
     , peakUsageTable_{*db_, "PeakUsage", peakUsageColumns_, true}
     // always recompute the peak usage
@@ -218,6 +288,21 @@ namespace art {
                                                       "ModuleMallocInfo",
                                                       moduleHeapColumns_) :
                          nullptr}
+    , eventAllocTable_{trackAllocations_ ?
+                         make_unique<allocEvent_t>(*db_,
+                                                   "EventAllocations",
+                                                   eventAllocColumns_,
+                                                   overwriteContents_) :
+                         nullptr}
+    , moduleAllocTable_{trackAllocations_ ?
+                          make_unique<allocModule_t>(*db_,
+                                                     "ModuleAllocations",
+                                                     moduleAllocColumns_,
+                                                     overwriteContents_) :
+                          nullptr}
+    , scheduleAllocations_(trackAllocations_ ?
+                             Globals::instance()->nschedules() :
+                             0)
   {
     iReg.sPostEndJob.watch(this, &MemoryTracker::postEndJob);
     auto const nthreads = Globals::instance()->nthreads();
@@ -225,7 +310,23 @@ namespace art {
       mf::LogWarning("MemoryTracker")
         << "Since " << nthreads
         << " threads have been configured, only process-level\n"
-           "memory usage will be recorded at the end of the job.";
+           "memory usage will be recorded at the end of the job"
+        << (trackAllocations_ ?
+              ",\nalong with the per-module allocations." :
+              ".\nPer-module allocations are recorded if the\n"
+              "AllocationHooks library is preloaded.");
+    }
+
+    if (trackAllocations_) {
+      iReg.sPreProcessEvent.watch(this, &MemoryTracker::startEventAllocations);
+      iReg.sPostProcessEvent.watch([this](auto const&, ScheduleContext sc) {
+        this->recordEventAllocations(sc);
+      });
+      iReg.sPreModule.watch(this, &MemoryTracker::startModuleAllocations);
+      iReg.sPostModule.watch(this, &MemoryTracker::recordModuleAllocations);
+      iReg.sPreWriteEvent.watch(this, &MemoryTracker::startModuleAllocations);
+      iReg.sPostWriteEvent.watch(this,
+                                 &MemoryTracker::recordModuleAllocations);
     }
 
     if (!fileName_.empty() && nthreads == 1u) {
@@ -359,6 +460,98 @@ namespace art {
     }
   }
 
+  void
+  MemoryTracker::startEventAllocations(Event const& e, ScheduleContext const sc)
+  {
+    auto& s = scheduleAllocations_[sc.id().id()];
+    s.eventID = e.id();
+    s.allocated = 0;
+    s.freed = 0;
+    s.highWater = 0;
+  }
+
+  void
+  MemoryTracker::recordEventAllocations(ScheduleContext const sc)
+  {
+    auto const& s = scheduleAllocations_[sc.id().id()];
+    // The high-water mark of an event is that of the module that
+    // reached the largest one; per-thread marks cannot be summed.
+    eventAllocTable_->insert(s.eventID.run(),
+                             s.eventID.subRun(),
+                             s.eventID.event(),
+                             s.allocated / LinuxProcData::MB,
+                             s.freed / LinuxProcData::MB,
+                             (static_cast<double>(s.allocated) -
+                              static_cast<double>(s.freed)) /
+                               LinuxProcData::MB,
+                             s.highWater / LinuxProcData::MB);
+  }
+
+  void
+  MemoryTracker::startModuleAllocations(ModuleContext const& mc)
+  {
+    // The mark is added before the counters are read so that growing
+    // the vector of marks is not charged to the module.
+    auto& marks = allocationMarks_.local();
+    marks.push_back(AllocationMark{&mc.moduleDescription(), 0, 0, 0});
+    auto& counters = threadAllocationCounters();
+    auto& mark = marks.back();
+    mark.allocated = counters.allocated;
+    mark.freed = counters.freed;
+    mark.highWater = counters.highWater;
+    counters.highWater = counters.live();
+  }
+
+  void
+  MemoryTracker::recordModuleAllocations(ModuleContext const& mc)
+  {
+    auto& counters = threadAllocationCounters();
+    auto const allocated = counters.allocated;
+    auto const freed = counters.freed;
+    auto const highWater = counters.highWater;
+
+    // The pre- and post-module signals of a module are emitted on the
+    // same thread.  The marks of modules that threw may still be on
+    // top of the stack.
+    auto& marks = allocationMarks_.local();
+    auto const md = &mc.moduleDescription();
+    auto const it = find_if(marks.rbegin(), marks.rend(), [md](auto const& m) {
+      return m.md == md;
+    });
+    if (it == marks.rend()) {
+      return;
+    }
+    auto const mark = *it;
+    marks.erase(prev(it.base()), marks.end());
+    counters.highWater = max(mark.highWater, highWater);
+
+    auto const moduleAllocated = allocated - mark.allocated;
+    auto const moduleFreed = freed - mark.freed;
+    auto const moduleHighWater =
+      highWater - static_cast<int64_t>(mark.allocated - mark.freed);
+
+    auto& s = scheduleAllocations_[mc.scheduleID().id()];
+    s.allocated += moduleAllocated;
+    s.freed += moduleFreed;
+    auto current = s.highWater.load();
+    while (current < moduleHighWater &&
+           !s.highWater.compare_exchange_weak(current, moduleHighWater)) {
+    }
+    moduleAllocTable_->insert(
+      s.eventID.run(),
+      s.eventID.subRun(),
+      s.eventID.event(),
+      mc.pathName(),
+      mc.moduleLabel(),
+      mc.moduleName(),
+      moduleAllocated / LinuxProcData::MB,
+      moduleFreed / LinuxProcData::MB,
+      (static_cast<double>(moduleAllocated) -
+       static_cast<double>(moduleFreed)) /
+        LinuxProcData::MB,
+      moduleHighWater / LinuxProcData::MB);
+  }
+
   void
   MemoryTracker::postEndJob()
   {
@@ -407,6 +600,12 @@ namespace art {
     if (moduleHeapTable_) {
       moduleHeapTable_->flush();
     }
+    if (eventAllocTable_) {
+      eventAllocTable_->flush();
+    }
+    if (moduleAllocTable_) {
+      moduleAllocTable_->flush();
+    }
   }
 
   void
@@ -433,6 +632,10 @@ namespace art {
     if (!(fileName_.empty() || fileName_ == ":memory:")) {
       log << "  Details saved in: '" << fileName_ << "'\n";
     }
+    if (trackAllocations_) {
+      log << "  Per-module allocations saved in the ModuleAllocations and\n"
+             "  EventAllocations tables\n";
+    }
     log << rule('=');
   }
 
@@ -0,0 +1,218 @@
+#include "art/Framework/Services/Optional/Philox4x32Engine.h"
+// vim: set sw=2 expandtab :
+
+#include "CLHEP/Random/engineIDulong.h"
+#include "canvas/Persistency/Provenance/EventID.h"
+
+#include <fstream>
+#include <iostream>
+
+namespace {
+  constexpr std::size_t state_size{8}; // ID, key, counter, used
+  constexpr double two_to_minus_24{1. / 16777216.};
+  constexpr double two_to_minus_53{1. / 9007199254740992.};
+} // namespace
+
+namespace art {
+
+  Philox4x32Engine::Philox4x32Engine(long const seed,
+                                     std::string const& module_label,
+                                     std::string const& engine_label)
+    : moduleLabel_{module_label}
+    , engineLabel_{engine_label}
+    , key_{detail::philox_key_for(seed, module_label, engine_label)}
+  {
+    theSeed = seed;
+  }
+
+  void
+  Philox4x32Engine::setEvent(EventID const& id)
+  {
+    counter_ = {0, id.event(), id.subRun(), id.run()};
+    used_ = 4;
+  }
+
+  std::uint32_t
+  Philox4x32Engine::next_()
+  {
+    if (used_ == 4) {
+      block_ = detail::philox4x32(counter_, key_);
+      ++counter_[0];
+      used_ = 0;
+    }
+    return block_[used_++];
+  }
+
+  // 53 random bits, offset so that neither 0 nor 1 is returned.
+  double
+  Philox4x32Engine::flat()
+  {
+    auto const high = next_() >> 5;
+    auto const low = next_() >> 6;
+    return (high * 67108864. + low + 0.5) * two_to_minus_53;
+  }
+
+  void
+  Philox4x32Engine::flatArray(int const size, double* vect)
+  {
+    for (int i{}; i != size; ++i) {
+      vect[i] = flat();
+    }
+  }
+
+  void
+  Philox4x32Engine::setSeed(long const seed, int)
+  {
+    theSeed = seed;
+    key_ = detail::philox_key_for(seed, moduleLabel_, engineLabel_);
+    counter_ = {};
+    used_ = 4;
+  }
+
+  void
+  Philox4x32Engine::setSeeds(long const* seeds, int)
+  {
+    if (seeds != nullptr && *seeds != 0) {
+      setSeed(*seeds);
+    }
+  }
+
+  void
+  Philox4x32Engine::saveStatus(char const filename[]) const
+  {
+    std::ofstream os{filename};
+    put(os);
+  }
+
+  void
+  Philox4x32Engine::restoreStatus(char const filename[])
+  {
+    std::ifstream is{filename};
+    if (!is) {
+      std::cerr << "  -- Engine state remains unchanged\n";
+      return;
+    }
+    get(is);
+  }
+
+  void
+  Philox4x32Engine::showStatus() const
+  {
+    std::cout << "--------- Philox4x32 engine status ---------\n"
+              << " Initial seed = " << theSeed << '\n'
+              << " Key = " << key_[0] << ' ' << key_[1] << '\n'
+              << " Counter = " << counter_[0] << ' ' << counter_[1] << ' '
+              << counter_[2] << ' ' << counter_[3] << '\n'
+              << "--------------------------------------------\n";
+  }
+
+  std::string
+  Philox4x32Engine::name() const
+  {
+    return engineName();
+  }
+
+  std::string
+  Philox4x32Engine::engineName()
+  {
+    return "Philox4x32";
+  }
+
+  std::ostream&
+  Philox4x32Engine::put(std::ostream& os) const
+  {
+    os << engineName() << "-begin\n";
+    for (auto const value : put()) {
+      os << value << '\n';
+    }
+    return os << engineName() << "-end\n";
+  }
+
+  std::istream&
+  Philox4x32Engine::get(std::istream& is)
+  {
+    std::string tag;
+    is >> tag;
+    if (tag != engineName() + "-begin") {
+      is.clear(std::ios::badbit | is.rdstate());
+      std::cerr << "No " << engineName() << " engine state found.\n";
+      return is;
+    }
+    return getState(is);
+  }
+
+  std::istream&
+  Philox4x32Engine::getState(std::istream& is)
+  {
+    std::vector<unsigned long> v(state_size);
+    for (auto& value : v) {
+      is >> value;
+    }
+    std::string tag;
+    is >> tag;
+    if (!is || tag != engineName() + "-end" || !get(v)) {
+      is.clear(std::ios::badbit | is.rdstate());
+      std::cerr << "Invalid " << engineName() << " engine state.\n";
+    }
+    return is;
+  }
+
+  std::vector<unsigned long>
+  Philox4x32Engine::put() const
+  {
+    return {CLHEP::engineIDulong<Philox4x32Engine>(),
+            key_[0],
+            key_[1],
+            counter_[0],
+            counter_[1],
+            counter_[2],
+            counter_[3],
+            used_};
+  }
+
+  bool
+  Philox4x32Engine::get(std::vector<unsigned long> const& v)
+  {
+    if (v.empty() || v[0] != CLHEP::engineIDulong<Philox4x32Engine>()) {
+      return false;
+    }
+    return getState(v);
+  }
+
+  bool
+  Philox4x32Engine::getState(std::vector<unsigned long> const& v)
+  {
+    if (v.size() != state_size || v[7] > 4 || (v[7] < 4 && v[3] == 0)) {
+      return false;
+    }
+    key_ = {static_cast<std::uint32_t>(v[1]), static_cast<std::uint32_t>(v[2])};
+    counter_ = {static_cast<std::uint32_t>(v[3]),
+                static_cast<std::uint32_t>(v[4]),
+                static_cast<std::uint32_t>(v[5]),
+                static_cast<std::uint32_t>(v[6])};
+    used_ = v[7];
+    if (used_ < 4) {
+      // Recompute the block being returned.
+      auto counter = counter_;
+      --counter[0];
+      block_ = detail::philox4x32(counter, key_);
+    }
+    return true;
+  }
+
+  Philox4x32Engine::operator double()
+  {
+    return flat();
+  }
+
+  Philox4x32Engine::operator float()
+  {
+    return ((next_() >> 8) + 0.5) * two_to_minus_24;
+  }
+
+  Philox4x32Engine::operator unsigned int()
+  {
+    return next_();
+  }
+
+} // namespace art
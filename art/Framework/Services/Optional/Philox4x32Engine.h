@@ -0,0 +1,82 @@
+#ifndef art_Framework_Services_Optional_Philox4x32Engine_h
+#define art_Framework_Services_Optional_Philox4x32Engine_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// Philox4x32Engine
+//
+// A counter-based random number engine (Philox-4x32-10).  Its key is
+// derived from the seed and from the module and engine labels, and
+// its counter from the ID of the event being processed: at the start
+// of each event, the RandomNumberGenerator service restarts the
+// engine at the beginning of the stream of that event.  The numbers
+// drawn while processing an event therefore depend only on the seed,
+// the labels, and the event ID---not on the schedule that processes
+// the event or on the events processed before---so no engine state
+// need be saved with the event in order to reproduce them.
+//
+// Numbers drawn outside of event processing continue the stream of
+// the last event (or, before the first event, a stream of its own).
+// ======================================================================
+
+#include "CLHEP/Random/RandomEngine.h"
+#include "art/Framework/Services/Optional/detail/philox.h"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace art {
+
+  class EventID;
+
+  class Philox4x32Engine : public CLHEP::HepRandomEngine {
+  public:
+    Philox4x32Engine(long seed,
+                     std::string const& module_label,
+                     std::string const& engine_label);
+
+    // Restarts the engine at the beginning of the stream of the event.
+    void setEvent(EventID const& id);
+
+    double flat() override;
+    void flatArray(int size, double* vect) override;
+    void setSeed(long seed, int = 0) override;
+    void setSeeds(long const* seeds, int = 0) override;
+    void saveStatus(char const filename[] = "Philox4x32.conf") const override;
+    void restoreStatus(char const filename[] = "Philox4x32.conf") override;
+    void showStatus() const override;
+    std::string name() const override;
+
+    std::ostream& put(std::ostream& os) const override;
+    std::istream& get(std::istream& is) override;
+    std::istream& getState(std::istream& is) override;
+    std::vector<unsigned long> put() const override;
+    bool get(std::vector<unsigned long> const& v) override;
+    bool getState(std::vector<unsigned long> const& v) override;
+
+    operator double() override;
+    operator float() override;
+    operator unsigned int() override;
+
+    static std::string engineName();
+
+  private:
+    std::uint32_t next_();
+
+    std::string const moduleLabel_;
+    std::string const engineLabel_;
+    detail::philox_key key_;
+    // counter_[0] is the index of the next block of the stream.
+    detail::philox_counter counter_{};
+    detail::philox_counter block_{};
+    unsigned used_{4}; // Words of block_ already returned.
+  };
+
+} // namespace art
+
+#endif /* art_Framework_Services_Optional_Philox4x32Engine_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,367 @@
+// vim: set sw=2 expandtab :
+// ======================================================================
+// ProcessSampler
+//
+// Samples the memory and CPU usage of the process from a background
+// thread at a fixed interval, independently of the rate at which
+// events are processed.  Each sample records the VSize and RSS of the
+// process (read from procfs), its accumulated user and system CPU
+// time, and, optionally, the mallinfo heap statistics.
+//
+// The framework callbacks do not read procfs; they only stamp, for
+// each schedule, the event being processed and the modules running on
+// it.  Each sample records these stamps, one row per running module,
+// so that the memory timeline can be correlated with the work being
+// done.
+//
+// This service is supported only for Linux systems.
+// ======================================================================
+
+#ifndef __linux__
+#error "This source file can be built only for Linux platforms."
+#endif
+
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Optional/detail/LinuxMallInfo.h"
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceDeclarationMacros.h"
+#include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "art/Framework/Services/Registry/ServiceTable.h"
+#include "art/Framework/Services/System/DatabaseConnection.h"
+#include "art/Persistency/Provenance/ModuleContext.h"
+#include "art/Persistency/Provenance/ScheduleContext.h"
+#include "art/Utilities/Globals.h"
+#include "art/Utilities/LinuxProcData.h"
+#include "art/Utilities/LinuxProcMgr.h"
+#include "art/Utilities/detail/PeriodicThread.h"
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Utilities/Exception.h"
+#include "cetlib/HorizontalRule.h"
+#include "cetlib/sqlite/Connection.h"
+#include "cetlib/sqlite/Ntuple.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Comment.h"
+#include "fhiclcpp/types/Name.h"
+#include "fhiclcpp/types/Table.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "tbb/concurrent_unordered_map.h"
+#include "tbb/concurrent_vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace cet;
+
+using art::detail::LinuxMallInfo;
+using std::chrono::steady_clock;
+using vsize_t = art::LinuxProcData::vsize_t;
+using rss_t = art::LinuxProcData::rss_t;
+
+namespace art {
+
+  class ProcessSampler {
+    template <unsigned N>
+    using name_array = cet::sqlite::name_array<N>;
+    using sample_t =
+      cet::sqlite::Ntuple<double, double, double, double, double, uint32_t>;
+    using scheduleSample_t = cet::sqlite::
+      Ntuple<double, uint32_t, uint32_t, uint32_t, uint32_t, string>;
+    using heapSample_t =
+      cet::sqlite::Ntuple<double, int, int, int, int, int, int>;
+
+    // What a schedule is working on.  Several modules of one
+    // schedule may run at the same time (independent modules of a
+    // path, and the writes of different output modules), so each
+    // running module is recorded, as an index into moduleLabels_.
+    // The stamp is written by the schedule's tasks and read by the
+    // sampler, hence the (rarely contended) mutex.
+    struct ScheduleStamp {
+      mutex stampMutex{};
+      EventID eventID{EventID::invalidEvent()};
+      vector<uint32_t> modules{};
+    };
+
+  public:
+    static constexpr bool service_handle_allowed{false};
+
+    struct Config {
+      template <typename T>
+      using Atom = fhicl::Atom<T>;
+      using Name = fhicl::Name;
+      using Comment = fhicl::Comment;
+      template <typename T>
+      using Table = fhicl::Table<T>;
+      struct DBoutput {
+        Atom<string> filename{Name{"filename"}, ""};
+        Atom<bool> overwrite{Name{"overwrite"}, false};
+      };
+      Table<DBoutput> dbOutput{Name{"dbOutput"}};
+      Atom<double> interval{
+        Name{"interval"},
+        Comment{"The time between two samples, in seconds."},
+        0.5};
+      Atom<bool> includeMallocInfo{
+        Name{"includeMallocInfo"},
+        Comment{"If true, the mallinfo heap statistics are sampled too."},
+        false};
+      Atom<bool> printSummary{Name{"printSummary"}, true};
+    };
+
+    using Parameters = ServiceTable<Config>;
+    ProcessSampler(Parameters const&, ActivityRegistry&);
+
+  private:
+    void stampEvent(Event const& e, ScheduleContext sc);
+    void clearEvent(ScheduleContext sc);
+    void stampModule(ModuleContext const& mc);
+    void clearModule(ModuleContext const& mc);
+    uint32_t moduleIndex_(string const& label);
+    void postEndJob();
+    void takeSample_();
+    double secondsSinceStart_() const;
+
+    LinuxProcMgr procInfo_{};
+    string const fileName_;
+    unique_ptr<cet::sqlite::Connection> const db_;
+    bool const overwriteContents_;
+    steady_clock::duration const interval_;
+    bool const includeMallocInfo_;
+    bool const printSummary_;
+    steady_clock::time_point const start_{steady_clock::now()};
+    LinuxProcMgr::CpuTimes const startCpu_{procInfo_.getCpuTimes()};
+
+    name_array<6u> sampleColumns_{
+      {"Time", "Vsize", "RSS", "UserCPU", "SystemCPU", "Events"}};
+    name_array<6u> scheduleSampleColumns_{
+      {"Time", "Schedule", "Run", "SubRun", "Event", "ModuleLabel"}};
+    name_array<7u> heapSampleColumns_{{"Time",
+                                       "arena",
+                                       "hblkhd",
+                                       "uordblks",
+                                       "fordblks",
+                                       "keepcost",
+                                       "ordblks"}};
+    sample_t sampleTable_;
+    scheduleSample_t scheduleSampleTable_;
+    unique_ptr<heapSample_t> heapSampleTable_;
+
+    vector<ScheduleStamp> schedules_;
+    tbb::concurrent_unordered_map<string, uint32_t> moduleIndices_{};
+    tbb::concurrent_vector<string> moduleLabels_{};
+    mutex moduleLabelsMutex_{};
+    atomic<uint32_t> eventsProcessed_{};
+
+    // Summary information; touched only by the sampling thread.
+    unsigned nSamples_{};
+    double peakRSS_{};
+    double peakVsize_{};
+
+    // Declared last, so that it is stopped before the members it uses
+    // are destroyed.
+    unique_ptr<detail::PeriodicThread> sampler_{nullptr};
+  };
+
+  ProcessSampler::ProcessSampler(Parameters const& config,
+                                 ActivityRegistry& iReg)
+    : fileName_{config().dbOutput().filename()}
+    , db_{ServiceHandle<DatabaseConnection>{}->get(fileName_)}
+    , overwriteContents_{config().dbOutput().overwrite()}
+    , interval_{chrono::duration_cast<steady_clock::duration>(
+        chrono::duration<double>{config().interval()})}
+    , includeMallocInfo_{config().includeMallocInfo()}
+    , printSummary_{config().printSummary()}
+    , sampleTable_{*db_, "ProcessSamples", sampleColumns_, overwriteContents_}
+    , scheduleSampleTable_{*db_,
+                           "ScheduleSamples",
+                           scheduleSampleColumns_,
+                           overwriteContents_}
+    , heapSampleTable_{includeMallocInfo_ ?
+                         make_unique<heapSample_t>(*db_,
+                                                   "HeapSamples",
+                                                   heapSampleColumns_,
+                                                   overwriteContents_) :
+                         nullptr}
+    , schedules_(Globals::instance()->nschedules())
+  {
+    if (interval_ <= steady_clock::duration::zero()) {
+      throw Exception{errors::Configuration}
+        << "The ProcessSampler interval must be positive; it is "
+        << config().interval() << " s.\n";
+    }
+    iReg.sPreProcessEvent.watch(this, &ProcessSampler::stampEvent);
+    iReg.sPostProcessEvent.watch(
+      [this](auto const&, ScheduleContext const sc) { this->clearEvent(sc); });
+    iReg.sPreModule.watch(this, &ProcessSampler::stampModule);
+    iReg.sPostModule.watch(this, &ProcessSampler::clearModule);
+    iReg.sPreWriteEvent.watch(this, &ProcessSampler::stampModule);
+    iReg.sPostWriteEvent.watch(this, &ProcessSampler::clearModule);
+    iReg.sPostEndJob.watch(this, &ProcessSampler::postEndJob);
+    sampler_ =
+      make_unique<detail::PeriodicThread>(interval_, [this] { takeSample_(); });
+  }
+
+  void
+  ProcessSampler::stampEvent(Event const& e, ScheduleContext const sc)
+  {
+    auto& stamp = schedules_[sc.id().id()];
+    lock_guard sentry{stamp.stampMutex};
+    stamp.eventID = e.id();
+  }
+
+  void
+  ProcessSampler::clearEvent(ScheduleContext const sc)
+  {
+    ++eventsProcessed_;
+    auto& stamp = schedules_[sc.id().id()];
+    lock_guard sentry{stamp.stampMutex};
+    stamp.eventID = EventID::invalidEvent();
+  }
+
+  uint32_t
+  ProcessSampler::moduleIndex_(string const& label)
+  {
+    if (auto it = moduleIndices_.find(label); it != moduleIndices_.end()) {
+      return it->second;
+    }
+    // Only the first call for a given module label gets here.
+    lock_guard sentry{moduleLabelsMutex_};
+    auto const [pos, inserted] = moduleIndices_.emplace(
+      label, static_cast<uint32_t>(moduleLabels_.size()));
+    if (inserted) {
+      moduleLabels_.push_back(label);
+    }
+    return pos->second;
+  }
+
+  void
+  ProcessSampler::stampModule(ModuleContext const& mc)
+  {
+    auto const index = moduleIndex_(mc.moduleLabel());
+    auto& stamp = schedules_[mc.scheduleID().id()];
+    lock_guard sentry{stamp.stampMutex};
+    stamp.modules.push_back(index);
+  }
+
+  void
+  ProcessSampler::clearModule(ModuleContext const& mc)
+  {
+    auto const index = moduleIndex_(mc.moduleLabel());
+    auto& stamp = schedules_[mc.scheduleID().id()];
+    lock_guard sentry{stamp.stampMutex};
+    auto& modules = stamp.modules;
+    if (auto it = find(modules.begin(), modules.end(), index);
+        it != modules.end()) {
+      modules.erase(it);
+    }
+  }
+
+  double
+  ProcessSampler::secondsSinceStart_() const
+  {
+    return chrono::duration<double>{steady_clock::now() - start_}.count();
+  }
+
+  void
+  ProcessSampler::takeSample_()
+  {
+    auto const t = secondsSinceStart_();
+    auto const data = procInfo_.getCurrentData();
+    auto const cpu = procInfo_.getCpuTimes();
+    auto const vsize = LinuxProcData::getValueInMB<vsize_t>(data);
+    auto const rss = LinuxProcData::getValueInMB<rss_t>(data);
+    sampleTable_.insert(t,
+                        vsize,
+                        rss,
+                        cpu.user - startCpu_.user,
+                        cpu.system - startCpu_.system,
+                        eventsProcessed_.load());
+    ++nSamples_;
+    peakVsize_ = max(peakVsize_, vsize);
+    peakRSS_ = max(peakRSS_, rss);
+
+    vector<uint32_t> modules;
+    for (size_t sid{}; sid != schedules_.size(); ++sid) {
+      auto& stamp = schedules_[sid];
+      EventID eventID;
+      {
+        lock_guard sentry{stamp.stampMutex};
+        eventID = stamp.eventID;
+        modules = stamp.modules;
+      }
+      auto insert = [this, t, sid, &eventID](string const& label) {
+        scheduleSampleTable_.insert(t,
+                                    static_cast<uint32_t>(sid),
+                                    eventID.run(),
+                                    eventID.subRun(),
+                                    eventID.event(),
+                                    label);
+      };
+      if (modules.empty()) {
+        if (eventID.isValid()) {
+          insert(""s);
+        }
+        continue;
+      }
+      for (auto const module : modules) {
+        insert(moduleLabels_[module]);
+      }
+    }
+
+    if (heapSampleTable_) {
+      auto const minfo = LinuxMallInfo{}.get();
+      heapSampleTable_->insert(t,
+                               minfo.arena,
+                               minfo.hblkhd,
+                               minfo.uordblks,
+                               minfo.fordblks,
+                               minfo.keepcost,
+                               minfo.ordblks);
+    }
+  }
+
+  void
+  ProcessSampler::postEndJob()
+  {
+    sampler_->stopAndRethrow();
+    // One last sample, so that the timeline covers the whole job.
+    takeSample_();
+    sampleTable_.flush();
+    scheduleSampleTable_.flush();
+    if (heapSampleTable_) {
+      heapSampleTable_->flush();
+    }
+    if (!printSummary_) {
+      return;
+    }
+
+    auto const wall = secondsSinceStart_();
+    auto const cpu = procInfo_.getCpuTimes();
+    auto const cpuUsed =
+      (cpu.user - startCpu_.user) + (cpu.system - startCpu_.system);
+    mf::LogAbsolute log{"ProcessSampler"};
+    HorizontalRule const rule{100};
+    log << '\n' << rule('=') << '\n';
+    log << std::left << "ProcessSampler summary (base-10 MB units used)\n\n";
+    log << "  Samples taken                  : " << nSamples_ << '\n'
+        << "  Largest sampled VSize          : " << peakVsize_ << " MB\n"
+        << "  Largest sampled RSS            : " << peakRSS_ << " MB\n"
+        << "  Mean CPU utilization (threads) : "
+        << (wall > 0. ? cpuUsed / wall : 0.) << '\n';
+    if (!(fileName_.empty() || fileName_ == ":memory:")) {
+      log << "  Timeline saved in: '" << fileName_ << "'\n";
+    }
+    log << rule('=');
+  }
+
+} // namespace art
+
+DECLARE_ART_SERVICE(art::ProcessSampler, SHARED)
+DEFINE_ART_SERVICE(art::ProcessSampler)
@@ -21,6 +21,7 @@
 #include "CLHEP/Random/RanshiEngine.h"
 #include "CLHEP/Random/TripleRand.h"
 #include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Optional/Philox4x32Engine.h"
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Persistency/Provenance/ScheduleContext.h"
 #include "art/Utilities/Globals.h"
@@ -80,8 +81,17 @@ namespace art {
     }
 
     shared_ptr<CLHEP::HepRandomEngine>
-    engine_factory(string const& kind_of_engine_to_make, long const seed)
+    engine_factory(string const& kind_of_engine_to_make,
+                   long const seed,
+                   string const& module_label,
+                   string const& engine_label)
     {
+      if (kind_of_engine_to_make == Philox4x32Engine::engineName()) {
+        return make_shared<Philox4x32Engine>(
+          seed == RandomNumberGenerator::useDefaultSeed ? 0 : seed,
+          module_label,
+          engine_label);
+      }
 #define MANUFACTURE(ENGINE)                                                    \
   if (kind_of_engine_to_make == string{#ENGINE}) {                             \
     return manufacture_an_engine<CLHEP::ENGINE>(seed);                         \
@@ -165,7 +175,8 @@ namespace art {
 
     shared_ptr<CLHEP::HepRandomEngine> eptr;
     if (engineKind == "G4Engine"s) {
-      eptr = engine_factory(defaultEngineKind_, seed);
+      eptr =
+        engine_factory(defaultEngineKind_, seed, module_label, engine_label);
       // We set CLHEP's random-number engine to be of type
       // defaultEngineKind_.
       CLHEP::HepRandom::setTheEngine(eptr.get());
@@ -175,7 +186,7 @@ namespace art {
     } else if (engineKind == "NonRandomEngine"s) {
       eptr = std::make_shared<CLHEP::NonRandomEngine>();
     } else {
-      eptr = engine_factory(engineKind, seed);
+      eptr = engine_factory(engineKind, seed, module_label, engine_label);
     }
     if (!eptr) {
       throw cet::exception("RANDOM")
@@ -185,6 +196,9 @@ namespace art {
     data_[sid].dict_[label] = eptr;
     data_[sid].tracker_[label] = EngineSource::Seed;
     data_[sid].kind_[label] = engineKind;
+    if (auto keyed = dynamic_pointer_cast<Philox4x32Engine>(eptr)) {
+      data_[sid].eventKeyed_[label] = keyed;
+    }
     mf::LogInfo{"RANDOM"} << "Instantiated " << engineKind << " engine \""
                           << label << "\" with "
                           << ((seed == useDefaultSeed) ? "default seed " :
@@ -224,6 +238,12 @@ namespace art {
         defaultEngineKind_ == "MixMaxRng"s)
       return;
 
+    // Counter-based engines take any seed.
+    if (user_specified_engine_kind == Philox4x32Engine::engineName() ||
+        (user_specified_engine_kind == "G4Engine"s &&
+         defaultEngineKind_ == Philox4x32Engine::engineName()))
+      return;
+
     throw cet::exception("RANGE")
       << "RNGservice::throw_if_invalid_seed():\n"
       << "Seed " << user_specified_seed << " exceeds permitted maximum of "
@@ -270,6 +290,10 @@ namespace art {
     data_[sid].snapshot_.clear();
     for (auto const& [label, eptr] : data_[sid].dict_) {
       assert(eptr && "RNGservice::takeSnapshot_()");
+      if (data_[sid].eventKeyed_.count(label)) {
+        // The state follows from the event ID.
+        continue;
+      }
       data_[sid].snapshot_.emplace_back(
         data_[sid].kind_[label], label, eptr->put());
       log << " | " << label;
@@ -428,6 +452,9 @@ namespace art {
     std::lock_guard sentry{mutex_};
     takeSnapshot_(sid);
     restoreSnapshot_(sid, e);
+    for (auto const& keyed : data_[sid].eventKeyed_) {
+      keyed.second->setEvent(e.id());
+    }
   }
 
   void
@@ -111,6 +111,23 @@
 //     configured replicated module is guaranteed to have a different
 //     seeds wrt. each other.
 //
+// Event-keyed engines
+// -------------------
+//
+// The output of the stateful CLHEP engines depends on which events
+// were processed before, and by which schedule; reproducing it
+// requires saving the engine states with each event (see the
+// RandomNumberSaver module).  An engine of kind "Philox4x32" is
+// instead a counter-based engine (see Philox4x32Engine.h), keyed by
+// the seed and by the module and engine labels, that this service
+// restarts at the start of each event from the event ID.  The same
+// event thus sees the same random numbers for any number of
+// schedules and any processing order, and the states of such engines
+// are not included in the snapshots saved by RandomNumberSaver.  Any
+// non-negative seed may be used; the default seed is 0.
+//
+//   createEngine(seed, "Philox4x32");
+//
 // Configuring the Service
 // -----------------------
 //
@@ -149,6 +166,7 @@ namespace art {
 
   class ActivityRegistry;
   class Event;
+  class Philox4x32Engine;
   class ScheduleContext;
 
   namespace detail {
@@ -190,7 +208,9 @@ namespace art {
           "  'Ranlux64Engine'\n"
           "  'RanluxEngine'\n"
           "  'RanshiEngine'\n"
-          "  'TripleRand'\n"},
+          "  'TripleRand'\n"
+          "  'Philox4x32'   (counter-based, restarted from the event ID\n"
+          "                  for each event)\n"},
         "HepJamesRandom"};
       Atom<std::string> restoreStateLabel{
         Name{"restoreStateLabel"},
@@ -317,6 +337,10 @@ namespace art {
 
       // The random engine number state snapshots taken for this stream.
       std::vector<RNGsnapshot> snapshot_{};
+
+      // The event-keyed engines, which are restarted for each event
+      // and not included in the snapshots. Indexed by engine label.
+      std::map<std::string, std::shared_ptr<Philox4x32Engine>> eventKeyed_{};
     };
     PerScheduleContainer<ScheduleData> data_;
   };
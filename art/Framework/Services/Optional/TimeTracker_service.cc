@@ -11,6 +11,10 @@
 #include "art/Persistency/Provenance/ModuleDescription.h"
 #include "art/Persistency/Provenance/ScheduleContext.h"
 #include "art/Utilities/ScheduleID.h"
+#include "art/Utilities/detail/PeriodicThread.h"
+#include "art/Utilities/detail/SPSCRingBuffer.h"
+#include "art/Utilities/detail/SpanStarts.h"
+#include "art/Utilities/detail/ThreadRings.h"
 #include "boost/format.hpp"
 #include "canvas/Persistency/Provenance/EventID.h"
 #include "canvas/Persistency/Provenance/fwd.h"
@@ -20,18 +24,25 @@
 #include "cetlib/sqlite/helpers.h"
 #include "cetlib/sqlite/statistics.h"
 #include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Comment.h"
 #include "fhiclcpp/types/Name.h"
 #include "fhiclcpp/types/Table.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include "tbb/concurrent_unordered_map.h"
+#include "tbb/concurrent_vector.h"
 
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cstdint>
 #include <iomanip>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 using namespace std;
@@ -69,6 +80,22 @@ namespace art {
 
     auto now = bind(&steady_clock::now);
 
+    // The fixed-size record that is written to a thread's ring buffer
+    // when the ring-buffer backend is enabled.  For module records,
+    // 'module' is the index of the module in the TimeTracker's table
+    // of module identities.
+    struct TimeRecord {
+      enum class Kind : uint32_t { source, event, module };
+      Kind kind;
+      uint32_t module;
+      uint32_t schedule;
+      uint32_t run;
+      uint32_t subRun;
+      uint32_t event;
+      steady_clock::rep start;
+      steady_clock::rep stop;
+    };
+
     struct Statistics {
       explicit Statistics() = default;
 
@@ -132,6 +159,20 @@ namespace art {
         fhicl::Atom<bool> overwrite{fhicl::Name{"overwrite"}, false};
       };
       fhicl::Table<DBoutput> dbOutput{fhicl::Name{"dbOutput"}};
+      fhicl::Atom<bool> useRingBuffers{
+        fhicl::Name{"useRingBuffers"},
+        fhicl::Comment{
+          "If true, each thread writes its timing records to its own\n"
+          "lock-free ring buffer, which a background thread drains into\n"
+          "the database.  This keeps the database insertions and their\n"
+          "locking out of the event loop."},
+        false};
+      fhicl::Atom<unsigned> ringBufferSize{
+        fhicl::Name{"ringBufferSize"},
+        fhicl::Comment{
+          "The number of records each ring buffer can hold.  A record\n"
+          "that does not fit is inserted into the database directly."},
+        4096u};
     };
     using Parameters = ServiceTable<Config>;
     explicit TimeTracker(Parameters const&, ActivityRegistry&);
@@ -142,6 +183,19 @@ namespace art {
       steady_clock::time_point eventStart;
       steady_clock::time_point moduleStart;
     };
+    struct ModuleIdentity {
+      string path;
+      string label;
+      string type;
+    };
+    // Everything one thread needs to record module times without
+    // locking or allocating once it has seen each of its modules.
+    struct PerThreadData {
+      explicit PerThreadData(size_t const ringSize) : ring{ringSize} {}
+      detail::SPSCRingBuffer<TimeRecord> ring;
+      detail::SpanStarts<steady_clock::time_point> moduleStarts{};
+      unordered_map<ModuleDescription const*, uint32_t> moduleIndices{};
+    };
     template <unsigned SIZE>
     using name_array = cet::sqlite::name_array<SIZE>;
     using timeSource_t =
@@ -161,6 +215,13 @@ namespace art {
     void recordTime(ModuleContext const& mc, string const& suffix);
     void logToDestination_(Statistics const& evt,
                            vector<Statistics> const& modules);
+    PerThreadData& localThreadData_();
+    uint32_t moduleIndex_(PerThreadData& td,
+                          ModuleContext const& mc,
+                          string const& suffix);
+    void pushRecord_(TimeRecord const& r);
+    void insertRecord_(TimeRecord const& r);
+    void drainRingBuffers_();
 
     tbb::concurrent_unordered_map<ConcurrentKey,
                                   PerScheduleData,
@@ -176,6 +237,17 @@ namespace art {
     timeSource_t timeSourceTable_;
     timeEvent_t timeEventTable_;
     timeModule_t timeModuleTable_;
+
+    // Ring-buffer backend
+    bool const useRingBuffers_;
+    size_t const ringBufferSize_;
+    detail::ThreadRings<PerThreadData> threadData_{};
+    mutex modulesMutex_{};
+    map<tuple<string, string, string>, uint32_t> moduleIndices_{};
+    tbb::concurrent_vector<ModuleIdentity> modules_{};
+    // Declared last, so that it is stopped before the members it uses
+    // are destroyed.
+    unique_ptr<detail::PeriodicThread> drainer_{nullptr};
   };
 
   TimeTracker::TimeTracker(Parameters const& config, ActivityRegistry& areg)
@@ -204,6 +276,8 @@ namespace art {
                        "TimeModule",
                        timeModuleColumnNames_,
                        overwriteContents_}
+    , useRingBuffers_{config().useRingBuffers()}
+    , ringBufferSize_{config().ringBufferSize()}
   {
     areg.sPostSourceConstruction.watch(this,
                                        &TimeTracker::postSourceConstruction);
@@ -221,11 +295,19 @@ namespace art {
     areg.sPreWriteEvent.watch(this, &TimeTracker::startTime);
     areg.sPostWriteEvent.watch(
       [this](auto const& mc) { this->recordTime(mc, "(write)"s); });
+    if (useRingBuffers_) {
+      drainer_ = make_unique<detail::PeriodicThread>(
+        100ms, [this] { drainRingBuffers_(); });
+    }
   }
 
   void
   TimeTracker::postEndJob()
   {
+    if (useRingBuffers_) {
+      drainer_->stopAndRethrow();
+      drainRingBuffers_();
+    }
     timeSourceTable_.flush();
     timeEventTable_.flush();
     timeModuleTable_.flush();
@@ -311,6 +393,17 @@ namespace art {
   {
     auto& d = data_[key(sc.id())];
     d.eventID = e.id();
+    if (useRingBuffers_) {
+      pushRecord_(TimeRecord{TimeRecord::Kind::source,
+                             0u,
+                             static_cast<uint32_t>(sc.id().id()),
+                             d.eventID.run(),
+                             d.eventID.subRun(),
+                             d.eventID.event(),
+                             d.eventStart.time_since_epoch().count(),
+                             now().time_since_epoch().count()});
+      return;
+    }
     auto const t = chrono::duration<double>{now() - d.eventStart}.count();
     timeSourceTable_.insert(
       d.eventID.run(), d.eventID.subRun(), d.eventID.event(), sourceType_, t);
@@ -329,6 +422,17 @@ namespace art {
   TimeTracker::postEventProcessing(Event const&, ScheduleContext const sc)
   {
     auto const& d = data_[key(sc.id())];
+    if (useRingBuffers_) {
+      pushRecord_(TimeRecord{TimeRecord::Kind::event,
+                             0u,
+                             static_cast<uint32_t>(sc.id().id()),
+                             d.eventID.run(),
+                             d.eventID.subRun(),
+                             d.eventID.event(),
+                             d.eventStart.time_since_epoch().count(),
+                             now().time_since_epoch().count()});
+      return;
+    }
     auto const t = chrono::duration<double>{now() - d.eventStart}.count();
     timeEventTable_.insert(
       d.eventID.run(), d.eventID.subRun(), d.eventID.event(), t);
@@ -337,6 +441,12 @@ namespace art {
   void
   TimeTracker::startTime(ModuleContext const& mc)
   {
+    if (useRingBuffers_) {
+      // The pre- and post-module signals for a given module are
+      // emitted on the same thread.
+      localThreadData_().moduleStarts.open(&mc.moduleDescription(), now());
+      return;
+    }
     data_[key(mc)].eventID = data_[key(mc.scheduleID())].eventID;
     data_[key(mc)].moduleStart = now();
   }
@@ -344,6 +454,24 @@ namespace art {
   void
   TimeTracker::recordTime(ModuleContext const& mc, string const& suffix)
   {
+    if (useRingBuffers_) {
+      auto const stop = now();
+      auto& td = localThreadData_();
+      auto const start = td.moduleStarts.close(&mc.moduleDescription());
+      if (!start) {
+        return;
+      }
+      auto const& eid = data_[key(mc.scheduleID())].eventID;
+      pushRecord_(TimeRecord{TimeRecord::Kind::module,
+                             moduleIndex_(td, mc, suffix),
+                             static_cast<uint32_t>(mc.scheduleID().id()),
+                             eid.run(),
+                             eid.subRun(),
+                             eid.event(),
+                             start->time_since_epoch().count(),
+                             stop.time_since_epoch().count()});
+      return;
+    }
     auto const& d = data_[key(mc)];
     auto const t = chrono::duration<double>{now() - d.moduleStart}.count();
     timeModuleTable_.insert(d.eventID.run(),
@@ -355,6 +483,86 @@ namespace art {
                             t);
   }
 
+  TimeTracker::PerThreadData&
+  TimeTracker::localThreadData_()
+  {
+    return threadData_.local(
+      [this] { return make_unique<PerThreadData>(ringBufferSize_); });
+  }
+
+  uint32_t
+  TimeTracker::moduleIndex_(PerThreadData& td,
+                            ModuleContext const& mc,
+                            string const& suffix)
+  {
+    // The thread-local cache is keyed by the address of the module
+    // description, which is not necessarily unique over the job (for
+    // output modules it refers to a temporary).  A cached index is
+    // therefore used only if it still names the same module.
+    auto const md = &mc.moduleDescription();
+    auto const& type = mc.moduleName();
+    auto matches = [&mc, &type, &suffix](ModuleIdentity const& m) {
+      return m.label == mc.moduleLabel() && m.path == mc.pathName() &&
+             m.type.size() == type.size() + suffix.size() &&
+             m.type.compare(0, type.size(), type) == 0 &&
+             m.type.compare(type.size(), string::npos, suffix) == 0;
+    };
+    if (auto it = td.moduleIndices.find(md);
+        it != td.moduleIndices.end() && matches(modules_[it->second])) {
+      return it->second;
+    }
+    uint32_t index;
+    {
+      lock_guard sentry{modulesMutex_};
+      auto const [it, inserted] = moduleIndices_.try_emplace(
+        make_tuple(mc.pathName(), mc.moduleLabel(), type + suffix),
+        static_cast<uint32_t>(modules_.size()));
+      if (inserted) {
+        modules_.push_back(
+          ModuleIdentity{mc.pathName(), mc.moduleLabel(), type + suffix});
+      }
+      index = it->second;
+    }
+    td.moduleIndices[md] = index;
+    return index;
+  }
+
+  void
+  TimeTracker::pushRecord_(TimeRecord const& r)
+  {
+    if (!localThreadData_().ring.try_push(r)) {
+      insertRecord_(r);
+    }
+  }
+
+  void
+  TimeTracker::insertRecord_(TimeRecord const& r)
+  {
+    auto const t = chrono::duration<double>{
+      steady_clock::duration{r.stop - r.start}}.count();
+    switch (r.kind) {
+    case TimeRecord::Kind::source:
+      timeSourceTable_.insert(r.run, r.subRun, r.event, sourceType_, t);
+      break;
+    case TimeRecord::Kind::event:
+      timeEventTable_.insert(r.run, r.subRun, r.event, t);
+      break;
+    case TimeRecord::Kind::module: {
+      auto const& m = modules_[r.module];
+      timeModuleTable_.insert(
+        r.run, r.subRun, r.event, m.path, m.label, m.type, t);
+    }
+    }
+  }
+
+  void
+  TimeTracker::drainRingBuffers_()
+  {
+    threadData_.for_each([this](PerThreadData& td) {
+      td.ring.drain([this](TimeRecord const& r) { insertRecord_(r); });
+    });
+  }
+
   void
   TimeTracker::logToDestination_(Statistics const& evt,
                                  vector<Statistics> const& modules)
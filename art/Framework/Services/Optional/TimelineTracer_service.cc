@@ -0,0 +1,519 @@
+// vim: set sw=2 expandtab :
+// ======================================================================
+// TimelineTracer
+//
+// Writes a timeline of the job in the Chrome trace-event format,
+// which can be viewed with chrome://tracing or https://ui.perfetto.dev.
+//
+// Two "processes" are shown:
+//
+//   - threads: per-thread spans for source reads (events, subruns,
+//     runs, file opening and closing; all of which happen while the
+//     input-source lock is held), module invocations and output
+//     writes.
+//
+//   - schedules: per-schedule spans for the processing of each event,
+//     for the time serialized modules wait on their serial task
+//     queues and output modules on their write queues, and (as
+//     asynchronous spans) for each trigger path.
+//
+// The framework callbacks write fixed-size records into a lock-free
+// ring buffer owned by the calling thread.  A background thread drains
+// the rings and formats the records into the output file, so that the
+// cost of tracing in the event loop is a few stores per signal.
+// ======================================================================
+
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceDeclarationMacros.h"
+#include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
+#include "art/Framework/Services/Registry/ServiceTable.h"
+#include "art/Persistency/Provenance/ModuleContext.h"
+#include "art/Persistency/Provenance/ModuleDescription.h"
+#include "art/Persistency/Provenance/PathContext.h"
+#include "art/Persistency/Provenance/ScheduleContext.h"
+#include "art/Utilities/Globals.h"
+#include "art/Utilities/detail/PeriodicThread.h"
+#include "art/Utilities/detail/SPSCRingBuffer.h"
+#include "art/Utilities/detail/SpanStarts.h"
+#include "art/Utilities/detail/ThreadRings.h"
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Utilities/Exception.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Comment.h"
+#include "fhiclcpp/types/Name.h"
+#include "tbb/concurrent_unordered_map.h"
+#include "tbb/concurrent_vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+using chrono::steady_clock;
+
+namespace art {
+
+  namespace {
+
+    enum class Category : uint8_t { source, event, path, module, queue, write };
+
+    char const*
+    category_name(Category const c)
+    {
+      switch (c) {
+      case Category::source:
+        return "source";
+      case Category::event:
+        return "event";
+      case Category::path:
+        return "path";
+      case Category::module:
+        return "module";
+      case Category::queue:
+        return "queue";
+      case Category::write:
+        return "write";
+      }
+      return "";
+    }
+
+    // Spans of the event, path and queue categories are shown on the
+    // track of their schedule; all others on the track of their
+    // thread.
+    bool
+    on_schedule_track(Category const c)
+    {
+      return c == Category::event || c == Category::path ||
+             c == Category::queue;
+    }
+
+    enum class Phase : uint8_t { complete, asyncBegin, asyncEnd };
+
+    // 'track' is the thread number or the schedule ID, according to
+    // the category.  Times are in nanoseconds since the start of the
+    // job.
+    struct TraceRecord {
+      Phase phase;
+      Category category;
+      uint32_t name;
+      uint32_t track;
+      uint32_t run;
+      uint32_t subRun;
+      uint32_t event;
+      int64_t start;
+      int64_t duration;
+    };
+
+    string
+    json_escaped(string const& s)
+    {
+      string result;
+      result.reserve(s.size());
+      for (char const c : s) {
+        if (auto const u = static_cast<unsigned char>(c); u < 0x20u) {
+          // Control characters may only appear as escape sequences.
+          constexpr char digits[] = "0123456789abcdef";
+          result += "\\u00";
+          result += digits[u >> 4];
+          result += digits[u & 0xfu];
+          continue;
+        }
+        if (c == '"' || c == '\\') {
+          result += '\\';
+        }
+        result += c;
+      }
+      return result;
+    }
+
+  } // unnamed namespace
+
+  class TimelineTracer {
+  public:
+    static constexpr bool service_handle_allowed{false};
+
+    struct Config {
+      fhicl::Atom<string> fileName{fhicl::Name{"fileName"}, "timeline.json"};
+      fhicl::Atom<unsigned> ringBufferSize{
+        fhicl::Name{"ringBufferSize"},
+        fhicl::Comment{
+          "The number of records each thread can buffer before they are\n"
+          "written out.  A record that does not fit is written directly."},
+        16384u};
+    };
+    using Parameters = ServiceTable<Config>;
+    TimelineTracer(Parameters const&, ActivityRegistry&);
+
+  private:
+    struct SpanStart {
+      void const* key;
+      int64_t start;
+    };
+    struct PerThreadData {
+      PerThreadData(size_t const ringSize, uint32_t const n)
+        : ring{ringSize}, number{n}
+      {}
+      detail::SPSCRingBuffer<TraceRecord> ring;
+      uint32_t const number;
+      detail::SpanStarts<int64_t> starts{};
+    };
+    struct PerScheduleData {
+      EventID eventID{EventID::invalidEvent()};
+      int64_t eventStart{};
+      // Serialized modules and output writes waiting on their queues.
+      mutex queuedMutex{};
+      vector<SpanStart> queued{};
+    };
+
+    int64_t now_() const;
+    uint32_t nameIndex_(string const& name);
+    PerThreadData& localThreadData_();
+    void beginThreadSpan_(void const* key);
+    void endQueueSpan_(ModuleContext const& mc, int64_t end);
+    void endThreadSpan_(void const* key,
+                        Category category,
+                        uint32_t name,
+                        EventID const& id);
+    void push_(TraceRecord const& r);
+    void write_(TraceRecord const& r);
+    void drain_();
+    void postEndJob();
+
+    // Keys for the spans that are not tied to a module.
+    static constexpr char readEventKey_{};
+    static constexpr char readSubRunKey_{};
+    static constexpr char readRunKey_{};
+    static constexpr char openFileKey_{};
+    static constexpr char closeFileKey_{};
+
+    steady_clock::time_point const start_{steady_clock::now()};
+    size_t const ringBufferSize_;
+    vector<PerScheduleData> schedules_;
+
+    tbb::concurrent_unordered_map<string, uint32_t> nameIndices_{};
+    tbb::concurrent_vector<string> names_{};
+    mutex namesMutex_{};
+
+    detail::ThreadRings<PerThreadData> threadData_{};
+    atomic<uint32_t> nThreads_{};
+
+    // The output file; guarded by fileMutex_.
+    mutex fileMutex_{};
+    ofstream file_;
+    bool firstRecord_{true};
+
+    // Declared last, so that it is stopped before the members it uses
+    // are destroyed.
+    unique_ptr<detail::PeriodicThread> writer_{nullptr};
+  };
+
+  TimelineTracer::TimelineTracer(Parameters const& config,
+                                 ActivityRegistry& areg)
+    : ringBufferSize_{config().ringBufferSize()}
+    , schedules_(Globals::instance()->nschedules())
+    , file_{config().fileName()}
+  {
+    if (!file_) {
+      throw Exception{errors::Configuration}
+        << "The TimelineTracer could not open the file '"
+        << config().fileName() << "' for writing.\n";
+    }
+    // Times are written in microseconds, with nanosecond precision.
+    file_ << fixed << setprecision(3);
+    file_ << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    auto const readEvent = nameIndex_("readEvent");
+    auto const readSubRun = nameIndex_("readSubRun");
+    auto const readRun = nameIndex_("readRun");
+    auto const openFile = nameIndex_("openFile");
+    auto const closeFile = nameIndex_("closeFile");
+    auto const event = nameIndex_("event");
+
+    // Source
+    areg.sPreSourceEvent.watch(
+      [this](ScheduleContext) { beginThreadSpan_(&readEventKey_); });
+    areg.sPostSourceEvent.watch(
+      [this, readEvent](Event const& e, ScheduleContext) {
+        endThreadSpan_(&readEventKey_, Category::source, readEvent, e.id());
+      });
+    areg.sPreSourceSubRun.watch(
+      [this] { beginThreadSpan_(&readSubRunKey_); });
+    areg.sPostSourceSubRun.watch([this, readSubRun](auto const&) {
+      endThreadSpan_(&readSubRunKey_,
+                     Category::source,
+                     readSubRun,
+                     EventID::invalidEvent());
+    });
+    areg.sPreSourceRun.watch([this] { beginThreadSpan_(&readRunKey_); });
+    areg.sPostSourceRun.watch([this, readRun](auto const&) {
+      endThreadSpan_(
+        &readRunKey_, Category::source, readRun, EventID::invalidEvent());
+    });
+    areg.sPreOpenFile.watch([this] { beginThreadSpan_(&openFileKey_); });
+    areg.sPostOpenFile.watch([this, openFile](auto const&) {
+      endThreadSpan_(
+        &openFileKey_, Category::source, openFile, EventID::invalidEvent());
+    });
+    areg.sPreCloseFile.watch([this] { beginThreadSpan_(&closeFileKey_); });
+    areg.sPostCloseFile.watch([this, closeFile] {
+      endThreadSpan_(
+        &closeFileKey_, Category::source, closeFile, EventID::invalidEvent());
+    });
+
+    // Events
+    areg.sPreProcessEvent.watch([this](Event const& e,
+                                       ScheduleContext const sc) {
+      auto& d = schedules_[sc.id().id()];
+      d.eventID = e.id();
+      d.eventStart = now_();
+    });
+    areg.sPostProcessEvent.watch(
+      [this, event](Event const&, ScheduleContext const sc) {
+        auto const sid = sc.id().id();
+        auto const& d = schedules_[sid];
+        push_(TraceRecord{Phase::complete,
+                          Category::event,
+                          event,
+                          static_cast<uint32_t>(sid),
+                          d.eventID.run(),
+                          d.eventID.subRun(),
+                          d.eventID.event(),
+                          d.eventStart,
+                          now_() - d.eventStart});
+      });
+
+    // Paths
+    areg.sPreProcessPath.watch([this](PathContext const& pc) {
+      auto const& id = schedules_[pc.scheduleID().id()].eventID;
+      push_(TraceRecord{Phase::asyncBegin,
+                        Category::path,
+                        nameIndex_(pc.pathName()),
+                        static_cast<uint32_t>(pc.scheduleID().id()),
+                        id.run(),
+                        id.subRun(),
+                        id.event(),
+                        now_(),
+                        0});
+    });
+    areg.sPostProcessPath.watch([this](PathContext const& pc, auto const&) {
+      auto const& id = schedules_[pc.scheduleID().id()].eventID;
+      push_(TraceRecord{Phase::asyncEnd,
+                        Category::path,
+                        nameIndex_(pc.pathName()),
+                        static_cast<uint32_t>(pc.scheduleID().id()),
+                        id.run(),
+                        id.subRun(),
+                        id.event(),
+                        now_(),
+                        0});
+    });
+
+    // Modules
+    areg.sModuleQueued.watch([this](ModuleContext const& mc) {
+      auto& d = schedules_[mc.scheduleID().id()];
+      lock_guard sentry{d.queuedMutex};
+      d.queued.push_back(SpanStart{&mc.moduleDescription(), now_()});
+    });
+    areg.sPreModule.watch([this](ModuleContext const& mc) {
+      auto const start = now_();
+      endQueueSpan_(mc, start);
+      localThreadData_().starts.open(&mc.moduleDescription(), start);
+    });
+    areg.sPostModule.watch([this](ModuleContext const& mc) {
+      endThreadSpan_(&mc.moduleDescription(),
+                     Category::module,
+                     nameIndex_(mc.moduleLabel()),
+                     schedules_[mc.scheduleID().id()].eventID);
+    });
+    // Output modules wait on their write queues.
+    areg.sPreWriteEvent.watch([this](ModuleContext const& mc) {
+      auto const start = now_();
+      endQueueSpan_(mc, start);
+      localThreadData_().starts.open(&mc.moduleDescription(), start);
+    });
+    areg.sPostWriteEvent.watch([this](ModuleContext const& mc) {
+      endThreadSpan_(&mc.moduleDescription(),
+                     Category::write,
+                     nameIndex_(mc.moduleLabel()),
+                     schedules_[mc.scheduleID().id()].eventID);
+    });
+
+    areg.sPostEndJob.watch(this, &TimelineTracer::postEndJob);
+    writer_ = make_unique<detail::PeriodicThread>(100ms, [this] { drain_(); });
+  }
+
+  int64_t
+  TimelineTracer::now_() const
+  {
+    return chrono::duration_cast<chrono::nanoseconds>(steady_clock::now() -
+                                                      start_)
+      .count();
+  }
+
+  uint32_t
+  TimelineTracer::nameIndex_(string const& name)
+  {
+    if (auto it = nameIndices_.find(name); it != nameIndices_.end()) {
+      return it->second;
+    }
+    // Only the first use of a given name gets here.
+    lock_guard sentry{namesMutex_};
+    auto const [it, inserted] =
+      nameIndices_.emplace(name, static_cast<uint32_t>(names_.size()));
+    if (inserted) {
+      names_.push_back(json_escaped(name));
+    }
+    return it->second;
+  }
+
+  // Ends the wait of the module on its serial task queues or on its
+  // write queue, if it was queued.
+  void
+  TimelineTracer::endQueueSpan_(ModuleContext const& mc, int64_t const end)
+  {
+    auto const sid = mc.scheduleID().id();
+    auto& d = schedules_[sid];
+    lock_guard sentry{d.queuedMutex};
+    auto const md = &mc.moduleDescription();
+    auto it = find_if(
+      d.queued.begin(), d.queued.end(), [md](auto& q) { return q.key == md; });
+    if (it == d.queued.end()) {
+      return;
+    }
+    push_(TraceRecord{Phase::complete,
+                      Category::queue,
+                      nameIndex_(mc.moduleLabel()),
+                      static_cast<uint32_t>(sid),
+                      d.eventID.run(),
+                      d.eventID.subRun(),
+                      d.eventID.event(),
+                      it->start,
+                      end - it->start});
+    d.queued.erase(it);
+  }
+
+  TimelineTracer::PerThreadData&
+  TimelineTracer::localThreadData_()
+  {
+    return threadData_.local([this] {
+      return make_unique<PerThreadData>(ringBufferSize_, nThreads_++);
+    });
+  }
+
+  void
+  TimelineTracer::beginThreadSpan_(void const* key)
+  {
+    localThreadData_().starts.open(key, now_());
+  }
+
+  void
+  TimelineTracer::endThreadSpan_(void const* key,
+                                 Category const category,
+                                 uint32_t const name,
+                                 EventID const& id)
+  {
+    auto const stop = now_();
+    auto& td = localThreadData_();
+    auto const start = td.starts.close(key);
+    if (!start) {
+      return;
+    }
+    push_(TraceRecord{Phase::complete,
+                      category,
+                      name,
+                      td.number,
+                      id.run(),
+                      id.subRun(),
+                      id.event(),
+                      *start,
+                      stop - *start});
+  }
+
+  void
+  TimelineTracer::push_(TraceRecord const& r)
+  {
+    if (!localThreadData_().ring.try_push(r)) {
+      lock_guard sentry{fileMutex_};
+      write_(r);
+    }
+  }
+
+  // Must be called with fileMutex_ held.
+  void
+  TimelineTracer::write_(TraceRecord const& r)
+  {
+    if (!firstRecord_) {
+      file_ << ",\n";
+    }
+    firstRecord_ = false;
+    auto const pid = on_schedule_track(r.category) ? 1 : 0;
+    file_ << "{\"name\":\"" << names_[r.name] << "\",\"cat\":\""
+          << category_name(r.category) << "\",\"pid\":" << pid
+          << ",\"tid\":" << r.track << ",\"ts\":" << r.start / 1000.;
+    switch (r.phase) {
+    case Phase::complete:
+      file_ << ",\"ph\":\"X\",\"dur\":" << r.duration / 1000.;
+      break;
+    case Phase::asyncBegin:
+    case Phase::asyncEnd:
+      file_ << ",\"ph\":\"" << (r.phase == Phase::asyncBegin ? 'b' : 'e')
+            << "\",\"id\":\"" << r.track << '.' << r.name << '"';
+    }
+    if (r.event != EventID::invalidEvent().event()) {
+      file_ << ",\"args\":{\"run\":" << r.run << ",\"subRun\":" << r.subRun
+            << ",\"event\":" << r.event << '}';
+    }
+    file_ << '}';
+  }
+
+  void
+  TimelineTracer::drain_()
+  {
+    lock_guard sentry{fileMutex_};
+    threadData_.for_each([this](PerThreadData& td) {
+      td.ring.drain([this](TraceRecord const& r) { write_(r); });
+    });
+  }
+
+  void
+  TimelineTracer::postEndJob()
+  {
+    writer_->stopAndRethrow();
+    drain_();
+
+    // Name the tracks.
+    lock_guard sentry{fileMutex_};
+    auto metadata = [this](char const* what,
+                           int const pid,
+                           uint32_t const tid,
+                           string const& name) {
+      file_ << (firstRecord_ ? "" : ",\n") << "{\"name\":\"" << what
+            << "\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << tid
+            << ",\"args\":{\"name\":\"" << name << "\"}}";
+      firstRecord_ = false;
+    };
+    metadata("process_name", 0, 0, "threads");
+    metadata("process_name", 1, 0, "schedules");
+    for (uint32_t i{}; i != nThreads_; ++i) {
+      metadata("thread_name", 0, i, "thread " + std::to_string(i));
+    }
+    for (uint32_t i{}; i != schedules_.size(); ++i) {
+      metadata("thread_name", 1, i, "schedule " + std::to_string(i));
+    }
+    file_ << "\n]}\n";
+    file_.close();
+  }
+
+} // namespace art
+
+DECLARE_ART_SERVICE(art::TimelineTracer, SHARED)
+DEFINE_ART_SERVICE(art::TimelineTracer)
@@ -0,0 +1,74 @@
+#ifndef art_Framework_Services_Optional_detail_philox_h
+#define art_Framework_Services_Optional_detail_philox_h
+
+// ======================================================================
+// The Philox-4x32-10 counter-based random number generator (Salmon et
+// al., "Parallel random numbers: as easy as 1, 2, 3", SC11): a keyed
+// bijection of a 128-bit counter onto four 32-bit random words.
+// ======================================================================
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace art::detail {
+
+  using philox_counter = std::array<std::uint32_t, 4>;
+  using philox_key = std::array<std::uint32_t, 2>;
+
+  inline philox_counter
+  philox4x32(philox_counter ctr, philox_key key)
+  {
+    constexpr std::uint64_t m0{0xD2511F53};
+    constexpr std::uint64_t m1{0xCD9E8D57};
+    constexpr std::uint32_t w0{0x9E3779B9};
+    constexpr std::uint32_t w1{0xBB67AE85};
+    for (int round{}; round != 10; ++round) {
+      if (round != 0) {
+        key[0] += w0;
+        key[1] += w1;
+      }
+      auto const p0 = m0 * ctr[0];
+      auto const p1 = m1 * ctr[2];
+      ctr = {static_cast<std::uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+             static_cast<std::uint32_t>(p1),
+             static_cast<std::uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+             static_cast<std::uint32_t>(p0)};
+    }
+    return ctr;
+  }
+
+  // A key that depends on the seed and on both labels, and is the
+  // same on every platform (64-bit FNV-1a).
+  inline philox_key
+  philox_key_for(long const seed,
+                 std::string const& module_label,
+                 std::string const& engine_label)
+  {
+    std::uint64_t hash{0xCBF29CE484222325};
+    auto add = [&hash](unsigned char const byte) {
+      hash ^= byte;
+      hash *= 0x100000001B3;
+    };
+    auto const useed = static_cast<std::uint64_t>(seed);
+    for (int i{}; i != 8; ++i) {
+      add(static_cast<unsigned char>(useed >> (8 * i)));
+    }
+    for (unsigned char const c : module_label) {
+      add(c);
+    }
+    add(0);
+    for (unsigned char const c : engine_label) {
+      add(c);
+    }
+    return {static_cast<std::uint32_t>(hash),
+            static_cast<std::uint32_t>(hash >> 32)};
+  }
+
+} // namespace art::detail
+
+#endif /* art_Framework_Services_Optional_detail_philox_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -294,6 +294,14 @@ public:
   GlobalSignal<detail::SignalResponseType::LIFO, void(ModuleContext const&)>
     sPostModule;
 
+  // Signal is emitted when a module whose processing of the Event must
+  // be serialized is placed on its serial task queues; sPreModule
+  // follows once the module has reached the front of each of them.
+  // It is also emitted when the write of the Event is placed on the
+  // write queue of an output module, which sPreWriteEvent follows.
+  GlobalSignal<detail::SignalResponseType::FIFO, void(ModuleContext const&)>
+    sModuleQueued;
+
   // Signal is emitted before the module starts processing beginRun
   GlobalSignal<detail::SignalResponseType::FIFO, void(ModuleContext const&)>
     sPreModuleBeginRun;
@@ -0,0 +1,33 @@
+// vim: set sw=2 expandtab :
+#include "art/Utilities/AllocationCounters.h"
+
+#include <dlfcn.h>
+
+namespace {
+  art::detail::allocation_counters_fn_t
+  counters_function() noexcept
+  {
+    // The hooks are either preloaded or absent for the whole process,
+    // so the lookup is done only once.
+    using fn_t = art::detail::allocation_counters_fn_t;
+    static auto const fn = reinterpret_cast<fn_t>(
+      dlsym(RTLD_DEFAULT, art::detail::allocation_counters_symbol));
+    return fn;
+  }
+}
+
+namespace art {
+
+  AllocationCounters&
+  threadAllocationCounters() noexcept
+  {
+    return *counters_function()();
+  }
+
+  bool
+  allocationTrackingActive() noexcept
+  {
+    return counters_function() != nullptr;
+  }
+
+} // namespace art
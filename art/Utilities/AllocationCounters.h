@@ -0,0 +1,74 @@
+#ifndef art_Utilities_AllocationCounters_h
+#define art_Utilities_AllocationCounters_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// AllocationCounters
+//
+// Per-thread counts of the bytes that have been allocated and freed
+// through the global operator new and operator delete.  The counters
+// belong to the AllocationHooks library, which replaces those
+// operators and must be preloaded (e.g. with LD_PRELOAD).  They are
+// found at run time through the allocation_counters_symbol function
+// that the library exports; allocationTrackingActive() returns true
+// if it has been found, and only then may threadAllocationCounters()
+// be called.
+//
+// Memory freed on a thread other than the one that allocated it is
+// counted on the freeing thread.  Counts should therefore be compared
+// as differences taken on one thread, e.g. before and after a module
+// runs.
+// ======================================================================
+
+#include <cstddef>
+#include <cstdint>
+
+namespace art {
+
+  struct AllocationCounters {
+    std::int64_t
+    live() const noexcept
+    {
+      return static_cast<std::int64_t>(allocated - freed);
+    }
+
+    void
+    allocate(std::size_t const n) noexcept
+    {
+      allocated += n;
+      if (auto const l = live(); l > highWater) {
+        highWater = l;
+      }
+    }
+
+    void
+    deallocate(std::size_t const n) noexcept
+    {
+      freed += n;
+    }
+
+    std::uint64_t allocated;
+    std::uint64_t freed;
+    // The largest value of live() since the last time highWater was
+    // reset by the user of the counters.
+    std::int64_t highWater;
+  };
+
+  namespace detail {
+    // The name of the function, with C linkage, through which the
+    // AllocationHooks library returns the calling thread's counters.
+    inline constexpr char allocation_counters_symbol[]{
+      "art_thread_allocation_counters"};
+    using allocation_counters_fn_t = AllocationCounters* (*)() noexcept;
+  }
+
+  AllocationCounters& threadAllocationCounters() noexcept;
+  bool allocationTrackingActive() noexcept;
+
+} // namespace art
+
+#endif /* art_Utilities_AllocationCounters_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,235 @@
+// vim: set sw=2 expandtab :
+// ======================================================================
+// AllocationHooks
+//
+// Replacements for the global operator new and operator delete that
+// keep the per-thread AllocationCounters up to date.  The library is
+// not linked into anything: it must be preloaded, e.g.
+//
+//   LD_PRELOAD=libart_AllocationHooks.so art -c job.fcl
+//
+// so that its operators take precedence over those of the C++ runtime
+// for the whole process.  The sizes recorded are those reported by
+// malloc_usable_size, so that an allocation and its deallocation are
+// always counted with the same size.
+//
+// The library depends on nothing from art: the counters are defined
+// here, and the MemoryTracker finds them with dlsym through the
+// function exported below.  Each operator therefore updates them
+// without leaving the library.
+// ======================================================================
+
+#ifndef __linux__
+#error "This source file can be built only for Linux platforms."
+#endif
+
+#include "art/Utilities/AllocationCounters.h"
+
+#include <malloc.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+  // Constant-initialized so that the counters can be used before (and
+  // while) any dynamic initialization takes place.  A preloaded library
+  // is part of the initial thread-local storage, so the initial-exec
+  // model can be used to reach the counters without a function call.
+  [[gnu::tls_model("initial-exec")]] thread_local art::AllocationCounters
+    counters{};
+
+  void*
+  record(void* const p) noexcept
+  {
+    if (p != nullptr) {
+      counters.allocate(malloc_usable_size(p));
+    }
+    return p;
+  }
+
+  void*
+  try_allocate(std::size_t const n, std::size_t const alignment) noexcept
+  {
+    auto const size = n == 0 ? 1 : n;
+    if (alignment <= alignof(std::max_align_t)) {
+      return record(std::malloc(size));
+    }
+    void* p{nullptr};
+    if (posix_memalign(&p, alignment, size) != 0) {
+      return nullptr;
+    }
+    return record(p);
+  }
+
+  void*
+  allocate(std::size_t const n, std::size_t const alignment = 0)
+  {
+    while (true) {
+      if (auto p = try_allocate(n, alignment)) {
+        return p;
+      }
+      auto const handler = std::get_new_handler();
+      if (handler == nullptr) {
+        throw std::bad_alloc{};
+      }
+      handler();
+    }
+  }
+
+  void*
+  allocate_nothrow(std::size_t const n, std::size_t const alignment = 0)
+    noexcept
+  {
+    try {
+      return allocate(n, alignment);
+    }
+    catch (...) {
+      return nullptr;
+    }
+  }
+
+  void
+  deallocate(void* const p) noexcept
+  {
+    if (p == nullptr) {
+      return;
+    }
+    counters.deallocate(malloc_usable_size(p));
+    std::free(p);
+  }
+
+} // unnamed namespace
+
+extern "C" art::AllocationCounters*
+art_thread_allocation_counters() noexcept
+{
+  return &counters;
+}
+
+void*
+operator new(std::size_t const n)
+{
+  return allocate(n);
+}
+
+void*
+operator new[](std::size_t const n)
+{
+  return allocate(n);
+}
+
+void*
+operator new(std::size_t const n, std::nothrow_t const&) noexcept
+{
+  return allocate_nothrow(n);
+}
+
+void*
+operator new[](std::size_t const n, std::nothrow_t const&) noexcept
+{
+  return allocate_nothrow(n);
+}
+
+void*
+operator new(std::size_t const n, std::align_val_t const al)
+{
+  return allocate(n, static_cast<std::size_t>(al));
+}
+
+void*
+operator new[](std::size_t const n, std::align_val_t const al)
+{
+  return allocate(n, static_cast<std::size_t>(al));
+}
+
+void*
+operator new(std::size_t const n,
+             std::align_val_t const al,
+             std::nothrow_t const&) noexcept
+{
+  return allocate_nothrow(n, static_cast<std::size_t>(al));
+}
+
+void*
+operator new[](std::size_t const n,
+               std::align_val_t const al,
+               std::nothrow_t const&) noexcept
+{
+  return allocate_nothrow(n, static_cast<std::size_t>(al));
+}
+
+void
+operator delete(void* const p) noexcept
+{
+  deallocate(p);
+}
+
+void
+operator delete[](void* const p) noexcept
+{
+  deallocate(p);
+}
+
+void
+operator delete(void* const p, std::size_t) noexcept
+{
+  deallocate(p);
+}
+
+void
+operator delete[](void* const p, std::size_t) noexcept
+{
+  deallocate(p);
+}
+
+void
+operator delete(void* const p, std::nothrow_t const&) noexcept
+{
+  deallocate(p);
+}
+
+void
+operator delete[](void* const p, std::nothrow_t const&) noexcept
+{
+  deallocate(p);
+}
+
+void
+operator delete(void* const p, std::align_val_t) noexcept
+{
+  deallocate(p);
+}
+
+void
+operator delete[](void* const p, std::align_val_t) noexcept
+{
+  deallocate(p);
+}
+
+void
+operator delete(void* const p, std::size_t, std::align_val_t) noexcept
+{
+  deallocate(p);
+}
+
+void
+operator delete[](void* const p, std::size_t, std::align_val_t) noexcept
+{
+  deallocate(p);
+}
+
+void
+operator delete(void* const p, std::align_val_t, std::nothrow_t const&) noexcept
+{
+  deallocate(p);
+}
+
+void
+operator delete[](void* const p,
+                  std::align_val_t,
+                  std::nothrow_t const&) noexcept
+{
+  deallocate(p);
+}
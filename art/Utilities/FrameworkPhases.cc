@@ -0,0 +1,125 @@
+#include "art/Utilities/FrameworkPhases.h"
+// vim: set sw=2 expandtab :
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <utility>
+
+using namespace std::chrono;
+
+namespace {
+  using PhaseAccumulators =
+    std::array<std::atomic<steady_clock::rep>, art::num_framework_phases>;
+
+  std::atomic<bool> accountingActive{false};
+  std::unique_ptr<PhaseAccumulators[]> accumulators;
+  art::ScheduleID::size_type nAccumulators{};
+
+  // The time spent in phases nested within the innermost phase that
+  // is active on this thread.
+  thread_local steady_clock::duration nestedTime{};
+  // The schedule of the innermost phase that is active on this thread.
+  thread_local art::ScheduleID currentSchedule{};
+
+  auto
+  index(art::FrameworkPhase const phase)
+  {
+    return static_cast<std::size_t>(phase);
+  }
+} // namespace
+
+namespace art {
+
+  char const*
+  to_string(FrameworkPhase const phase)
+  {
+    switch (phase) {
+    case FrameworkPhase::PrincipalCreation:
+      return "PrincipalCreation";
+    case FrameworkPhase::GroupCreation:
+      return "GroupCreation";
+    case FrameworkPhase::ProductLookup:
+      return "ProductLookup";
+    case FrameworkPhase::ProductRead:
+      return "ProductRead";
+    case FrameworkPhase::TaskSpawning:
+      return "TaskSpawning";
+    case FrameworkPhase::TriggerResults:
+      return "TriggerResults";
+    case FrameworkPhase::OutputSelection:
+      return "OutputSelection";
+    case FrameworkPhase::EventWrite:
+      return "EventWrite";
+    }
+    return "Unknown";
+  }
+
+  void
+  activateFrameworkPhaseAccounting(ScheduleID::size_type const nschedules)
+  {
+    assert(!accountingActive.load());
+    accumulators = std::make_unique<PhaseAccumulators[]>(nschedules);
+    nAccumulators = nschedules;
+    accountingActive = true;
+  }
+
+  void
+  deactivateFrameworkPhaseAccounting() noexcept
+  {
+    accountingActive = false;
+  }
+
+  bool
+  frameworkPhaseAccountingActive() noexcept
+  {
+    return accountingActive.load(std::memory_order_relaxed);
+  }
+
+  FrameworkPhaseTimes
+  takeFrameworkPhaseTimes(ScheduleID const sid) noexcept
+  {
+    FrameworkPhaseTimes result{};
+    if (!frameworkPhaseAccountingActive() || sid.id() >= nAccumulators) {
+      return result;
+    }
+    auto& times = accumulators[sid.id()];
+    for (std::size_t i{}; i != num_framework_phases; ++i) {
+      result[i] = steady_clock::duration{times[i].exchange(0)};
+    }
+    return result;
+  }
+
+  FrameworkPhaseSentry::FrameworkPhaseSentry(FrameworkPhase const phase,
+                                             ScheduleID const sid) noexcept
+    : phase_{phase}
+    , sid_{sid}
+    , active_{frameworkPhaseAccountingActive() && sid.isValid() &&
+              sid.id() < nAccumulators}
+  {
+    if (!active_) {
+      return;
+    }
+    enclosingNested_ = std::exchange(nestedTime, steady_clock::duration{});
+    enclosingSchedule_ = std::exchange(currentSchedule, sid);
+    start_ = steady_clock::now();
+  }
+
+  FrameworkPhaseSentry::FrameworkPhaseSentry(
+    FrameworkPhase const phase) noexcept
+    : FrameworkPhaseSentry{phase, currentSchedule}
+  {}
+
+  FrameworkPhaseSentry::~FrameworkPhaseSentry() noexcept
+  {
+    if (!active_) {
+      return;
+    }
+    auto const elapsed = steady_clock::now() - start_;
+    accumulators[sid_.id()][index(phase_)].fetch_add(
+      (elapsed - nestedTime).count(), std::memory_order_relaxed);
+    nestedTime = enclosingNested_ + elapsed;
+    currentSchedule = enclosingSchedule_;
+  }
+
+} // namespace art
@@ -0,0 +1,80 @@
+#ifndef art_Utilities_FrameworkPhases_h
+#define art_Utilities_FrameworkPhases_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// FrameworkPhases
+//
+// Accounting of the time the framework itself spends on each event,
+// split into phases.  Framework code marks a phase with a
+// FrameworkPhaseSentry, which charges the time to the schedule
+// processing the event.  Nothing is recorded unless the accounting
+// has been activated.  If phases are nested on one thread, the time of
+// the inner phase is charged to it alone and not to the outer phase.
+// A sentry that is not given a schedule charges the time to the
+// schedule of the enclosing phase, and records nothing outside of
+// one; this is used for work, like delayed product reads, done on
+// behalf of whichever phase triggers it.
+// ======================================================================
+
+#include "art/Utilities/ScheduleID.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace art {
+
+  enum class FrameworkPhase {
+    PrincipalCreation,
+    GroupCreation,
+    ProductLookup,
+    ProductRead,
+    TaskSpawning,
+    TriggerResults,
+    OutputSelection,
+    EventWrite
+  };
+  inline constexpr std::size_t num_framework_phases{8};
+
+  char const* to_string(FrameworkPhase);
+
+  using FrameworkPhaseTimes =
+    std::array<std::chrono::steady_clock::duration, num_framework_phases>;
+
+  // Must not be called while events are being processed.
+  void activateFrameworkPhaseAccounting(ScheduleID::size_type nschedules);
+  void deactivateFrameworkPhaseAccounting() noexcept;
+  bool frameworkPhaseAccountingActive() noexcept;
+
+  // Returns the times accumulated for the schedule since the last
+  // call, and resets them.
+  FrameworkPhaseTimes takeFrameworkPhaseTimes(ScheduleID) noexcept;
+
+  class FrameworkPhaseSentry {
+  public:
+    FrameworkPhaseSentry(FrameworkPhase, ScheduleID) noexcept;
+    explicit FrameworkPhaseSentry(FrameworkPhase) noexcept;
+    ~FrameworkPhaseSentry() noexcept;
+
+    FrameworkPhaseSentry(FrameworkPhaseSentry const&) = delete;
+    FrameworkPhaseSentry& operator=(FrameworkPhaseSentry const&) = delete;
+
+  private:
+    FrameworkPhase const phase_;
+    ScheduleID const sid_;
+    bool const active_;
+    std::chrono::steady_clock::time_point start_{};
+    // The nested time and the schedule of the enclosing phase, if
+    // any.
+    std::chrono::steady_clock::duration enclosingNested_{};
+    ScheduleID enclosingSchedule_{};
+  };
+
+} // namespace art
+
+#endif /* art_Utilities_FrameworkPhases_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -7,14 +7,14 @@
 #include "art/Utilities/LinuxProcMgr.h"
 #include "art/Utilities/LinuxProcData.h"
 #include "canvas/Utilities/Exception.h"
-#include "hep_concurrency/assert_only_one_thread.h"
 
 #include <cerrno>
+#include <cstdlib>
 #include <cstring>
-#include <regex>
 #include <sstream>
 
 extern "C" {
+#include <fcntl.h>
 #include <unistd.h>
 }
 
@@ -36,20 +36,45 @@ namespace {
     return is;
   }
 
-  // NB: fclose must be called on the returned file descriptor.
-  auto
-  new_proc_file_descriptor(pid_t const pid)
+  // NB: close must be called on the returned file descriptor.
+  int
+  open_proc_file(pid_t const pid, char const* name)
   {
     std::ostringstream ost;
-    ost << "/proc/" << pid << "/stat";
+    ost << "/proc/" << pid << '/' << name;
 
-    auto file = fopen(ost.str().c_str(), "r");
-    if (file == nullptr) {
+    auto const fd = open(ost.str().c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
       throw art::Exception{art::errors::Configuration}
         << " Failed to open: " << ost.str() << '\n'
         << " errno: " << errno << " (" << std::strerror(errno) << ")\n";
     }
-    return file;
+    return fd;
+  }
+
+  // Reads the (re-generated) contents of a proc file from its start
+  // and null-terminates them.
+  template <std::size_t N>
+  void
+  read_proc_file(int const fd, char (&buf)[N], char const* name)
+  {
+    auto const cnt = pread(fd, buf, N - 1, 0);
+    if (cnt <= 0) {
+      throw art::Exception{art::errors::FileReadError,
+                           "Error while retrieving Linux proc data."}
+        << "\nCould not read proc " << name << " information.\n";
+    }
+    buf[cnt] = '\0';
+  }
+
+  // The second field of the stat file is the executable name in
+  // parentheses, which may itself contain spaces.  The returned
+  // stream starts with the third field.
+  std::istringstream
+  stat_fields_from_state(char const* buf)
+  {
+    auto const paren = std::strrchr(buf, ')');
+    return std::istringstream{paren == nullptr ? buf : paren + 1};
   }
 
 } // namespace
@@ -59,76 +84,69 @@ namespace art {
   LinuxProcMgr::LinuxProcMgr() noexcept(false)
     : pid_{getpid()}
     , pgSize_{sysconf(_SC_PAGESIZE)}
-    , file_{new_proc_file_descriptor(pid_)}
+    , ticksPerSecond_{sysconf(_SC_CLK_TCK)}
+    , statFd_{open_proc_file(pid_, "stat")}
+    , statusFd_{open_proc_file(pid_, "status")}
   {}
 
-  LinuxProcMgr::~LinuxProcMgr() noexcept { fclose(file_); }
+  LinuxProcMgr::~LinuxProcMgr() noexcept
+  {
+    close(statusFd_);
+    close(statFd_);
+  }
 
   //=======================================================
   LinuxProcData::proc_tuple
   LinuxProcMgr::getCurrentData() const noexcept(false)
   {
-    HEP_CONCURRENCY_ASSERT_ONLY_ONE_THREAD();
-
-    int const seek_result{fseek(file_, 0, SEEK_SET)};
-    if (seek_result != 0) {
-      throw Exception{errors::FileReadError,
-                      "Error while retrieving Linux proc data."}
-        << "\nCould not reset position indicator while retrieving proc "
-           "stat information.\n";
-    }
-
-    char buf[400];
-    size_t const cnt{fread(buf, 1, sizeof(buf), file_)};
-
-    if (cnt == 0) {
-      throw Exception{errors::FileReadError,
-                      "Error while retrieving Linux proc data."}
-        << "\nCould not read proc stat information.\n";
-    }
-
-    buf[cnt] = '\0';
+    char buf[512];
+    read_proc_file(statFd_, buf, "stat");
 
     LinuxProcData::vsize_t::value_type vsize;
     LinuxProcData::rss_t::value_type rss;
 
-    std::istringstream iss{buf};
-    iss >> token_ignore(22) >> vsize >> rss;
+    // Fields 3 through 22 precede vsize and rss.
+    auto iss = stat_fields_from_state(buf);
+    iss >> token_ignore(20) >> vsize >> rss;
 
     return LinuxProcData::make_proc_tuple(vsize, rss * pgSize_);
   }
 
   //=======================================================
-  double
-  LinuxProcMgr::getStatusData_(std::string const& field) const noexcept(false)
+  LinuxProcMgr::CpuTimes
+  LinuxProcMgr::getCpuTimes() const noexcept(false)
   {
-    HEP_CONCURRENCY_ASSERT_ONLY_ONE_THREAD();
+    char buf[512];
+    read_proc_file(statFd_, buf, "stat");
 
-    std::ostringstream ost;
-    ost << "/proc/" << pid_ << "/status";
+    unsigned long utime;
+    unsigned long stime;
 
-    auto file = fopen(ost.str().c_str(), "r");
-    if (file == nullptr) {
-      throw Exception{errors::Configuration} << " Failed to open: " << ost.str()
-                                             << std::endl;
-    }
+    // Fields 3 through 13 precede utime and stime.
+    auto iss = stat_fields_from_state(buf);
+    iss >> token_ignore(11) >> utime >> stime;
 
-    double value{};
-    std::regex const pattern{"^" + field + R"(:\s*(\d+)\s*kB)"};
-    while (!feof(file)) {
-      char buffer[128];
-      if (fgets(buffer, sizeof(buffer), file) != nullptr) {
-        std::cmatch cm;
-        if (std::regex_search(buffer, cm, pattern)) {
-          // Reported value from proc (although labeled 'kB') is
-          // actually in KiB.  Will convert to base-10 MB.
-          value = std::stod(cm.str(1)) * LinuxProcData::KiB / LinuxProcData::MB;
-          break;
-        }
-      }
+    auto const ticks = static_cast<double>(ticksPerSecond_);
+    return CpuTimes{utime / ticks, stime / ticks};
+  }
+
+  //=======================================================
+  double
+  LinuxProcMgr::getStatusData_(std::string const& field) const noexcept(false)
+  {
+    char buf[4096];
+    read_proc_file(statusFd_, buf, "status");
+
+    // Each line has the form '<field>:<whitespace><value> kB'.
+    auto const key = '\n' + field + ':';
+    auto const line = std::strstr(buf, key.c_str());
+    if (line == nullptr) {
+      return 0.;
     }
-    fclose(file);
-    return value;
+    // Reported value from proc (although labeled 'kB') is actually in
+    // KiB.  Will convert to base-10 MB.
+    auto const value = std::strtod(line + key.size(), nullptr);
+    return value * LinuxProcData::KiB / LinuxProcData::MB;
   }
 
 } // namespace art
@@ -6,15 +6,15 @@
 //
 // Responsible for retrieving procfs information.
 //
-// A different implementation may be necessary to guarantee that we do
-// not open too many file descriptors.
+// The stat and status files of the process are opened once and are
+// reread with pread, so that the accessors may be called from any
+// thread, including concurrently, without reopening the files.
 // ================================================================
 
 #include "art/Utilities/LinuxProcData.h"
 
 #include <sys/types.h>
 
-#include <cstdio>
 #include <string>
 
 namespace art {
@@ -24,7 +24,13 @@ namespace art {
     LinuxProcMgr() noexcept(false);
     ~LinuxProcMgr() noexcept;
 
+    struct CpuTimes {
+      double user; // seconds
+      double system; // seconds
+    };
+
     LinuxProcData::proc_tuple getCurrentData() const noexcept(false);
+    CpuTimes getCpuTimes() const noexcept(false);
     double
     getVmPeak() const noexcept(false)
     {
@@ -46,7 +52,9 @@ namespace art {
 
     pid_t const pid_;
     long const pgSize_;
-    FILE* const file_;
+    long const ticksPerSecond_;
+    int const statFd_;
+    int const statusFd_;
   };
 
 } // namespace art
@@ -0,0 +1,187 @@
+#include "art/Utilities/ResourceBudget.h"
+// vim: set sw=2 expandtab :
+
+#include "art/Utilities/detail/first_line.h"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <thread>
+
+extern "C" {
+#ifdef __linux__
+#include <sched.h>
+#endif
+#include <unistd.h>
+}
+
+namespace {
+
+  using art::detail::first_line;
+
+  std::string const cgroup_root{"/sys/fs/cgroup"};
+
+  // The directory of the (unified, version 2) cgroup of the process.
+  // Empty if the process is not in a version-2 hierarchy.
+  std::string
+  cgroup_directory()
+  {
+    std::ifstream in{"/proc/self/cgroup"};
+    std::string line;
+    while (std::getline(in, line)) {
+      if (line.compare(0, 3, "0::") == 0) {
+        auto const path = line.substr(3);
+        return path == "/" ? cgroup_root : cgroup_root + path;
+      }
+    }
+    return {};
+  }
+
+  // The limits of all enclosing cgroups apply, so the directories are
+  // visited from that of the process up to the root of the hierarchy.
+  template <typename F>
+  void
+  for_each_enclosing_cgroup(F f)
+  {
+    auto dir = cgroup_directory();
+    if (dir.empty()) {
+      return;
+    }
+    while (true) {
+      f(dir);
+      if (dir.size() <= cgroup_root.size()) {
+        return;
+      }
+      dir.erase(dir.rfind('/'));
+    }
+  }
+
+  // The number of cores' worth of CPU time the process may use per
+  // period; infinite if there is no quota.
+  double
+  cpu_quota()
+  {
+    auto result = std::numeric_limits<double>::infinity();
+    // Version 2: cpu.max holds "<quota> <period>", the quota being
+    // "max" if there is none.
+    for_each_enclosing_cgroup([&result](std::string const& dir) {
+      auto const line = first_line(dir + "/cpu.max");
+      auto const space = line.find(' ');
+      if (space == std::string::npos || line.compare(0, space, "max") == 0) {
+        return;
+      }
+      auto const quota = std::stod(line.substr(0, space));
+      auto const period = std::stod(line.substr(space + 1));
+      if (quota > 0. && period > 0.) {
+        result = std::min(result, quota / period);
+      }
+    });
+    if (!std::isinf(result)) {
+      return result;
+    }
+    // Version 1: a quota of -1 means there is none.
+    for (std::string const dir : {"/cpu", "/cpu,cpuacct"}) {
+      auto const quota = first_line(cgroup_root + dir + "/cpu.cfs_quota_us");
+      auto const period = first_line(cgroup_root + dir + "/cpu.cfs_period_us");
+      if (quota.empty() || period.empty() || quota[0] == '-') {
+        continue;
+      }
+      auto const p = std::stod(period);
+      if (p > 0.) {
+        result = std::min(result, std::stod(quota) / p);
+      }
+    }
+    return result;
+  }
+
+  // The memory limit of the cgroup in bytes, or zero if there is none.
+  std::size_t
+  memory_limit()
+  {
+    std::size_t result{};
+    auto tighten = [&result](std::string const& value) {
+      if (value.empty() || value == "max") {
+        return;
+      }
+      auto const limit = std::stoull(value);
+      if (result == 0u || limit < result) {
+        result = limit;
+      }
+    };
+    for_each_enclosing_cgroup([&tighten](std::string const& dir) {
+      tighten(first_line(dir + "/memory.max"));
+    });
+    if (result == 0u) {
+      // Version 1 reports a very large number if there is no limit;
+      // it is discarded by the comparison with the physical memory.
+      tighten(first_line(cgroup_root + "/memory/memory.limit_in_bytes"));
+    }
+    return result;
+  }
+
+} // namespace
+
+namespace art {
+
+  std::vector<unsigned>
+  allowed_cpus()
+  {
+    std::vector<unsigned> result;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+      for (unsigned cpu{}; cpu != CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) {
+          result.push_back(cpu);
+        }
+      }
+    }
+#endif
+    return result;
+  }
+
+  unsigned
+  available_cores()
+  {
+    auto const cpus = allowed_cpus();
+    unsigned cores = cpus.empty() ? std::thread::hardware_concurrency() :
+                                    static_cast<unsigned>(cpus.size());
+    try {
+      auto const quota = cpu_quota();
+      if (!std::isinf(quota)) {
+        cores = std::min(cores, static_cast<unsigned>(std::ceil(quota)));
+      }
+    }
+    catch (std::exception const&) {
+      // An unreadable quota is no quota.
+    }
+    return std::max(cores, 1u);
+  }
+
+  std::size_t
+  available_memory()
+  {
+    auto const pages = sysconf(_SC_PHYS_PAGES);
+    auto const page_size = sysconf(_SC_PAGESIZE);
+    std::size_t const physical =
+      (pages > 0 && page_size > 0) ?
+        static_cast<std::size_t>(pages) * static_cast<std::size_t>(page_size) :
+        0u;
+    std::size_t limit{};
+    try {
+      limit = memory_limit();
+    }
+    catch (std::exception const&) {
+      // An unreadable limit is no limit.
+    }
+    if (limit == 0u || (physical != 0u && limit > physical)) {
+      return physical;
+    }
+    return limit;
+  }
+
+} // namespace art
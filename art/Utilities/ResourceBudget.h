@@ -0,0 +1,40 @@
+#ifndef art_Utilities_ResourceBudget_h
+#define art_Utilities_ResourceBudget_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// ResourceBudget
+//
+// The processor and memory resources the job may actually use.  In a
+// batch slot or a container these are often much smaller than what
+// the hardware provides: the process may be restricted to a subset
+// of the cores by its affinity mask, and its cgroup may impose a CPU
+// quota and a memory limit.
+// ======================================================================
+
+#include <cstddef>
+#include <vector>
+
+namespace art {
+
+  // The CPUs in the affinity mask of the process, in increasing order.
+  // Empty if the mask cannot be determined.
+  std::vector<unsigned> allowed_cpus();
+
+  // The number of cores the process may keep busy: the smaller of the
+  // number of cores in its affinity mask and the CPU quota of its
+  // cgroup (rounded up).  Never less than one.
+  unsigned available_cores();
+
+  // The memory (in bytes) available to the process: the memory limit
+  // of its cgroup, if any, otherwise the physical memory.  Zero if
+  // neither can be determined.
+  std::size_t available_memory();
+
+} // namespace art
+
+#endif /* art_Utilities_ResourceBudget_h */
+
+// Local Variables:
+// mode: c++
+// End:
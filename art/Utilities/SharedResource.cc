@@ -100,6 +100,13 @@ namespace art::detail {
       }) |
       to<std::vector>();
 
+    statistics_ = sortedResources_ | views::keys |
+                  views::transform([](auto const& key) {
+                    return std::pair{
+                      key, std::make_shared<SerialQueueStatistics>()};
+                  }) |
+                  to<std::vector>();
+
     // Not needed any more now that we have a sorted list of resources.
     resourceCounts_.clear();
   }
@@ -130,4 +137,30 @@ namespace art::detail {
     return result;
   }
 
+  std::vector<std::shared_ptr<SerialQueueStatistics>>
+  SharedResources::queueStatistics(
+    std::vector<std::string> const& resourceNames) const
+  {
+    using namespace ranges;
+    if (cet::search_all(resourceNames, LegacyResource.name)) {
+      return statistics_ | views::values | to<std::vector>();
+    }
+    std::vector<std::shared_ptr<SerialQueueStatistics>> result;
+    for (auto const& name : resourceNames) {
+      auto it =
+        std::find_if(begin(statistics_),
+                     end(statistics_),
+                     [&name](auto const& pr) { return pr.first == name; });
+      assert(it != statistics_.end());
+      result.push_back(it->second);
+    }
+    return result;
+  }
+
+  std::vector<std::pair<std::string, SharedResources::statistics_ptr_t>> const&
+  SharedResources::resourceStatistics() const
+  {
+    return statistics_;
+  }
+
 } // namespace art
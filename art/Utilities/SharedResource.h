@@ -3,7 +3,11 @@
 
 #include "hep_concurrency/SerialTaskQueue.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <typeinfo>
@@ -28,6 +32,104 @@ namespace art {
 // =====================================================================
 
 namespace art::detail {
+
+  // Contention statistics for the tasks that go through one serial
+  // task queue, or through the queues of one serialized module.  The
+  // depth is the number of tasks that have been queued but have not
+  // yet started.
+  class SerialQueueStatistics {
+  public:
+    using duration = std::chrono::steady_clock::duration;
+
+    void
+    enqueued() noexcept
+    {
+      ++tasks_;
+      auto const depth = ++depth_;
+      auto max = maxDepth_.load();
+      while (max < depth && !maxDepth_.compare_exchange_weak(max, depth)) {
+      }
+    }
+
+    void
+    started(duration const wait) noexcept
+    {
+      --depth_;
+      waitTime_ += wait.count();
+    }
+
+    void
+    finished(duration const run) noexcept
+    {
+      runTime_ += run.count();
+    }
+
+    std::uint64_t
+    tasks() const noexcept
+    {
+      return tasks_.load();
+    }
+
+    unsigned
+    maxDepth() const noexcept
+    {
+      return maxDepth_.load();
+    }
+
+    duration
+    waitTime() const noexcept
+    {
+      return duration{waitTime_.load()};
+    }
+
+    duration
+    runTime() const noexcept
+    {
+      return duration{runTime_.load()};
+    }
+
+  private:
+    std::atomic<std::uint64_t> tasks_{};
+    std::atomic<unsigned> depth_{};
+    std::atomic<unsigned> maxDepth_{};
+    std::atomic<duration::rep> waitTime_{};
+    std::atomic<duration::rep> runTime_{};
+  };
+
+  // The statistics of a serialized module, and of each of the
+  // resource queues on which it has been chained.
+  struct SerializationStatistics {
+    void
+    enqueued() noexcept
+    {
+      module.enqueued();
+      for (auto const& r : resources) {
+        r->enqueued();
+      }
+    }
+
+    void
+    started(SerialQueueStatistics::duration const wait) noexcept
+    {
+      module.started(wait);
+      for (auto const& r : resources) {
+        r->started(wait);
+      }
+    }
+
+    void
+    finished(SerialQueueStatistics::duration const run) noexcept
+    {
+      module.finished(run);
+      for (auto const& r : resources) {
+        r->finished(run);
+      }
+    }
+
+    SerialQueueStatistics module{};
+    std::vector<std::shared_ptr<SerialQueueStatistics>> resources{};
+  };
+
   class SharedResources {
   public:
     SharedResources();
@@ -40,12 +142,22 @@ namespace art::detail {
     std::vector<queue_ptr_t> createQueues(
       std::vector<std::string> const& resourceNames) const;
 
+    // The statistics of the queues returned by createQueues for the
+    // same resource names.
+    using statistics_ptr_t = std::shared_ptr<SerialQueueStatistics>;
+    std::vector<statistics_ptr_t> queueStatistics(
+      std::vector<std::string> const& resourceNames) const;
+    std::vector<std::pair<std::string, statistics_ptr_t>> const&
+    resourceStatistics() const;
+
   private:
     void register_resource(std::string const& name);
     void ensure_not_frozen(std::string const& name);
 
     std::map<std::string, unsigned> resourceCounts_;
     std::vector<std::pair<std::string, queue_ptr_t>> sortedResources_;
+    // In the same order as sortedResources_.
+    std::vector<std::pair<std::string, statistics_ptr_t>> statistics_;
     bool frozen_{false};
     unsigned nLegacy_{};
   };
@@ -0,0 +1,159 @@
+#include "art/Utilities/ThreadPinning.h"
+// vim: set sw=2 expandtab :
+
+#include "art/Utilities/ResourceBudget.h"
+#include "art/Utilities/detail/cpu_list.h"
+#include "art/Utilities/detail/first_line.h"
+#include "canvas/Utilities/Exception.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include <algorithm>
+
+extern "C" {
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+}
+
+namespace {
+
+  using art::detail::first_line;
+
+  // Hardware threads of the same core are listed as siblings; the
+  // position of a CPU among its siblings orders the allowed CPUs so
+  // that every physical core is used once before any is used twice.
+  std::vector<std::vector<unsigned>>
+  core_slots(std::vector<unsigned> const& allowed)
+  {
+    std::vector<std::pair<std::size_t, unsigned>> ranked;
+    for (auto const cpu : allowed) {
+      auto const siblings = art::detail::parse_cpu_list(
+        first_line("/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                   "/topology/thread_siblings_list"));
+      auto const pos = std::find(cbegin(siblings), cend(siblings), cpu);
+      std::size_t const rank =
+        pos == cend(siblings) ? 0 : pos - cbegin(siblings);
+      ranked.emplace_back(rank, cpu);
+    }
+    std::stable_sort(begin(ranked), end(ranked));
+    std::vector<std::vector<unsigned>> result;
+    for (auto const& [rank, cpu] : ranked) {
+      result.push_back({cpu});
+    }
+    return result;
+  }
+
+  // The allowed CPUs of each NUMA node that has any.
+  std::vector<std::vector<unsigned>>
+  numa_slots(std::vector<unsigned> const& allowed)
+  {
+    auto const nodes = art::detail::parse_cpu_list(
+      first_line("/sys/devices/system/node/online"));
+    std::vector<std::vector<unsigned>> result;
+    for (auto const node : nodes) {
+      auto cpus = art::detail::parse_cpu_list(
+        first_line("/sys/devices/system/node/node" + std::to_string(node) +
+                   "/cpulist"));
+      cpus.erase(std::remove_if(begin(cpus),
+                                end(cpus),
+                                [&allowed](unsigned const cpu) {
+                                  return !std::binary_search(
+                                    cbegin(allowed), cend(allowed), cpu);
+                                }),
+                 end(cpus));
+      if (!cpus.empty()) {
+        result.push_back(std::move(cpus));
+      }
+    }
+    return result;
+  }
+
+  std::vector<std::vector<unsigned>>
+  make_slots(art::ThreadPinning const pinning)
+  {
+    auto const allowed = art::allowed_cpus();
+    if (allowed.empty()) {
+      return {};
+    }
+    try {
+      switch (pinning) {
+      case art::ThreadPinning::cores:
+        return core_slots(allowed);
+      case art::ThreadPinning::numa:
+        return numa_slots(allowed);
+      case art::ThreadPinning::none:
+        break;
+      }
+    }
+    catch (art::Exception const& e) {
+      mf::LogWarning("MTconfig")
+        << "The CPU topology could not be read; threads are not pinned.\n"
+        << e.what();
+    }
+    return {};
+  }
+
+} // namespace
+
+namespace art {
+
+  ThreadPinning
+  thread_pinning(std::string const& name)
+  {
+    if (name == "none") {
+      return ThreadPinning::none;
+    }
+    if (name == "cores") {
+      return ThreadPinning::cores;
+    }
+    if (name == "numa") {
+      return ThreadPinning::numa;
+    }
+    throw Exception{errors::Configuration}
+      << "Unknown thread pinning '" << name
+      << "'; the supported values are 'none', 'cores', and 'numa'.\n";
+  }
+
+  ThreadPinningObserver::ThreadPinningObserver(ThreadPinning const pinning)
+    : slots_{make_slots(pinning)}
+  {
+    if (!slots_.empty()) {
+      observe(true);
+    }
+  }
+
+  ThreadPinningObserver::~ThreadPinningObserver()
+  {
+    if (!slots_.empty()) {
+      observe(false);
+    }
+  }
+
+  // A worker enters the arena many times over its life, but is pinned
+  // only the first time.
+  void
+  ThreadPinningObserver::on_scheduler_entry(bool const is_worker)
+  {
+    if (!is_worker) {
+      return;
+    }
+    std::size_t slot{};
+    {
+      std::lock_guard sentry{mutex_};
+      if (!pinned_.insert(std::this_thread::get_id()).second) {
+        return;
+      }
+      slot = next_++ % slots_.size();
+    }
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto const cpu : slots_[slot]) {
+      CPU_SET(cpu, &set);
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+  }
+
+} // namespace art
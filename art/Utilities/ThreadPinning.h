@@ -0,0 +1,64 @@
+#ifndef art_Utilities_ThreadPinning_h
+#define art_Utilities_ThreadPinning_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// ThreadPinning
+//
+// Binds each worker thread of the TBB task scheduler, when it first
+// enters the arena, to one of the CPUs the process may use (one
+// hardware thread of each physical core first, then their siblings)
+// or to all CPUs of one NUMA node.  The threads are spread over the
+// CPUs or nodes in turn.  The main thread is not pinned.
+//
+// Pinning is only supported on Linux; elsewhere the observer does
+// nothing.
+// ======================================================================
+
+#include "tbb/task_scheduler_observer.h"
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace art {
+
+  enum class ThreadPinning { none, cores, numa };
+
+  // Throws for an unknown name.
+  ThreadPinning thread_pinning(std::string const& name);
+
+  class ThreadPinningObserver : public tbb::task_scheduler_observer {
+  public:
+    explicit ThreadPinningObserver(ThreadPinning);
+    ~ThreadPinningObserver() override;
+
+    ThreadPinningObserver(ThreadPinningObserver const&) = delete;
+    ThreadPinningObserver& operator=(ThreadPinningObserver const&) = delete;
+
+    // The sets of CPUs that the threads are pinned to, in turn.
+    std::vector<std::vector<unsigned>> const&
+    slots() const noexcept
+    {
+      return slots_;
+    }
+
+  private:
+    void on_scheduler_entry(bool is_worker) override;
+
+    std::vector<std::vector<unsigned>> const slots_;
+    std::mutex mutex_{};
+    std::unordered_set<std::thread::id> pinned_{};
+    std::size_t next_{};
+  };
+
+} // namespace art
+
+#endif /* art_Utilities_ThreadPinning_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,57 @@
+#include "art/Utilities/ThreadPoolObserver.h"
+// vim: set sw=2 expandtab :
+
+#include <algorithm>
+
+namespace art {
+
+  ThreadPoolObserver::ThreadPoolObserver() { observe(true); }
+
+  ThreadPoolObserver::~ThreadPoolObserver() { observe(false); }
+
+  // Entries and exits happen when a thread joins or leaves the arena,
+  // not for each task, so that a mutex is good enough.
+  void
+  ThreadPoolObserver::on_scheduler_entry(bool)
+  {
+    auto const now = clock_type::now();
+    std::lock_guard sentry{mutex_};
+    auto& times = threads_[std::this_thread::get_id()];
+    if (times.inside) {
+      return;
+    }
+    times.entered = now;
+    times.inside = true;
+    maxConcurrent_ = std::max(maxConcurrent_, ++concurrent_);
+  }
+
+  void
+  ThreadPoolObserver::on_scheduler_exit(bool)
+  {
+    auto const now = clock_type::now();
+    std::lock_guard sentry{mutex_};
+    auto& times = threads_[std::this_thread::get_id()];
+    if (!times.inside) {
+      return;
+    }
+    times.inArena += now - times.entered;
+    times.inside = false;
+    --concurrent_;
+  }
+
+  ThreadPoolObserver::Summary
+  ThreadPoolObserver::summary() const
+  {
+    auto const now = clock_type::now();
+    std::lock_guard sentry{mutex_};
+    Summary result{threads_.size(), maxConcurrent_, {}, now - start_};
+    for (auto const& [id, times] : threads_) {
+      result.inArena += times.inArena;
+      if (times.inside) {
+        result.inArena += now - times.entered;
+      }
+    }
+    return result;
+  }
+
+} // namespace art
@@ -0,0 +1,72 @@
+#ifndef art_Utilities_ThreadPoolObserver_h
+#define art_Utilities_ThreadPoolObserver_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// ThreadPoolObserver
+//
+// Follows the threads of the TBB task scheduler from construction to
+// destruction, accumulating the time they spend in the task arena,
+// i.e. executing tasks or looking for one to execute.  A thread
+// leaves the arena once it has found no work for a while, so that the
+// time in the arena is an upper bound on the time spent executing.
+// ======================================================================
+
+#include "tbb/task_scheduler_observer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace art {
+
+  class ThreadPoolObserver : public tbb::task_scheduler_observer {
+  public:
+    using clock_type = std::chrono::steady_clock;
+
+    struct Summary {
+      // Number of distinct threads that entered the arena.
+      std::size_t threads;
+      // Largest number of threads in the arena at the same time.
+      std::size_t maxConcurrent;
+      // Time spent in the arena, summed over the threads.
+      clock_type::duration inArena;
+      // Time since the observer was created.
+      clock_type::duration observed;
+    };
+
+    ThreadPoolObserver();
+    ~ThreadPoolObserver() override;
+
+    ThreadPoolObserver(ThreadPoolObserver const&) = delete;
+    ThreadPoolObserver& operator=(ThreadPoolObserver const&) = delete;
+
+    Summary summary() const;
+
+  private:
+    void on_scheduler_entry(bool is_worker) override;
+    void on_scheduler_exit(bool is_worker) override;
+
+    struct ThreadTimes {
+      clock_type::time_point entered{};
+      clock_type::duration inArena{};
+      bool inside{false};
+    };
+
+    clock_type::time_point const start_{clock_type::now()};
+    mutable std::mutex mutex_{};
+    std::unordered_map<std::thread::id, ThreadTimes> threads_{};
+    std::size_t concurrent_{};
+    std::size_t maxConcurrent_{};
+  };
+
+} // namespace art
+
+#endif /* art_Utilities_ThreadPoolObserver_h */
+
+// Local Variables:
+// mode: c++
+// End:
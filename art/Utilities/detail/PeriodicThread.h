@@ -0,0 +1,97 @@
+#ifndef art_Utilities_detail_PeriodicThread_h
+#define art_Utilities_detail_PeriodicThread_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// PeriodicThread
+//
+// A background thread that calls a function once when it starts and
+// then again after each interval, until it is stopped.  It is used by
+// services that drain per-thread ring buffers or sample the process
+// off the event loop.  An exception thrown by the function ends the
+// thread; it is kept so that it can be rethrown, e.g. from the
+// postEndJob callback of the service, by stopAndRethrow().
+// ======================================================================
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace art::detail {
+
+  class PeriodicThread {
+  public:
+    PeriodicThread(std::chrono::steady_clock::duration const interval,
+                   std::function<void()> work)
+      : interval_{interval}, work_{std::move(work)}
+    {
+      thread_ = std::thread{[this] { run_(); }};
+    }
+
+    ~PeriodicThread() { stop(); }
+
+    PeriodicThread(PeriodicThread const&) = delete;
+    PeriodicThread& operator=(PeriodicThread const&) = delete;
+
+    // Waits for a call of the function in progress, if any, to return.
+    void
+    stop() noexcept
+    {
+      if (!thread_.joinable()) {
+        return;
+      }
+      {
+        std::lock_guard sentry{mutex_};
+        stopping_ = true;
+      }
+      condition_.notify_one();
+      thread_.join();
+    }
+
+    void
+    stopAndRethrow()
+    {
+      stop();
+      if (exception_) {
+        std::rethrow_exception(exception_);
+      }
+    }
+
+  private:
+    void
+    run_()
+    {
+      try {
+        std::unique_lock lock{mutex_};
+        while (!stopping_) {
+          lock.unlock();
+          work_();
+          lock.lock();
+          condition_.wait_for(lock, interval_, [this] { return stopping_; });
+        }
+      }
+      catch (...) {
+        exception_ = std::current_exception();
+      }
+    }
+
+    std::chrono::steady_clock::duration const interval_;
+    std::function<void()> const work_;
+    std::mutex mutex_{};
+    std::condition_variable condition_{};
+    bool stopping_{false};
+    std::exception_ptr exception_{};
+    std::thread thread_{};
+  };
+
+} // namespace art::detail
+
+#endif /* art_Utilities_detail_PeriodicThread_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,95 @@
+#ifndef art_Utilities_detail_SPSCRingBuffer_h
+#define art_Utilities_detail_SPSCRingBuffer_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// SPSCRingBuffer
+//
+// A fixed-capacity, lock-free ring of trivially copyable records with
+// exactly one producing thread and at most one consuming thread at a
+// time.  The capacity is rounded up to a power of two.  A push onto a
+// full ring fails rather than blocks; it is then up to the producer
+// to decide what to do with the record.
+// ======================================================================
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace art::detail {
+
+  template <typename T>
+  class SPSCRingBuffer {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+  public:
+    explicit SPSCRingBuffer(std::size_t const capacity)
+      : mask_{round_up(capacity) - 1}, records_{new T[mask_ + 1]}
+    {}
+
+    SPSCRingBuffer(SPSCRingBuffer const&) = delete;
+    SPSCRingBuffer& operator=(SPSCRingBuffer const&) = delete;
+
+    std::size_t
+    capacity() const noexcept
+    {
+      return mask_ + 1;
+    }
+
+    // Called only by the producing thread.
+    bool
+    try_push(T const& record) noexcept
+    {
+      auto const tail = tail_.load(std::memory_order_relaxed);
+      if (tail - head_.load(std::memory_order_acquire) > mask_) {
+        return false;
+      }
+      records_[tail & mask_] = record;
+      tail_.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    // Called only by the consuming thread.  Hands each record that
+    // was pushed before the call to the function, oldest first, and
+    // returns how many there were.
+    template <typename F>
+    std::size_t
+    drain(F f)
+    {
+      auto head = head_.load(std::memory_order_relaxed);
+      auto const tail = tail_.load(std::memory_order_acquire);
+      auto const n = tail - head;
+      for (; head != tail; ++head) {
+        f(records_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+      }
+      return n;
+    }
+
+  private:
+    static constexpr std::size_t
+    round_up(std::size_t const n) noexcept
+    {
+      std::size_t result{1};
+      while (result < n) {
+        result <<= 1;
+      }
+      return result;
+    }
+
+    // The two indices only ever increase; they are kept on separate
+    // cache lines so that producer and consumer do not contend.
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    std::size_t const mask_;
+    std::unique_ptr<T[]> const records_;
+  };
+
+} // namespace art::detail
+
+#endif /* art_Utilities_detail_SPSCRingBuffer_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,64 @@
+#ifndef art_Utilities_detail_SpanStarts_h
+#define art_Utilities_detail_SpanStarts_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// SpanStarts
+//
+// The start times of the spans (e.g. module invocations) open on one
+// thread, for code that times them from their pre- and post- signals.
+// Both signals of a span are emitted on the same thread, but spans of
+// other schedules may open on the thread while one waits, so the
+// starts form a stack.  A span whose post- signal is never emitted
+// (because of an exception) is dropped once a span below it on the
+// stack is closed.
+// ======================================================================
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+namespace art::detail {
+
+  template <typename Time>
+  class SpanStarts {
+  public:
+    // The key identifies the span, e.g. by the module description.
+    void
+    open(void const* key, Time const start)
+    {
+      starts_.push_back(Start{key, start});
+    }
+
+    // Returns the start of the span, or nothing if it is not open.
+    std::optional<Time>
+    close(void const* key)
+    {
+      auto const it =
+        std::find_if(starts_.rbegin(), starts_.rend(), [key](auto const& s) {
+          return s.key == key;
+        });
+      if (it == starts_.rend()) {
+        return std::nullopt;
+      }
+      auto const start = it->start;
+      starts_.erase(std::prev(it.base()), starts_.end());
+      return start;
+    }
+
+  private:
+    struct Start {
+      void const* key;
+      Time start;
+    };
+    std::vector<Start> starts_{};
+  };
+
+} // namespace art::detail
+
+#endif /* art_Utilities_detail_SpanStarts_h */
+
+// Local Variables:
+// mode: c++
+// End:
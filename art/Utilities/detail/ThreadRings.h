@@ -0,0 +1,70 @@
+#ifndef art_Utilities_detail_ThreadRings_h
+#define art_Utilities_detail_ThreadRings_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// ThreadRings
+//
+// The per-thread data (typically holding an SPSCRingBuffer) of the
+// threads that record into a service, together with the list of all
+// of them, so that a single consumer, e.g. a PeriodicThread, can
+// drain the rings of every thread.  The data of a thread are created
+// on its first call to local(), which is the only call that locks;
+// they live as long as the ThreadRings object.
+// ======================================================================
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace art::detail {
+
+  template <typename T>
+  class ThreadRings {
+  public:
+    // Returns the data of the calling thread, created by make() if
+    // the thread has none yet.
+    template <typename Make>
+    T&
+    local(Make make)
+    {
+      auto& data = data_.local();
+      if (!data) {
+        data = make();
+        std::lock_guard sentry{mutex_};
+        all_.push_back(data.get());
+      }
+      return *data;
+    }
+
+    // Calls f with the data of each thread that has created them.
+    // The data of threads that are still recording may be passed.
+    template <typename F>
+    void
+    for_each(F f)
+    {
+      std::vector<T*> all;
+      {
+        std::lock_guard sentry{mutex_};
+        all = all_;
+      }
+      for (auto const data : all) {
+        f(*data);
+      }
+    }
+
+  private:
+    tbb::enumerable_thread_specific<std::unique_ptr<T>> data_{};
+    std::mutex mutex_{};
+    std::vector<T*> all_{};
+  };
+
+} // namespace art::detail
+
+#endif /* art_Utilities_detail_ThreadRings_h */
+
+// Local Variables:
+// mode: c++
+// End:
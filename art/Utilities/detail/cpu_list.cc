@@ -0,0 +1,35 @@
+#include "art/Utilities/detail/cpu_list.h"
+
+#include "canvas/Utilities/Exception.h"
+
+#include <sstream>
+
+std::vector<unsigned>
+art::detail::parse_cpu_list(std::string const& list)
+{
+  std::vector<unsigned> result;
+  std::istringstream in{list};
+  std::string range;
+  while (std::getline(in, range, ',')) {
+    if (range.empty() || range == "\n") {
+      continue;
+    }
+    std::istringstream r{range};
+    unsigned first{};
+    unsigned last{};
+    char dash{};
+    if (!(r >> first)) {
+      throw Exception{errors::Configuration}
+        << "Malformed CPU list '" << list << "'.\n";
+    }
+    last = first;
+    if (r >> dash && (dash != '-' || !(r >> last) || last < first)) {
+      throw Exception{errors::Configuration}
+        << "Malformed CPU list '" << list << "'.\n";
+    }
+    for (auto cpu = first; cpu <= last; ++cpu) {
+      result.push_back(cpu);
+    }
+  }
+  return result;
+}
@@ -0,0 +1,17 @@
+#ifndef art_Utilities_detail_cpu_list_h
+#define art_Utilities_detail_cpu_list_h
+
+#include <string>
+#include <vector>
+
+namespace art::detail {
+  // Parses a CPU list in the format of the Linux sysfs and cgroup
+  // files (e.g. "0-3,8,10-11"); throws for a malformed list.
+  std::vector<unsigned> parse_cpu_list(std::string const& list);
+}
+
+#endif /* art_Utilities_detail_cpu_list_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,12 @@
+#include "art/Utilities/detail/first_line.h"
+
+#include <fstream>
+
+std::string
+art::detail::first_line(std::string const& file_name)
+{
+  std::ifstream in{file_name};
+  std::string line;
+  std::getline(in, line);
+  return line;
+}
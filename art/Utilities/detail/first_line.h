@@ -0,0 +1,16 @@
+#ifndef art_Utilities_detail_first_line_h
+#define art_Utilities_detail_first_line_h
+
+#include <string>
+
+namespace art::detail {
+  // The first line of the file, or an empty string if it cannot be
+  // read.
+  std::string first_line(std::string const& file_name);
+}
+
+#endif /* art_Utilities_detail_first_line_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,56 @@
+// ======================================================================
+//
+// BenchAnalyzer: Synthetic analyzer for the benchmark suite.  Each
+// event, it reads its inputs and spends the configured CPU time.
+//
+// ======================================================================
+
+#include "art/Framework/Core/SharedAnalyzer.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/test/Benchmarks/BenchmarkWork.h"
+#include "canvas/Utilities/InputTag.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Sequence.h"
+
+#include <vector>
+
+using namespace fhicl;
+
+namespace arttest {
+
+  class BenchAnalyzer : public art::SharedAnalyzer {
+  public:
+    struct Config {
+      Atom<double> work{Name{"work"},
+                        Comment{"CPU time (in microseconds) spent per event."},
+                        0.};
+      Sequence<art::InputTag> inputs{
+        Name{"inputs"},
+        Comment{"Products of other benchmark modules read per event."},
+        std::vector<art::InputTag>{}};
+    };
+    using Parameters = Table<Config>;
+    explicit BenchAnalyzer(Parameters const& p, art::ProcessingFrame const&)
+      : SharedAnalyzer{p}, work_{p().work()}, inputs_{p().inputs()}
+    {
+      for (auto const& tag : inputs_) {
+        consumes<benchmark::product_t>(tag);
+      }
+      async<art::InEvent>();
+    }
+
+  private:
+    void
+    analyze(art::Event const& e, art::ProcessingFrame const&) override
+    {
+      benchmark::readInputs(e, inputs_);
+      benchmark::burn(work_);
+    }
+
+    double const work_;
+    std::vector<art::InputTag> const inputs_;
+  };
+
+} // namespace arttest
+
+DEFINE_ART_MODULE(arttest::BenchAnalyzer)
@@ -0,0 +1,72 @@
+// ======================================================================
+//
+// BenchFilter: Synthetic filter for the benchmark suite.  Each event,
+// it reads its inputs, spends the configured CPU time and accepts a
+// deterministic fraction of the events.
+//
+// ======================================================================
+
+#include "art/Framework/Core/SharedFilter.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/test/Benchmarks/BenchmarkWork.h"
+#include "canvas/Utilities/InputTag.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Sequence.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace fhicl;
+
+namespace arttest {
+
+  class BenchFilter : public art::SharedFilter {
+  public:
+    struct Config {
+      Atom<double> work{Name{"work"},
+                        Comment{"CPU time (in microseconds) spent per event."},
+                        0.};
+      Atom<double> acceptFraction{
+        Name{"acceptFraction"},
+        Comment{"Fraction of the events that are accepted."},
+        1.};
+      Sequence<art::InputTag> inputs{
+        Name{"inputs"},
+        Comment{"Products of other benchmark modules read per event."},
+        std::vector<art::InputTag>{}};
+    };
+    using Parameters = Table<Config>;
+    explicit BenchFilter(Parameters const& p, art::ProcessingFrame const&)
+      : SharedFilter{p}
+      , work_{p().work()}
+      , acceptFraction_{p().acceptFraction()}
+      , inputs_{p().inputs()}
+    {
+      for (auto const& tag : inputs_) {
+        consumes<benchmark::product_t>(tag);
+      }
+      async<art::InEvent>();
+    }
+
+  private:
+    bool
+    filter(art::Event& e, art::ProcessingFrame const&) override
+    {
+      benchmark::readInputs(e, inputs_);
+      benchmark::burn(work_);
+      // The golden-ratio sequence spreads the accepted events evenly
+      // without depending on the order in which events arrive.
+      double integral_part{};
+      auto const x =
+        std::modf(e.event() * 0.6180339887498949, &integral_part);
+      return x < acceptFraction_;
+    }
+
+    double const work_;
+    double const acceptFraction_;
+    std::vector<art::InputTag> const inputs_;
+  };
+
+} // namespace arttest
+
+DEFINE_ART_MODULE(arttest::BenchFilter)
@@ -0,0 +1,61 @@
+// ======================================================================
+//
+// BenchOutput: Synthetic output module for the benchmark suite.  Each
+// event, it retrieves every kept product and spends the configured CPU
+// time per product retrieved, standing in for serialization.
+//
+// ======================================================================
+
+#include "art/Framework/Core/OutputModule.h"
+#include "art/Framework/Principal/EventPrincipal.h"
+#include "art/Framework/Principal/OutputHandle.h"
+#include "art/test/Benchmarks/BenchmarkWork.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/ConfigurationTable.h"
+#include "fhiclcpp/types/TableFragment.h"
+
+using namespace art;
+
+namespace arttest {
+
+  class BenchOutput final : public OutputModule {
+  public:
+    struct Config {
+      fhicl::TableFragment<OutputModule::Config> omConfig;
+      fhicl::Atom<double> workPerProduct{
+        fhicl::Name{"workPerProduct"},
+        fhicl::Comment{"CPU time (in microseconds) spent per product written."},
+        0.};
+    };
+
+    using Parameters =
+      fhicl::WrappedTable<Config, OutputModule::Config::KeysToIgnore>;
+    explicit BenchOutput(Parameters const& ps)
+      : OutputModule{ps().omConfig}, workPerProduct_{ps().workPerProduct()}
+    {}
+
+  private:
+    void
+    write(EventPrincipal& ep) override
+    {
+      for (auto const& pr : keptProducts()[InEvent]) {
+        if (ep.getForOutput(pr.first, true).isValid()) {
+          benchmark::burn(workPerProduct_);
+        }
+      }
+    }
+
+    void
+    writeSubRun(SubRunPrincipal&) override
+    {}
+
+    void
+    writeRun(RunPrincipal&) override
+    {}
+
+    double const workPerProduct_;
+  };
+
+} // namespace arttest
+
+DEFINE_ART_MODULE(arttest::BenchOutput)
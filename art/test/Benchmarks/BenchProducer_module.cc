@@ -0,0 +1,81 @@
+// ======================================================================
+//
+// BenchProducer: Synthetic producer for the benchmark suite.  Each
+// event, it reads its inputs, spends the configured CPU time and puts
+// 'fanOut' products of 'productSize' doubles each.
+//
+// ======================================================================
+
+#include "art/Framework/Core/SharedProducer.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/test/Benchmarks/BenchmarkWork.h"
+#include "canvas/Utilities/InputTag.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Sequence.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fhicl;
+
+namespace arttest {
+
+  class BenchProducer : public art::SharedProducer {
+  public:
+    struct Config {
+      Atom<double> work{Name{"work"},
+                        Comment{"CPU time (in microseconds) spent per event."},
+                        0.};
+      Atom<unsigned> productSize{
+        Name{"productSize"},
+        Comment{"Number of doubles in each product."},
+        1u};
+      Atom<unsigned> fanOut{
+        Name{"fanOut"},
+        Comment{"Number of products put per event.  The products have\n"
+                "the instance names \"p0\", \"p1\", etc."},
+        1u};
+      Sequence<art::InputTag> inputs{
+        Name{"inputs"},
+        Comment{"Products of other benchmark modules read per event."},
+        std::vector<art::InputTag>{}};
+    };
+    using Parameters = Table<Config>;
+    explicit BenchProducer(Parameters const& p, art::ProcessingFrame const&)
+      : SharedProducer{p}
+      , work_{p().work()}
+      , productSize_{p().productSize()}
+      , inputs_{p().inputs()}
+    {
+      for (auto const& tag : inputs_) {
+        consumes<benchmark::product_t>(tag);
+      }
+      for (unsigned i{}; i != p().fanOut(); ++i) {
+        instances_.push_back("p" + std::to_string(i));
+        produces<benchmark::product_t>(instances_.back());
+      }
+      async<art::InEvent>();
+    }
+
+  private:
+    void
+    produce(art::Event& e, art::ProcessingFrame const&) override
+    {
+      auto const seed = benchmark::readInputs(e, inputs_);
+      benchmark::burn(work_);
+      for (auto const& instance : instances_) {
+        e.put(std::make_unique<benchmark::product_t>(productSize_, seed + 1.),
+              instance);
+      }
+    }
+
+    double const work_;
+    unsigned const productSize_;
+    std::vector<art::InputTag> const inputs_;
+    std::vector<std::string> instances_{};
+  };
+
+} // namespace arttest
+
+DEFINE_ART_MODULE(arttest::BenchProducer)
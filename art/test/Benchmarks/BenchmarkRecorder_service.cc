@@ -0,0 +1,186 @@
+// ======================================================================
+//
+// BenchmarkRecorder: Measures the event throughput of a benchmark job
+// and the time per event that is spent outside of module code.  At the
+// end of the job, one JSON object is appended, as a single line, to
+// the configured file.
+//
+// The framework overhead of an event is the time from the source
+// starting to create the event until all modules have finished with
+// it, less the time spent in module and output code for that event.
+// When modules on different paths run concurrently for the same event,
+// their time can exceed the latency of the event; such events
+// contribute no overhead, so that the reported value is a lower bound.
+//
+// ======================================================================
+
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceDeclarationMacros.h"
+#include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
+#include "art/Framework/Services/Registry/ServiceTable.h"
+#include "art/Persistency/Provenance/ModuleContext.h"
+#include "art/Persistency/Provenance/ScheduleContext.h"
+#include "art/Utilities/Globals.h"
+#include "art/Utilities/PerScheduleContainer.h"
+#include "art/Utilities/detail/SpanStarts.h"
+#include "canvas/Utilities/Exception.h"
+#include "fhiclcpp/types/Atom.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+using namespace fhicl;
+
+namespace {
+  // Start times of the modules running on this thread.
+  thread_local art::detail::SpanStarts<steady_clock::time_point> workStarts;
+
+  double
+  in_seconds(steady_clock::rep const ticks)
+  {
+    return duration<double>{steady_clock::duration{ticks}}.count();
+  }
+} // namespace
+
+namespace arttest {
+
+  class BenchmarkRecorder {
+  public:
+    struct Config {
+      Atom<std::string> fileName{
+        Name{"fileName"},
+        Comment{"Name of the file to which the results are appended."},
+        "benchmark.json"};
+      Atom<std::string> label{
+        Name{"label"},
+        Comment{"Name of the benchmark, copied into the results."},
+        ""};
+    };
+    using Parameters = art::ServiceTable<Config>;
+    BenchmarkRecorder(Parameters const&, art::ActivityRegistry&);
+
+  private:
+    struct ScheduleData {
+      steady_clock::time_point eventStart{};
+      std::atomic<steady_clock::rep> workTime{};
+    };
+
+    void preSourceEvent(art::ScheduleContext);
+    void postProcessEvent(art::ScheduleContext);
+    void startWork(art::ModuleContext const&);
+    void stopWork(art::ModuleContext const&);
+    void writeResults();
+
+    std::string const fileName_;
+    std::string const label_;
+    art::PerScheduleContainer<ScheduleData> schedules_;
+    std::once_flag loopStarted_{};
+    steady_clock::time_point loopStart_{};
+    std::atomic<steady_clock::rep> loopStop_{};
+    std::atomic<std::size_t> events_{};
+    std::atomic<steady_clock::rep> workTime_{};
+    std::atomic<steady_clock::rep> overheadTime_{};
+  };
+
+  BenchmarkRecorder::BenchmarkRecorder(Parameters const& config,
+                                       art::ActivityRegistry& areg)
+    : fileName_{config().fileName()}
+    , label_{config().label()}
+    , schedules_(art::Globals::instance()->nschedules())
+  {
+    areg.sPreSourceEvent.watch(this, &BenchmarkRecorder::preSourceEvent);
+    areg.sPostProcessEvent.watch(
+      [this](art::Event const&, art::ScheduleContext const sc) {
+        postProcessEvent(sc);
+      });
+    areg.sPreModule.watch(this, &BenchmarkRecorder::startWork);
+    areg.sPostModule.watch(this, &BenchmarkRecorder::stopWork);
+    areg.sPreWriteEvent.watch(this, &BenchmarkRecorder::startWork);
+    areg.sPostWriteEvent.watch(this, &BenchmarkRecorder::stopWork);
+    areg.sPostEndJob.watch(this, &BenchmarkRecorder::writeResults);
+  }
+
+  void
+  BenchmarkRecorder::preSourceEvent(art::ScheduleContext const sc)
+  {
+    auto const now = steady_clock::now();
+    std::call_once(loopStarted_, [this, now] { loopStart_ = now; });
+    auto& d = schedules_[sc.id()];
+    d.eventStart = now;
+    d.workTime = 0;
+  }
+
+  void
+  BenchmarkRecorder::postProcessEvent(art::ScheduleContext const sc)
+  {
+    auto const now = steady_clock::now();
+    auto const& d = schedules_[sc.id()];
+    auto const latency = (now - d.eventStart).count();
+    auto const work = d.workTime.load();
+    ++events_;
+    workTime_ += work;
+    overheadTime_ += std::max(latency - work, steady_clock::rep{});
+
+    auto const stop = now.time_since_epoch().count();
+    auto last = loopStop_.load();
+    while (last < stop && !loopStop_.compare_exchange_weak(last, stop)) {
+    }
+  }
+
+  void
+  BenchmarkRecorder::startWork(art::ModuleContext const& mc)
+  {
+    workStarts.open(&mc.moduleDescription(), steady_clock::now());
+  }
+
+  void
+  BenchmarkRecorder::stopWork(art::ModuleContext const& mc)
+  {
+    auto const start = workStarts.close(&mc.moduleDescription());
+    if (!start) {
+      return;
+    }
+    auto const elapsed = steady_clock::now() - *start;
+    schedules_[mc.scheduleID()].workTime += elapsed.count();
+  }
+
+  void
+  BenchmarkRecorder::writeResults()
+  {
+    auto const events = events_.load();
+    // Both ends of the event loop stay at the clock's epoch if no
+    // events were processed.
+    auto const wall =
+      in_seconds(loopStop_.load() - loopStart_.time_since_epoch().count());
+    auto const per_event_us = [events](steady_clock::rep const ticks) {
+      return events == 0 ? 0. : 1.e6 * in_seconds(ticks) / events;
+    };
+
+    std::ofstream out{fileName_, std::ios::app};
+    if (!out) {
+      throw art::Exception{art::errors::Configuration}
+        << "BenchmarkRecorder could not open '" << fileName_
+        << "' for writing.\n";
+    }
+    auto const* globals = art::Globals::instance();
+    out << std::setprecision(9) << "{\"label\": \"" << label_ << "\""
+        << ", \"nthreads\": " << globals->nthreads()
+        << ", \"nschedules\": " << globals->nschedules()
+        << ", \"events\": " << events << ", \"wall_s\": " << wall
+        << ", \"events_per_s\": " << (wall > 0. ? events / wall : 0.)
+        << ", \"module_us_per_event\": " << per_event_us(workTime_.load())
+        << ", \"overhead_us_per_event\": "
+        << per_event_us(overheadTime_.load()) << "}\n";
+  }
+
+} // namespace arttest
+
+DECLARE_ART_SERVICE(arttest::BenchmarkRecorder, SHARED)
+DEFINE_ART_SERVICE(arttest::BenchmarkRecorder)
@@ -0,0 +1,55 @@
+#ifndef art_test_Benchmarks_BenchmarkWork_h
+#define art_test_Benchmarks_BenchmarkWork_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// Helpers shared by the synthetic benchmark modules.
+// ======================================================================
+
+#include "art/Framework/Principal/Event.h"
+#include "canvas/Utilities/InputTag.h"
+
+#include <chrono>
+#include <vector>
+
+namespace arttest::benchmark {
+
+  using product_t = std::vector<double>;
+
+  // Keeps the calling thread busy for the given number of
+  // microseconds of wall-clock time.  Spinning rather than sleeping
+  // makes the cost scale with the number of threads like real work
+  // does.
+  inline void
+  burn(double const microseconds)
+  {
+    using namespace std::chrono;
+    auto const stop =
+      steady_clock::now() + duration_cast<steady_clock::duration>(
+                              duration<double, std::micro>{microseconds});
+    while (steady_clock::now() < stop) {
+    }
+  }
+
+  // Retrieves each input product, returning a value derived from
+  // their contents so that the lookups cannot be optimized away.
+  inline double
+  readInputs(art::Event const& e, std::vector<art::InputTag> const& tags)
+  {
+    double sum{};
+    for (auto const& tag : tags) {
+      auto const& product = *e.getValidHandle<product_t>(tag);
+      if (!product.empty()) {
+        sum += product.front();
+      }
+    }
+    return sum;
+  }
+
+} // namespace arttest::benchmark
+
+#endif /* art_test_Benchmarks_BenchmarkWork_h */
+
+// Local Variables:
+// mode: c++
+// End:
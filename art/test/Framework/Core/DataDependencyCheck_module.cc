@@ -0,0 +1,100 @@
+#include "boost/test/unit_test.hpp"
+
+// ======================================================================
+// DataDependencyCheck: A producer for jobs that enable data-dependency
+// scheduling.  Each module reads the products of its 'inputs', which
+// must already have been produced for the event, and puts one more
+// than the largest of them.  Modules with a nonzero 'numConcurrent'
+// are expected to run at the same time: on the first event, each of
+// them waits (for a bounded time) until that many are running.
+// ======================================================================
+
+#include "art/Framework/Core/SharedProducer.h"
+#include "art/Framework/Principal/Event.h"
+#include "canvas/Utilities/InputTag.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Sequence.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+  using namespace std::chrono;
+
+  // Shared by all DataDependencyCheck modules of the job.
+  std::atomic<unsigned> modulesRunning{};
+
+  class DataDependencyCheck : public art::SharedProducer {
+  public:
+    struct Config {
+      fhicl::Atom<unsigned> numEvents{
+        fhicl::Name{"numEvents"},
+        fhicl::Comment{"Number of events to be processed by module."}};
+      fhicl::Sequence<art::InputTag> inputs{fhicl::Name{"inputs"}, {}};
+      fhicl::Atom<unsigned> numConcurrent{
+        fhicl::Name{"numConcurrent"},
+        fhicl::Comment{"Number of modules that must be running at the same\n"
+                       "time as this one, including itself.  Zero disables\n"
+                       "the check."},
+        0u};
+    };
+    using Parameters = Table<Config>;
+    explicit DataDependencyCheck(Parameters const& p,
+                                 art::ProcessingFrame const&)
+      : SharedProducer{p}
+      , nEvents_{p().numEvents()}
+      , inputs_{p().inputs()}
+      , nConcurrent_{p().numConcurrent()}
+    {
+      for (auto const& tag : inputs_) {
+        consumes<int>(tag);
+      }
+      produces<int>();
+      async<art::InEvent>();
+    }
+
+  private:
+    void
+    produce(art::Event& e, art::ProcessingFrame const&) override
+    {
+      // Reading a product that has not yet been produced throws.
+      int value{};
+      for (auto const& tag : inputs_) {
+        value = std::max(value, e.getProduct<int>(tag) + 1);
+      }
+      if (nConcurrent_ != 0u && !firstEventSeen_.exchange(true)) {
+        ++modulesRunning;
+        auto const begin = steady_clock::now();
+        while (modulesRunning.load() < nConcurrent_ &&
+               steady_clock::now() - begin < seconds{5}) {
+          std::this_thread::yield();
+        }
+        allRunning_ = modulesRunning.load() >= nConcurrent_;
+      }
+      e.put(std::make_unique<int>(value));
+      ++produced_;
+    }
+
+    void
+    endJob(art::ProcessingFrame const&) override
+    {
+      BOOST_TEST(produced_ == nEvents_);
+      if (nConcurrent_ != 0u) {
+        BOOST_TEST(allRunning_);
+      }
+    }
+
+    unsigned const nEvents_;
+    std::vector<art::InputTag> const inputs_;
+    unsigned const nConcurrent_;
+    std::atomic<bool> firstEventSeen_{false};
+    std::atomic<bool> allRunning_{false};
+    std::atomic<unsigned> produced_{};
+  };
+}
+
+DEFINE_ART_MODULE(DataDependencyCheck)
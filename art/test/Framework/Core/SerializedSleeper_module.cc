@@ -0,0 +1,46 @@
+// ======================================================================
+// SerializedSleeper: A shared analyzer that is serialized on an
+// external resource and sleeps for the configured time per event, so
+// that the events of the other schedules queue up behind it.
+// ======================================================================
+
+#include "art/Framework/Core/SharedAnalyzer.h"
+#include "art/Framework/Principal/fwd.h"
+#include "fhiclcpp/types/Atom.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace {
+  class SerializedSleeper : public art::SharedAnalyzer {
+  public:
+    struct Config {
+      fhicl::Atom<std::string> resource{
+        fhicl::Name{"resource"},
+        fhicl::Comment{"External resource on which the module serializes."}};
+      fhicl::Atom<unsigned> sleepFor{
+        fhicl::Name{"sleepFor"},
+        fhicl::Comment{"Duration (in milliseconds) for which the analyze "
+                       "function sleeps."}};
+    };
+    using Parameters = Table<Config>;
+    explicit SerializedSleeper(Parameters const& p,
+                               art::ProcessingFrame const&)
+      : SharedAnalyzer{p}, sleepFor_{p().sleepFor()}
+    {
+      serializeExternal<art::InEvent>(p().resource());
+    }
+
+  private:
+    void
+    analyze(art::Event const&, art::ProcessingFrame const&) override
+    {
+      std::this_thread::sleep_for(sleepFor_);
+    }
+
+    std::chrono::milliseconds const sleepFor_;
+  };
+}
+
+DEFINE_ART_MODULE(SerializedSleeper)
@@ -0,0 +1,94 @@
+#include "boost/test/unit_test.hpp"
+
+// ======================================================================
+// WriteQueueCheck: An output module that checks that events are written
+// through one serial queue per output module.  Writes to the same
+// module must never overlap, whereas the modules of the job must be
+// able to write concurrently: the first write of each module waits
+// (for a bounded time) until all modules of the job are writing.
+// ======================================================================
+
+#include "art/Framework/Core/OutputModule.h"
+#include "art/Framework/Principal/fwd.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/ConfigurationTable.h"
+#include "fhiclcpp/types/TableFragment.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+  using namespace std::chrono;
+
+  // Shared by all WriteQueueCheck modules of the job.
+  std::atomic<unsigned> modulesWriting{};
+
+  class WriteQueueCheck : public art::OutputModule {
+  public:
+    struct Config {
+      fhicl::TableFragment<art::OutputModule::Config> omConfig;
+      fhicl::Atom<unsigned> numEvents{
+        fhicl::Name{"numEvents"},
+        fhicl::Comment{"Number of events to be written by module."}};
+      fhicl::Atom<unsigned> numModules{
+        fhicl::Name{"numModules"},
+        fhicl::Comment{"Number of WriteQueueCheck modules in the job."}};
+    };
+    using Parameters =
+      fhicl::WrappedTable<Config, art::OutputModule::Config::KeysToIgnore>;
+    explicit WriteQueueCheck(Parameters const& p)
+      : OutputModule{p().omConfig}
+      , nEvents_{p().numEvents()}
+      , nModules_{p().numModules()}
+    {}
+
+  private:
+    void
+    write(art::EventPrincipal&) override
+    {
+      // Boost.Test assertions are not thread-safe; overlapping writes
+      // are reported at the end of the job.
+      if (++active_ != 1u) {
+        overlapped_ = true;
+      }
+      if (written_ == 0u) {
+        ++modulesWriting;
+        auto const begin = steady_clock::now();
+        while (modulesWriting.load() < nModules_ &&
+               steady_clock::now() - begin < seconds{5}) {
+          std::this_thread::yield();
+        }
+        allWriting_ = modulesWriting.load() == nModules_;
+      }
+      std::this_thread::sleep_for(milliseconds{1});
+      ++written_;
+      --active_;
+    }
+
+    void
+    writeRun(art::RunPrincipal&) override
+    {}
+
+    void
+    writeSubRun(art::SubRunPrincipal&) override
+    {}
+
+    void
+    endJob() override
+    {
+      BOOST_TEST(!overlapped_);
+      BOOST_TEST(written_ == nEvents_);
+      BOOST_TEST(allWriting_);
+    }
+
+    unsigned const nEvents_;
+    unsigned const nModules_;
+    std::atomic<unsigned> active_{};
+    std::atomic<unsigned> written_{};
+    std::atomic<bool> overlapped_{false};
+    bool allWriting_{false};
+  };
+}
+
+DEFINE_ART_MODULE(WriteQueueCheck)
@@ -0,0 +1,111 @@
+#define BOOST_TEST_MODULE (ConcurrencyTuner_t)
+#include "boost/test/unit_test.hpp"
+
+#include "art/Framework/EventProcessor/detail/ConcurrencyTuner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using art::ScheduleID;
+using art::detail::ConcurrencyTuner;
+
+namespace {
+  // Feeds events to the tuner at the throughput that the given
+  // function assigns to the number of active schedules, until the
+  // tuning is done.  Returns the schedules the tuner restarted.
+  template <typename F>
+  std::vector<ScheduleID>
+  run_tuning(ConcurrencyTuner& tuner, F events_per_second)
+  {
+    std::vector<ScheduleID> restarted;
+    auto now = ConcurrencyTuner::clock_type::time_point{};
+    while (tuner.tuning()) {
+      std::chrono::duration<double> const step{
+        1. / events_per_second(tuner.active())};
+      now += std::chrono::duration_cast<ConcurrencyTuner::clock_type::duration>(
+        step);
+      auto const more = tuner.eventFinished(now);
+      restarted.insert(end(restarted), cbegin(more), cend(more));
+    }
+    return restarted;
+  }
+
+  // Throughput rises with the number of schedules up to three.
+  double
+  saturating(ScheduleID::size_type const n)
+  {
+    return 10. * std::min(n, ScheduleID::size_type{3});
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(ConcurrencyTuner_t)
+
+BOOST_AUTO_TEST_CASE(no_tuning)
+{
+  ConcurrencyTuner tuner{4, 2, 0};
+  BOOST_TEST(!tuner.tuning());
+  BOOST_TEST(tuner.active() == 2u);
+  BOOST_TEST(tuner.mayContinue(ScheduleID{1}));
+  BOOST_TEST(!tuner.mayContinue(ScheduleID{2}));
+  BOOST_TEST(tuner.eventFinished({}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(climb_up)
+{
+  ConcurrencyTuner tuner{8, 1, 800};
+  BOOST_TEST(tuner.tuning());
+  run_tuning(tuner, saturating);
+  BOOST_TEST(tuner.active() == 3u);
+  auto const history = tuner.history();
+  BOOST_TEST_REQUIRE(history.size() == 4u);
+  BOOST_TEST(history.back().schedules == 4u);
+}
+
+BOOST_AUTO_TEST_CASE(climb_down)
+{
+  // Throughput falls with each schedule beyond the second.
+  ConcurrencyTuner tuner{8, 5, 800};
+  run_tuning(tuner, [](ScheduleID::size_type const n) {
+    return n <= 2u ? 10. * n : 20. - 3. * (n - 2);
+  });
+  BOOST_TEST(tuner.active() == 2u);
+}
+
+BOOST_AUTO_TEST_CASE(start_at_maximum)
+{
+  ConcurrencyTuner tuner{3, 5, 800};
+  BOOST_TEST(tuner.active() == 3u);
+  run_tuning(tuner, saturating);
+  BOOST_TEST(tuner.active() == 3u);
+  BOOST_TEST(tuner.history().size() == 2u);
+}
+
+BOOST_AUTO_TEST_CASE(parked_schedules_are_restarted)
+{
+  ConcurrencyTuner tuner{4, 1, 800};
+  tuner.beginRound();
+  BOOST_TEST(tuner.mayContinue(ScheduleID{0}));
+  BOOST_TEST(!tuner.mayContinue(ScheduleID{1}));
+  BOOST_TEST(!tuner.mayContinue(ScheduleID{2}));
+  BOOST_TEST(!tuner.mayContinue(ScheduleID{3}));
+  auto const restarted = run_tuning(tuner, saturating);
+  BOOST_TEST(tuner.active() == 3u);
+  // Schedule 3 is restarted for the attempt with four schedules; it
+  // parks itself again once it sees that only three are active.
+  BOOST_TEST_REQUIRE(restarted.size() == 3u);
+  BOOST_TEST(restarted[0] == ScheduleID{1});
+  BOOST_TEST(restarted[1] == ScheduleID{2});
+  BOOST_TEST(restarted[2] == ScheduleID{3});
+}
+
+BOOST_AUTO_TEST_CASE(tuning_ends_after_tuning_events)
+{
+  ConcurrencyTuner tuner{64, 1, 16};
+  run_tuning(tuner, [](ScheduleID::size_type const n) { return 10. * n; });
+  // Every window improves, but only sixteen events are examined.
+  BOOST_TEST(!tuner.tuning());
+  BOOST_TEST(tuner.active() < 16u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -12,9 +12,14 @@
 #include "art/Framework/Principal/SubRunPrincipal.h"
 #include "canvas/Persistency/Provenance/IDNumber.h"
 #include "fhiclcpp/types/ConfigurationTable.h"
+#include "fhiclcpp/types/OptionalAtom.h"
 #include "fhiclcpp/types/Sequence.h"
 #include "fhiclcpp/types/TupleAs.h"
 
+#include <chrono>
+#include <optional>
+#include <thread>
+
 using namespace art;
 
 namespace {
@@ -119,12 +124,22 @@ namespace arttest {
         switchAfter{fhicl::Name("switchAfter"),
                     fhicl::Comment(OUTPUT_COMMENT),
                     std::vector<SwitchPoint>{}};
+      fhicl::OptionalAtom<unsigned> maxLateEvents{
+        fhicl::Name("maxLateEvents"),
+        fhicl::Comment(
+          "If specified, the maximum number of events that may be written\n"
+          "to a file after it has requested to be closed, i.e. the events\n"
+          "that other schedules were processing at the switch point.  Each\n"
+          "of them is written slowly, so that the schedules have noticed\n"
+          "the file switch before they could start another event.")};
     };
 
     using Parameters =
       fhicl::WrappedTable<Config, OutputModule::Config::KeysToIgnore>;
     explicit EventProcessorTestOutput(Parameters const& ps)
-      : OutputModule{ps().omConfig}, switchPoints_{ps().switchAfter()}
+      : OutputModule{ps().omConfig}
+      , switchPoints_{ps().switchAfter()}
+      , maxLateEvents_{ps().maxLateEvents()}
     {
       if (!switchPoints_.empty()) {
         activeSwitchPoint_ = switchPoints_.front();
@@ -141,13 +156,31 @@ namespace arttest {
     void
     write(EventPrincipal& ep) override
     {
+      if (closeRequested_ && maxLateEvents_) {
+        if (++lateEvents_ > *maxLateEvents_) {
+          throw Exception{errors::LogicError}
+            << "Event " << ep.eventID() << " is the " << lateEvents_
+            << " event written after the output file requested to be "
+               "closed;\nat most "
+            << *maxLateEvents_ << " are expected.\n";
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{100});
+      }
       requestsFileClose_ =
         activeSwitchPoint_.matches(currentInputFileName_, ep.eventID());
       if (requestsFileClose_) {
+        closeRequested_ = true;
         updateSwitchPoints();
       }
     }
 
+    void
+    finishEndFile() override
+    {
+      closeRequested_ = false;
+      lateEvents_ = 0u;
+    }
+
     void
     writeSubRun(SubRunPrincipal& srp) override
     {
@@ -208,6 +241,9 @@ namespace arttest {
     SwitchPoint activeSwitchPoint_{};
     std::string currentInputFileName_{};
     bool requestsFileClose_{false};
+    std::optional<unsigned> const maxLateEvents_;
+    bool closeRequested_{false};
+    unsigned lateEvents_{};
   };
 
 } // namespace arttest
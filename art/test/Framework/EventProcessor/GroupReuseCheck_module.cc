@@ -0,0 +1,119 @@
+// ======================================================================
+//
+// GroupReuseCheck: Checks the products of the GroupReuseProducer
+// modules 'plain', 'derived' (which reads 'plain') and 'sparse' (which
+// puts products into the odd-numbered events only) in each event.
+// When the groups of the produced products are reused, no value,
+// provenance or range set of an earlier event may show through.
+//
+// ======================================================================
+
+#include "art/Framework/Core/SharedAnalyzer.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "art/Framework/Principal/Provenance.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Persistency/Provenance/ProductStatus.h"
+#include "canvas/Persistency/Provenance/RangeSet.h"
+#include "canvas/Utilities/Exception.h"
+#include "canvas/Utilities/InputTag.h"
+#include "fhiclcpp/types/Atom.h"
+
+#include <atomic>
+#include <vector>
+
+namespace {
+  void
+  require(bool const condition, art::EventID const& id, char const* what)
+  {
+    if (!condition) {
+      throw art::Exception{art::errors::LogicError}
+        << "Event " << id << ": " << what << '\n';
+    }
+  }
+
+  class GroupReuseCheck : public art::SharedAnalyzer {
+  public:
+    struct Config {
+      fhicl::Atom<unsigned> expectedEvents{fhicl::Name{"expectedEvents"}};
+    };
+    using Parameters = Table<Config>;
+    explicit GroupReuseCheck(Parameters const& p, art::ProcessingFrame const&)
+      : SharedAnalyzer{p}, expectedEvents_{p().expectedEvents()}
+    {
+      consumes<int>(plain_);
+      consumes<int>(derived_);
+      consumes<int>(sparse_);
+      async<art::InEvent>();
+    }
+
+  private:
+    void
+    analyze(art::Event const& e, art::ProcessingFrame const&) override
+    {
+      auto const id = e.id();
+      auto const event = static_cast<int>(e.event());
+
+      auto const plain = e.getValidHandle<int>(plain_);
+      require(*plain == event, id, "'plain' has the wrong value.");
+      checkProvenance(*plain.provenance(), plain_, id);
+      require(plain.provenance()->parents().empty(),
+              id,
+              "'plain' has parents.");
+
+      auto const derived = e.getValidHandle<int>(derived_);
+      require(*derived == event + 1000, id, "'derived' has the wrong value.");
+      checkProvenance(*derived.provenance(), derived_, id);
+      require(derived.provenance()->parents() ==
+                std::vector<art::ProductID>{plain.id()},
+              id,
+              "'derived' does not have 'plain' as its only parent.");
+
+      auto const sparse = e.getHandle<int>(sparse_);
+      if (event % 2 == 0) {
+        require(!sparse.isValid(), id, "'sparse' was not put, but is valid.");
+      } else {
+        require(sparse.isValid() && *sparse == event,
+                id,
+                "'sparse' is missing or has the wrong value.");
+        checkProvenance(*sparse.provenance(), sparse_, id);
+      }
+      ++events_;
+    }
+
+    void
+    endJob(art::ProcessingFrame const&) override
+    {
+      if (events_.load() != expectedEvents_) {
+        throw art::Exception{art::errors::LogicError}
+          << "Checked " << events_.load() << " events instead of "
+          << expectedEvents_ << ".\n";
+      }
+    }
+
+    static void
+    checkProvenance(art::Provenance const& prov,
+                    art::InputTag const& tag,
+                    art::EventID const& id)
+    {
+      require(prov.moduleLabel() == tag.label(),
+              id,
+              "A product has the provenance of another module.");
+      require(prov.produced(), id, "A product was not produced.");
+      require(prov.productStatus() == art::productstatus::present(),
+              id,
+              "A product is not marked present.");
+      require(!prov.rangeOfValidity().is_valid(),
+              id,
+              "An event product has a valid range set.");
+    }
+
+    art::InputTag const plain_{"plain"};
+    art::InputTag const derived_{"derived"};
+    art::InputTag const sparse_{"sparse"};
+    unsigned const expectedEvents_;
+    std::atomic<unsigned> events_{};
+  };
+}
+
+DEFINE_ART_MODULE(GroupReuseCheck)
@@ -0,0 +1,56 @@
+// ======================================================================
+//
+// GroupReuseProducer: Puts the event number, or the value of an input
+// product plus 1000, into each event.  If oddEventsOnly is true,
+// nothing is put into the even-numbered events.
+//
+// ======================================================================
+
+#include "art/Framework/Core/SharedProducer.h"
+#include "art/Framework/Principal/Event.h"
+#include "canvas/Utilities/InputTag.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/OptionalAtom.h"
+
+#include <memory>
+#include <optional>
+
+namespace {
+  class GroupReuseProducer : public art::SharedProducer {
+  public:
+    struct Config {
+      fhicl::OptionalAtom<art::InputTag> input{fhicl::Name{"input"}};
+      fhicl::Atom<bool> oddEventsOnly{fhicl::Name{"oddEventsOnly"}, false};
+    };
+    using Parameters = Table<Config>;
+    explicit GroupReuseProducer(Parameters const& p,
+                                art::ProcessingFrame const&)
+      : SharedProducer{p}
+      , input_{p().input()}
+      , oddEventsOnly_{p().oddEventsOnly()}
+    {
+      if (input_) {
+        consumes<int>(*input_);
+      }
+      produces<int>();
+      async<art::InEvent>();
+    }
+
+  private:
+    void
+    produce(art::Event& e, art::ProcessingFrame const&) override
+    {
+      if (oddEventsOnly_ && e.event() % 2 == 0) {
+        return;
+      }
+      auto const value = input_ ? e.getProduct<int>(*input_) + 1000 :
+                                  static_cast<int>(e.event());
+      e.put(std::make_unique<int>(value));
+    }
+
+    std::optional<art::InputTag> const input_;
+    bool const oddEventsOnly_;
+  };
+}
+
+DEFINE_ART_MODULE(GroupReuseProducer)
@@ -0,0 +1,107 @@
+// ======================================================================
+//
+// SourceSignalOrder: Checks that the source signals of a subrun and
+// of its events are emitted in the order of the subrun transitions,
+// even if the subrun and its events have been read ahead of the
+// schedules: a subrun is presented by the source only after the
+// previous subrun has ended, and its events only while it is begun.
+// A subrun may be ended and begun again when the output files are
+// switched in its middle.
+//
+// ======================================================================
+
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/SubRun.h"
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceDeclarationMacros.h"
+#include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
+#include "art/Framework/Services/Registry/ServiceTable.h"
+#include "art/Persistency/Provenance/ScheduleContext.h"
+#include "canvas/Persistency/Provenance/SubRunID.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <mutex>
+
+namespace {
+  void
+  require(bool const condition, char const* what)
+  {
+    if (!condition) {
+      throw art::Exception{art::errors::LogicError} << what << '\n';
+    }
+  }
+}
+
+namespace arttest {
+
+  class SourceSignalOrder {
+  public:
+    struct Config {};
+    using Parameters = art::ServiceTable<Config>;
+    SourceSignalOrder(Parameters const&, art::ActivityRegistry&);
+
+  private:
+    void postSourceSubRun(art::SubRun const&);
+    void postBeginSubRun(art::SubRun const&);
+    void postEndSubRun(art::SubRun const&);
+    void postSourceEvent(art::Event const&, art::ScheduleContext);
+
+    enum class State { Read, Begun, Ended };
+
+    std::mutex mutex_{};
+    art::SubRunID subRun_{};
+    State state_{State::Ended};
+  };
+
+  SourceSignalOrder::SourceSignalOrder(Parameters const&,
+                                       art::ActivityRegistry& areg)
+  {
+    areg.sPostSourceSubRun.watch(this, &SourceSignalOrder::postSourceSubRun);
+    areg.sPostBeginSubRun.watch(this, &SourceSignalOrder::postBeginSubRun);
+    areg.sPostEndSubRun.watch(this, &SourceSignalOrder::postEndSubRun);
+    areg.sPostSourceEvent.watch(this, &SourceSignalOrder::postSourceEvent);
+  }
+
+  void
+  SourceSignalOrder::postSourceSubRun(art::SubRun const& sr)
+  {
+    std::lock_guard sentry{mutex_};
+    require(state_ == State::Ended,
+            "A subrun was read before the previous one had ended.");
+    subRun_ = sr.id();
+    state_ = State::Read;
+  }
+
+  void
+  SourceSignalOrder::postBeginSubRun(art::SubRun const& sr)
+  {
+    std::lock_guard sentry{mutex_};
+    require(sr.id() == subRun_, "A subrun was begun before it was read.");
+    require(state_ != State::Begun, "A subrun was begun twice.");
+    state_ = State::Begun;
+  }
+
+  void
+  SourceSignalOrder::postEndSubRun(art::SubRun const& sr)
+  {
+    std::lock_guard sentry{mutex_};
+    require(sr.id() == subRun_, "A subrun was ended before it was read.");
+    require(state_ == State::Begun, "A subrun was ended but not begun.");
+    state_ = State::Ended;
+  }
+
+  void
+  SourceSignalOrder::postSourceEvent(art::Event const& e,
+                                     art::ScheduleContext)
+  {
+    std::lock_guard sentry{mutex_};
+    require(e.id().subRunID() == subRun_,
+            "An event was read outside its subrun.");
+    require(state_ == State::Begun,
+            "An event was read while its subrun was not begun.");
+  }
+
+} // namespace arttest
+
+DECLARE_ART_SERVICE(arttest::SourceSignalOrder, SHARED)
+DEFINE_ART_SERVICE(arttest::SourceSignalOrder)
@@ -0,0 +1,115 @@
+// ======================================================================
+//
+// SubRunOrderCheck: Checks that, however far the input has been read
+// ahead, each event is processed between the beginSubRun and
+// endSubRun calls of its own subrun, and that each subrun has the
+// expected number of events.  A subrun may be ended and begun again
+// when the output files are switched in its middle.  The processing
+// time of an event depends on its number, so that the schedules run
+// out of events of a subrun at different times.
+//
+// ======================================================================
+
+#include "art/Framework/Core/SharedAnalyzer.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Run.h"
+#include "art/Framework/Principal/SubRun.h"
+#include "canvas/Utilities/Exception.h"
+#include "fhiclcpp/types/Atom.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace {
+  void
+  require(bool const condition, char const* what)
+  {
+    if (!condition) {
+      throw art::Exception{art::errors::LogicError} << what << '\n';
+    }
+  }
+
+  class SubRunOrderCheck : public art::SharedAnalyzer {
+  public:
+    struct Config {
+      fhicl::Atom<unsigned> eventsPerSubRun{fhicl::Name{"eventsPerSubRun"}};
+      fhicl::Atom<unsigned> expectedEvents{fhicl::Name{"expectedEvents"}};
+    };
+    using Parameters = Table<Config>;
+    explicit SubRunOrderCheck(Parameters const& p, art::ProcessingFrame const&)
+      : SharedAnalyzer{p}
+      , eventsPerSubRun_{p().eventsPerSubRun()}
+      , expectedEvents_{p().expectedEvents()}
+    {
+      async<art::InEvent>();
+    }
+
+  private:
+    void
+    beginRun(art::Run const& r, art::ProcessingFrame const&) override
+    {
+      require(!run_.isValid(), "A run was begun inside another run.");
+      run_ = r.id();
+    }
+
+    void
+    beginSubRun(art::SubRun const& sr, art::ProcessingFrame const&) override
+    {
+      require(sr.id().runID() == run_, "A subrun was begun outside its run.");
+      require(!subRun_.isValid(), "A subrun was begun inside another subrun.");
+      subRun_ = sr.id();
+    }
+
+    void
+    analyze(art::Event const& e, art::ProcessingFrame const&) override
+    {
+      {
+        std::lock_guard sentry{mutex_};
+        require(e.id().subRunID() == subRun_,
+                "An event was processed outside its subrun.");
+        ++eventsInSubRun_[subRun_];
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds{e.event() % 4});
+    }
+
+    void
+    endSubRun(art::SubRun const& sr, art::ProcessingFrame const&) override
+    {
+      require(sr.id() == subRun_, "A subrun was ended but not begun.");
+      require(eventsInSubRun_[subRun_] <= eventsPerSubRun_,
+              "A subrun had too many events.");
+      subRun_ = art::SubRunID{};
+    }
+
+    void
+    endRun(art::Run const& r, art::ProcessingFrame const&) override
+    {
+      require(r.id() == run_, "A run was ended but not begun.");
+      require(!subRun_.isValid(), "A run was ended inside a subrun.");
+      run_ = art::RunID{};
+    }
+
+    void
+    endJob(art::ProcessingFrame const&) override
+    {
+      unsigned events{};
+      for (auto const& [id, n] : eventsInSubRun_) {
+        require(n == eventsPerSubRun_, "A subrun had too few events.");
+        events += n;
+      }
+      require(events == expectedEvents_,
+              "The job did not process the expected number of events.");
+    }
+
+    unsigned const eventsPerSubRun_;
+    unsigned const expectedEvents_;
+    std::mutex mutex_{};
+    art::RunID run_{};
+    art::SubRunID subRun_{};
+    std::map<art::SubRunID, unsigned> eventsInSubRun_{};
+  };
+}
+
+DEFINE_ART_MODULE(SubRunOrderCheck)
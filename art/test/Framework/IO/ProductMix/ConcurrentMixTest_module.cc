@@ -0,0 +1,102 @@
+// Checks the mix operations of a MixHelper configured with
+// concurrentMixOps: each operation must be given the secondary
+// products of its own branch, and the operations of an event must be
+// able to run at the same time.  On the first event, each operation
+// waits (for a bounded time) until all of them are running.
+
+#include "art/Framework/Modules/MixFilter.h"
+#include "art/test/Framework/IO/ProductMix/FakeMixIOPolicy.h"
+#include "fhiclcpp/ParameterSet.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+  using namespace std::chrono;
+
+  class ConcurrentMixTestDetail {
+  public:
+    ConcurrentMixTestDetail(fhicl::ParameterSet const& p,
+                            art::MixHelper& helper)
+      : nSecondaries_{p.get<std::size_t>("nSecondaries")}
+      , nMixOps_{p.get<unsigned>("nMixOps")}
+    {
+      for (unsigned i{}; i != nMixOps_; ++i) {
+        helper.declareMixOp<art::InEvent, int, int>(
+          art::InputTag{"ints" + std::to_string(i)},
+          [this](std::vector<int const*> const& in,
+                 int&,
+                 art::PtrRemapper const&) { return mixInts(in); },
+          false);
+      }
+    }
+
+    std::size_t
+    nSecondaries() const
+    {
+      return nSecondaries_;
+    }
+
+    void
+    processEventIDs(art::EventIDSequence const& seq)
+    {
+      eventIDs_ = seq;
+    }
+
+    void
+    finalizeEvent(art::Event&)
+    {
+      arttest::require(mixed_.exchange(0u) == nMixOps_,
+                       "Not every mix operation ran for the event.");
+      if (firstEvent_) {
+        arttest::require(allRunning_,
+                         "The mix operations of the first event did not run "
+                         "concurrently.");
+        firstEvent_ = false;
+      }
+    }
+
+  private:
+    bool
+    mixInts(std::vector<int const*> const& in)
+    {
+      arttest::require(in.size() == nSecondaries_,
+                       "Wrong number of secondary products.");
+      arttest::require(eventIDs_.size() == nSecondaries_,
+                       "Wrong number of secondary event IDs.");
+      for (std::size_t i{}; i != in.size(); ++i) {
+        arttest::require(*in[i] == arttest::secondary_value(eventIDs_[i]),
+                         "A product does not belong to its event ID.");
+      }
+      if (firstEvent_) {
+        ++running_;
+        auto const begin = steady_clock::now();
+        while (running_.load() < nMixOps_ &&
+               steady_clock::now() - begin < seconds{5}) {
+          std::this_thread::yield();
+        }
+        if (running_.load() == nMixOps_) {
+          allRunning_ = true;
+        }
+      }
+      ++mixed_;
+      return false;
+    }
+
+    std::size_t const nSecondaries_;
+    unsigned const nMixOps_;
+    art::EventIDSequence eventIDs_{};
+    bool firstEvent_{true};
+    std::atomic<unsigned> running_{};
+    std::atomic<unsigned> mixed_{};
+    std::atomic<bool> allRunning_{false};
+  };
+
+  using ConcurrentMixTest =
+    art::MixFilter<ConcurrentMixTestDetail, arttest::FakeMixIOPolicy>;
+}
+
+DEFINE_ART_MODULE(ConcurrentMixTest)
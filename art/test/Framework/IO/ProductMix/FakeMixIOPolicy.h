@@ -0,0 +1,152 @@
+#ifndef art_test_Framework_IO_ProductMix_FakeMixIOPolicy_h
+#define art_test_Framework_IO_ProductMix_FakeMixIOPolicy_h
+
+////////////////////////////////////////////////////////////////////////
+// FakeMixIOPolicy
+//
+// A MixIOPolicy that makes up its secondary events instead of reading
+// them from files, so that the MixHelper may be tested without any.
+// A secondary file name is of the form "<file number>:<number of
+// events>"; the events of the file have the IDs 1:<file number>:1,
+// 1:<file number>:2, etc., and the product of each mix operation for
+// an event is an int, given by secondary_value(<event ID>).  Only
+// event-level mix operations are supported.  The number of products
+// read by all FakeMixIOPolicy objects of the job is counted in
+// products_read.
+////////////////////////////////////////////////////////////////////////
+
+#include "art/Framework/IO/ProductMix/MixIOPolicy.h"
+#include "canvas/Persistency/Common/Wrapper.h"
+#include "canvas/Persistency/Provenance/EventAuxiliary.h"
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Persistency/Provenance/Timestamp.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace arttest {
+
+  // For the checks of the mixing test modules, which must also be
+  // made in builds without assertions.
+  inline void
+  require(bool const condition, std::string const& what)
+  {
+    if (!condition) {
+      throw art::Exception{art::errors::LogicError} << what << '\n';
+    }
+  }
+
+  inline std::atomic<std::size_t> products_read{};
+
+  inline int
+  secondary_value(art::EventID const& id)
+  {
+    return id.subRun() * 1000 + id.event();
+  }
+
+  // The events of the given secondary file, in file order.
+  inline art::EventIDSequence
+  secondary_events(std::string const& fileName)
+  {
+    auto const colon = fileName.find(':');
+    if (colon == std::string::npos) {
+      throw art::Exception{art::errors::Configuration}
+        << "Fake secondary file name '" << fileName
+        << "' is not of the form <file number>:<number of events>.\n";
+    }
+    auto const fileNumber = std::stoul(fileName.substr(0, colon));
+    auto const nEvents = std::stoul(fileName.substr(colon + 1));
+    art::EventIDSequence result;
+    for (unsigned long i{1}; i <= nEvents; ++i) {
+      result.emplace_back(1, fileNumber, i);
+    }
+    return result;
+  }
+
+  class FakeMixIOPolicy : public art::MixIOPolicy {
+  public:
+    art::EventAuxiliarySequence
+    generateEventAuxiliarySequence(
+      art::EntryNumberSequence const& seq) override
+    {
+      art::EventAuxiliarySequence result;
+      for (auto const entry : seq) {
+        result.emplace_back(eventIDs_.at(entry), art::Timestamp{}, false);
+      }
+      return result;
+    }
+
+    bool
+    fileOpen() const override
+    {
+      return fileOpen_;
+    }
+
+    std::size_t
+    nEventsInFile() const override
+    {
+      return eventIDs_.size();
+    }
+
+    art::FileIndex const&
+    fileIndex() const override
+    {
+      return fileIndex_;
+    }
+
+    cet::exempt_ptr<art::BranchIDLists const>
+    branchIDLists() const override
+    {
+      return nullptr;
+    }
+
+    void
+    openAndReadMetaData(std::string fileName, art::MixOpList& mixOps) override
+    {
+      eventIDs_ = secondary_events(fileName);
+      fileIndex_ = art::FileIndex{};
+      for (std::size_t i{}; i != eventIDs_.size(); ++i) {
+        fileIndex_.addEntry(eventIDs_[i], i);
+      }
+      fileIndex_.sortBy_Run_SubRun_Event();
+      for (auto& mixOp : mixOps) {
+        mixOp->setIncomingProductID(
+          art::ProductID{mixOp->inputTag().encode()});
+      }
+      fileOpen_ = true;
+    }
+
+    art::SpecProdList
+    readFromFile(art::MixOpBase const& mixOp,
+                 art::EntryNumberSequence const& seq) override
+    {
+      if (mixOp.branchType() != art::InEvent) {
+        throw art::Exception{art::errors::UnimplementedFeature}
+          << "FakeMixIOPolicy supports only event-level mix operations.\n";
+      }
+      products_read += seq.size();
+      art::SpecProdList result;
+      for (auto const entry : seq) {
+        result.push_back(std::make_shared<art::Wrapper<int>>(
+          std::make_unique<int>(secondary_value(eventIDs_.at(entry)))));
+      }
+      return result;
+    }
+
+  private:
+    bool fileOpen_{false};
+    art::EventIDSequence eventIDs_{};
+    art::FileIndex fileIndex_{};
+  };
+
+} // namespace arttest
+
+#endif /* art_test_Framework_IO_ProductMix_FakeMixIOPolicy_h */
+
+// Local Variables:
+// mode: c++
+// End:
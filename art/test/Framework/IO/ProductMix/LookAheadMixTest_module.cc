@@ -0,0 +1,89 @@
+// Checks that reading secondary events ahead does not change what is
+// mixed.  Filters that share a 'sequence' name must mix the same
+// secondaries for each primary event, whether or not they read ahead:
+// the filter with 'reference: true' records its secondaries, and the
+// filters after it on the path compare theirs.  The number of
+// secondaries per event varies, so that some events need more than
+// has been read ahead for them.
+
+#include "art/Framework/Modules/MixFilter.h"
+#include "art/test/Framework/IO/ProductMix/FakeMixIOPolicy.h"
+#include "fhiclcpp/ParameterSet.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+  // The secondaries mixed into each primary event, per sequence.
+  std::map<std::string, std::vector<std::vector<int>>> sequences;
+
+  class LookAheadMixTestDetail {
+  public:
+    LookAheadMixTestDetail(fhicl::ParameterSet const& p,
+                           art::MixHelper& helper)
+      : nSecondaries_{p.get<std::size_t>("nSecondaries")}
+      , reference_{p.get<bool>("reference", false)}
+      , mixed_{sequences[p.get<std::string>("sequence")]}
+    {
+      helper.declareMixOp(art::InputTag{"ints"},
+                          &LookAheadMixTestDetail::mixInts,
+                          *this,
+                          false);
+    }
+
+    // One, two or three more than the configured number, in turn.
+    std::size_t
+    nSecondaries() const
+    {
+      return nSecondaries_ + 1 + nEvents_ % 3;
+    }
+
+    void
+    processEventIDs(art::EventIDSequence const& seq)
+    {
+      eventIDs_ = seq;
+    }
+
+    bool
+    mixInts(std::vector<int const*> const& in,
+            int&,
+            art::PtrRemapper const&)
+    {
+      arttest::require(in.size() == nSecondaries(),
+                       "Wrong number of secondary products.");
+      arttest::require(eventIDs_.size() == in.size(),
+                       "Wrong number of secondary event IDs.");
+      std::vector<int> values;
+      for (std::size_t i{}; i != in.size(); ++i) {
+        arttest::require(*in[i] == arttest::secondary_value(eventIDs_[i]),
+                         "A product does not belong to its event ID.");
+        values.push_back(*in[i]);
+      }
+      if (reference_) {
+        arttest::require(mixed_.size() == nEvents_,
+                         "Two reference filters share a sequence.");
+        mixed_.push_back(values);
+      } else {
+        arttest::require(nEvents_ < mixed_.size(),
+                         "The reference filter must come first on the path.");
+        arttest::require(values == mixed_[nEvents_],
+                         "Reading ahead changed the mixed secondaries.");
+      }
+      ++nEvents_;
+      return false;
+    }
+
+  private:
+    std::size_t const nSecondaries_;
+    bool const reference_;
+    std::vector<std::vector<int>>& mixed_;
+    art::EventIDSequence eventIDs_{};
+    std::size_t nEvents_{};
+  };
+
+  using LookAheadMixTest =
+    art::MixFilter<LookAheadMixTestDetail, arttest::FakeMixIOPolicy>;
+}
+
+DEFINE_ART_MODULE(LookAheadMixTest)
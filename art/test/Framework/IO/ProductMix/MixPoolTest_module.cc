@@ -0,0 +1,113 @@
+// Checks the secondaries that a MixHelper configured with a
+// secondary-event pool chooses, for each read mode: they must all come
+// from the pool, which holds the first poolSize events of the
+// secondary files, in file order.  Moreover,
+//
+//   - sequential mode cycles through the pool;
+//   - randomLimReplace never chooses an event twice for one primary
+//     event;
+//   - randomNoReplace never chooses an event twice until every event
+//     of the pool has been used once.
+
+#include "art/Framework/Modules/MixFilter.h"
+#include "art/test/Framework/IO/ProductMix/FakeMixIOPolicy.h"
+#include "fhiclcpp/ParameterSet.h"
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+  class MixPoolTestDetail {
+  public:
+    MixPoolTestDetail(fhicl::ParameterSet const& p, art::MixHelper& helper)
+      : nSecondaries_{p.get<std::size_t>("nSecondaries")}
+      , readMode_{helper.readMode()}
+    {
+      auto const poolSize = p.get<std::size_t>("poolSize");
+      for (auto const& fileName :
+           p.get<std::vector<std::string>>("fileNames")) {
+        for (auto const& id : arttest::secondary_events(fileName)) {
+          if (pool_.size() == poolSize) {
+            break;
+          }
+          pool_.push_back(arttest::secondary_value(id));
+        }
+      }
+      arttest::require(nSecondaries_ <= pool_.size(),
+                       "More secondaries are needed than the pool holds.");
+      helper.declareMixOp(
+        art::InputTag{"ints"}, &MixPoolTestDetail::mixInts, *this, false);
+    }
+
+    std::size_t
+    nSecondaries() const
+    {
+      return nSecondaries_;
+    }
+
+    void
+    processEventIDs(art::EventIDSequence const& seq)
+    {
+      eventIDs_ = seq;
+    }
+
+    bool
+    mixInts(std::vector<int const*> const& in,
+            int&,
+            art::PtrRemapper const&)
+    {
+      using Mode = art::MixHelper::Mode;
+      arttest::require(in.size() == nSecondaries_,
+                       "Wrong number of secondary products.");
+      arttest::require(eventIDs_.size() == nSecondaries_,
+                       "Wrong number of secondary event IDs.");
+      if (readMode_ == Mode::RANDOM_NO_REPLACE &&
+          used_.size() + nSecondaries_ > pool_.size()) {
+        used_.clear(); // A new pass through the pool.
+      }
+      std::set<int> thisEvent;
+      for (std::size_t i{}; i != in.size(); ++i) {
+        auto const value = *in[i];
+        arttest::require(value == arttest::secondary_value(eventIDs_[i]),
+                         "A product does not belong to its event ID.");
+        arttest::require(
+          std::find(cbegin(pool_), cend(pool_), value) != cend(pool_),
+          "A secondary event is not in the pool.");
+        switch (readMode_) {
+        case Mode::SEQUENTIAL:
+          arttest::require(value == pool_[cursor_],
+                           "The pool is not read in order.");
+          cursor_ = (cursor_ + 1) % pool_.size();
+          break;
+        case Mode::RANDOM_LIM_REPLACE:
+          arttest::require(thisEvent.insert(value).second,
+                           "A secondary event is mixed twice into one event.");
+          break;
+        case Mode::RANDOM_NO_REPLACE:
+          arttest::require(used_.insert(value).second,
+                           "A secondary event is reused before the pool is "
+                           "exhausted.");
+          break;
+        default:
+          break;
+        }
+      }
+      return false;
+    }
+
+  private:
+    std::size_t const nSecondaries_;
+    art::MixHelper::Mode const readMode_;
+    std::vector<int> pool_{};
+    art::EventIDSequence eventIDs_{};
+    std::size_t cursor_{}; // SEQUENTIAL only.
+    std::set<int> used_{}; // RANDOM_NO_REPLACE only.
+  };
+
+  using MixPoolTest =
+    art::MixFilter<MixPoolTestDetail, arttest::FakeMixIOPolicy>;
+}
+
+DEFINE_ART_MODULE(MixPoolTest)
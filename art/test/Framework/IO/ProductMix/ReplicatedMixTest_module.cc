@@ -0,0 +1,85 @@
+// Checks the secondaries that the replicas of a ReplicatedMixFilter
+// choose on the different schedules:
+//
+//   - in a random read mode, the engines of the replicas have
+//     different seeds;
+//   - if distinctSecondaries is true, no secondary event is mixed
+//     twice in the whole job, whichever schedule mixes it;
+//   - if maxProductsRead is given, no more products than that are
+//     read in the whole job, e.g. because the replicas share one
+//     secondary-event pool.
+
+#include "art/Framework/Modules/ReplicatedMixFilter.h"
+#include "art/test/Framework/IO/ProductMix/FakeMixIOPolicy.h"
+#include "fhiclcpp/ParameterSet.h"
+
+#include <limits>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace {
+  std::mutex mutex;
+  std::set<long> seeds;
+  std::set<int> secondaries;
+
+  class ReplicatedMixTestDetail {
+  public:
+    ReplicatedMixTestDetail(fhicl::ParameterSet const& p,
+                            art::MixHelper& helper)
+      : nSecondaries_{p.get<std::size_t>("nSecondaries")}
+      , distinctSecondaries_{p.get<bool>("distinctSecondaries", false)}
+      , maxProductsRead_{p.get<std::size_t>(
+          "maxProductsRead",
+          std::numeric_limits<std::size_t>::max())}
+    {
+      if (helper.readMode() != art::MixHelper::Mode::SEQUENTIAL) {
+        // The engine of the helper is returned.
+        auto const seed = helper.createEngine(0).getSeed();
+        std::lock_guard sentry{mutex};
+        arttest::require(seeds.insert(seed).second,
+                         "Two replicas have engines with the same seed.");
+      }
+      helper.declareMixOp(art::InputTag{"ints"},
+                          &ReplicatedMixTestDetail::mixInts,
+                          *this,
+                          false);
+    }
+
+    std::size_t
+    nSecondaries() const
+    {
+      return nSecondaries_;
+    }
+
+    bool
+    mixInts(std::vector<int const*> const& in,
+            int&,
+            art::PtrRemapper const&)
+    {
+      arttest::require(in.size() == nSecondaries_,
+                       "Wrong number of secondary products.");
+      arttest::require(arttest::products_read.load() <= maxProductsRead_,
+                       "Too many secondary products have been read.");
+      if (distinctSecondaries_) {
+        std::lock_guard sentry{mutex};
+        for (auto const* value : in) {
+          arttest::require(secondaries.insert(*value).second,
+                           "A secondary event is mixed twice in the job.");
+        }
+      }
+      return false;
+    }
+
+  private:
+    std::size_t const nSecondaries_;
+    bool const distinctSecondaries_;
+    std::size_t const maxProductsRead_;
+  };
+
+  using ReplicatedMixTest =
+    art::ReplicatedMixFilter<ReplicatedMixTestDetail,
+                             arttest::FakeMixIOPolicy>;
+}
+
+DEFINE_ART_MODULE(ReplicatedMixTest)
@@ -0,0 +1,97 @@
+// vim: set sw=2 expandtab :
+#define BOOST_TEST_MODULE (DelayedReader_t)
+#include "boost/test/unit_test.hpp"
+
+// =====================================================================
+// DelayedReader_t checks that a reader which declares concurrent reads
+// safe has different branches read at the same time from two threads,
+// standing in for two schedules, while the reads of one branch by the
+// readers of different principals never overlap.
+// =====================================================================
+
+#include "art/Framework/Principal/DelayedReader.h"
+#include "canvas/Persistency/Common/Wrapper.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Persistency/Provenance/RangeSet.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace art;
+using namespace std::chrono_literals;
+
+namespace {
+
+  ProductID const branchA{1};
+  ProductID const branchB{2};
+
+  std::array<std::atomic<int>, 2> active{};
+  std::array<std::atomic<int>, 2> maxActive{};
+  std::atomic<bool> overlapped{false};
+
+  std::size_t
+  index(ProductID const pid)
+  {
+    return pid == branchA ? 0 : 1;
+  }
+
+  class ConcurrentReader : public DelayedReader {
+    std::unique_ptr<EDProduct>
+    getProduct_(Group const*, ProductID const pid, RangeSet&) const override
+    {
+      auto const i = index(pid);
+      auto const n = ++active[i];
+      for (auto m = maxActive[i].load(); n > m;) {
+        maxActive[i].compare_exchange_weak(m, n);
+      }
+      // Wait a while for a read of the other branch to start.
+      for (int t = 0; t != 200 && !overlapped; ++t) {
+        overlapped = active[1 - i] != 0;
+        std::this_thread::sleep_for(1ms);
+      }
+      --active[i];
+      return std::make_unique<Wrapper<int>>(std::make_unique<int>(1));
+    }
+
+    bool
+    concurrentReadsSafe_() const override
+    {
+      return true;
+    }
+  };
+
+  void
+  read(ProductID const pid)
+  {
+    ConcurrentReader const reader;
+    auto rs = RangeSet::invalid();
+    BOOST_TEST(reader.getProduct(nullptr, pid, rs) != nullptr);
+  }
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(DelayedReader_t)
+
+BOOST_AUTO_TEST_CASE(different_branches)
+{
+  overlapped = false;
+  std::thread other{read, branchB};
+  read(branchA);
+  other.join();
+  BOOST_TEST(overlapped.load());
+}
+
+BOOST_AUTO_TEST_CASE(same_branch)
+{
+  overlapped = false;
+  maxActive[index(branchA)] = 0;
+  std::thread other{read, branchA};
+  read(branchA);
+  other.join();
+  BOOST_TEST(maxActive[index(branchA)].load() == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
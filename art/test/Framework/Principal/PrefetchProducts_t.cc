@@ -0,0 +1,215 @@
+// vim: set sw=2 expandtab :
+#define BOOST_TEST_MODULE (PrefetchProducts_t)
+#include "boost/test/unit_test.hpp"
+
+// =====================================================================
+// PrefetchProducts_t checks that Principal::prefetchProducts hands the
+// delayed reader only the requested products that are available from
+// the input, that a reader which reads them in one batch then serves
+// their lookups without reading them again, and that a reader which
+// does not declare that it reads in batches is not asked to.
+// =====================================================================
+
+#include "art/Framework/Principal/DelayedReader.h"
+#include "art/Framework/Principal/EventPrincipal.h"
+#include "art/Framework/Principal/Group.h"
+#include "art/Version/GetReleaseVersion.h"
+#include "art/test/TestObjects/ToyProducts.h"
+#include "canvas/Persistency/Common/Wrapper.h"
+#include "canvas/Persistency/Provenance/BranchDescription.h"
+#include "canvas/Persistency/Provenance/EventAuxiliary.h"
+#include "canvas/Persistency/Provenance/ProcessConfiguration.h"
+#include "canvas/Persistency/Provenance/ProductProvenance.h"
+#include "canvas/Persistency/Provenance/ProductStatus.h"
+#include "canvas/Persistency/Provenance/ProductTables.h"
+#include "canvas/Persistency/Provenance/RangeSet.h"
+#include "canvas/Persistency/Provenance/Timestamp.h"
+#include "canvas/Persistency/Provenance/TypeLabel.h"
+#include "canvas/Utilities/TypeID.h"
+#include "fhiclcpp/ParameterSet.h"
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace art;
+using namespace std::string_literals;
+
+namespace {
+
+  std::string const moduleLabel{"mod"};
+
+  // The products of the input file: "a" and "b" were written, "c"
+  // was never created.
+  ProductTable
+  make_table()
+  {
+    fhicl::ParameterSet processParams;
+    processParams.put("process_name", "EARLY"s);
+    ProcessConfiguration const pc{
+      "EARLY", processParams.id(), getReleaseVersion()};
+    fhicl::ParameterSet modParams;
+    modParams.put("module_type", "DummyModule"s);
+    modParams.put("module_label", moduleLabel);
+    ProductDescriptions descriptions;
+    for (auto const& instance : {"a"s, "b"s, "c"s}) {
+      TypeID const type{typeid(arttest::IntProduct)};
+      descriptions.emplace_back(
+        InEvent,
+        TypeLabel{type,
+                  instance,
+                  SupportsView<arttest::IntProduct>::value,
+                  moduleLabel},
+        moduleLabel,
+        modParams.id(),
+        pc);
+    }
+    return ProductTables{descriptions}.get(InEvent);
+  }
+
+  ProductID
+  product_id(ProductTable const& table, std::string const& instance)
+  {
+    for (auto const& [pid, pd] : table.descriptions) {
+      if (pd.productInstanceName() == instance) {
+        return pid;
+      }
+    }
+    throw std::logic_error{"No product with instance name " + instance};
+  }
+
+  // Reads the products of a batch at once, and any other product on
+  // its own.  If batchReads is false, the reader does not declare
+  // that it reads in batches.
+  class BatchReader : public DelayedReader {
+  public:
+    explicit BatchReader(ProductTable const& table,
+                         bool const batchReads = true)
+      : table_{table}, batchReads_{batchReads}
+    {}
+
+    mutable std::vector<std::vector<ProductID>> batches{};
+    mutable std::vector<ProductID> singleReads{};
+
+  private:
+    std::vector<ProductProvenance>
+    readProvenance_() const override
+    {
+      std::vector<ProductProvenance> result;
+      for (auto const& [pid, pd] : table_.descriptions) {
+        auto const status = pd.productInstanceName() == "c" ?
+                              productstatus::neverCreated() :
+                              productstatus::present();
+        result.emplace_back(pid, status, std::vector<ProductID>{});
+      }
+      return result;
+    }
+
+    bool
+    prefetchesProducts_() const override
+    {
+      return batchReads_;
+    }
+
+    void
+    prefetchProducts_(std::vector<ProductID> const& pids) const override
+    {
+      batches.push_back(pids);
+      for (auto const pid : pids) {
+        cache_.emplace(pid, read(pid));
+      }
+    }
+
+    std::unique_ptr<EDProduct>
+    getProduct_(Group const*, ProductID const pid, RangeSet&) const override
+    {
+      if (auto it = cache_.find(pid); it != cache_.end()) {
+        auto result = std::move(it->second);
+        cache_.erase(it);
+        return result;
+      }
+      singleReads.push_back(pid);
+      return read(pid);
+    }
+
+    static std::unique_ptr<EDProduct>
+    read(ProductID)
+    {
+      return std::make_unique<Wrapper<arttest::IntProduct>>(
+        std::make_unique<arttest::IntProduct>(1));
+    }
+
+    ProductTable const& table_;
+    bool const batchReads_;
+    mutable std::map<ProductID, std::unique_ptr<EDProduct>> cache_{};
+  };
+
+  bool
+  resolve(EventPrincipal const& ep, ProductID const pid)
+  {
+    auto const group = ep.getByProductID(pid).result();
+    return group && group->resolveProductIfAvailable() &&
+           group->anyProduct() != nullptr;
+  }
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(PrefetchProducts_t)
+
+BOOST_AUTO_TEST_CASE(batch_read)
+{
+  auto const table = make_table();
+  auto const a = product_id(table, "a");
+  auto const b = product_id(table, "b");
+  auto const c = product_id(table, "c");
+
+  fhicl::ParameterSet processParams;
+  processParams.put("process_name", "CURRENT"s);
+  ProcessConfiguration const pc{
+    "CURRENT", processParams.id(), getReleaseVersion()};
+  EventAuxiliary const aux{EventID{1, 1, 1}, Timestamp{1234567UL}, true};
+  auto reader = std::make_unique<BatchReader>(table);
+  auto const& batchReader = *reader;
+  EventPrincipal const ep{aux, pc, &table, std::move(reader)};
+
+  BOOST_TEST(ep.prefetchesProducts());
+
+  // The product that was never created is left out of the batch.
+  ep.prefetchProducts({a, c});
+  BOOST_TEST_REQUIRE(batchReader.batches.size() == 1ull);
+  BOOST_TEST((batchReader.batches[0] == std::vector<ProductID>{a}));
+
+  BOOST_TEST(resolve(ep, a));
+  BOOST_TEST(batchReader.singleReads.empty());
+
+  BOOST_TEST(resolve(ep, b));
+  BOOST_TEST((batchReader.singleReads == std::vector<ProductID>{b}));
+
+  BOOST_TEST(!resolve(ep, c));
+}
+
+BOOST_AUTO_TEST_CASE(no_batch_reads)
+{
+  auto const table = make_table();
+  auto const a = product_id(table, "a");
+
+  fhicl::ParameterSet processParams;
+  processParams.put("process_name", "CURRENT"s);
+  ProcessConfiguration const pc{
+    "CURRENT", processParams.id(), getReleaseVersion()};
+  EventAuxiliary const aux{EventID{1, 1, 1}, Timestamp{1234567UL}, true};
+  auto reader = std::make_unique<BatchReader>(table, false);
+  auto const& batchReader = *reader;
+  EventPrincipal const ep{aux, pc, &table, std::move(reader)};
+
+  BOOST_TEST(!ep.prefetchesProducts());
+  ep.prefetchProducts({a});
+  BOOST_TEST(batchReader.batches.empty());
+
+  BOOST_TEST(resolve(ep, a));
+  BOOST_TEST((batchReader.singleReads == std::vector<ProductID>{a}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
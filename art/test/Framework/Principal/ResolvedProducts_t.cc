@@ -0,0 +1,171 @@
+// vim: set sw=2 expandtab :
+#define BOOST_TEST_MODULE (ResolvedProducts_t)
+#include "boost/test/unit_test.hpp"
+
+// =====================================================================
+// ResolvedProducts_t checks that the products matched by a cached
+// getByLabel lookup are reused for principals with the same product
+// tables, but not once the tables have been replaced by those of
+// another input file, even if the new tables have the address of the
+// old ones.
+// =====================================================================
+
+#include "art/Framework/Principal/EventPrincipal.h"
+#include "art/Framework/Principal/ProcessTag.h"
+#include "art/Framework/Principal/detail/ResolvedProducts.h"
+#include "art/Persistency/Common/GroupQueryResult.h"
+#include "art/Persistency/Provenance/ModuleContext.h"
+#include "art/Version/GetReleaseVersion.h"
+#include "art/test/TestObjects/ToyProducts.h"
+#include "canvas/Persistency/Common/WrappedTypeID.h"
+#include "canvas/Persistency/Common/Wrapper.h"
+#include "canvas/Persistency/Provenance/BranchDescription.h"
+#include "canvas/Persistency/Provenance/EventAuxiliary.h"
+#include "canvas/Persistency/Provenance/ProcessConfiguration.h"
+#include "canvas/Persistency/Provenance/ProductProvenance.h"
+#include "canvas/Persistency/Provenance/ProductStatus.h"
+#include "canvas/Persistency/Provenance/ProductTables.h"
+#include "canvas/Persistency/Provenance/RangeSet.h"
+#include "canvas/Persistency/Provenance/Timestamp.h"
+#include "canvas/Persistency/Provenance/TypeLabel.h"
+#include "canvas/Utilities/TypeID.h"
+#include "fhiclcpp/ParameterSet.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace art;
+using namespace std::string_literals;
+
+namespace {
+
+  std::string const processName{"TEST"};
+  std::string const moduleLabel{"mod"};
+
+  ProcessConfiguration const&
+  process()
+  {
+    static ProcessConfiguration const pc = [] {
+      fhicl::ParameterSet processParams;
+      processParams.put("process_name", processName);
+      return ProcessConfiguration{
+        processName, processParams.id(), getReleaseVersion()};
+    }();
+    return pc;
+  }
+
+  // The products of a "file", with the given instance names.
+  ProductTables
+  make_tables(std::vector<std::string> const& instances)
+  {
+    fhicl::ParameterSet modParams;
+    modParams.put("module_type", "DummyModule"s);
+    modParams.put("module_label", moduleLabel);
+    ProductDescriptions descriptions;
+    for (auto const& instance : instances) {
+      TypeID const type{typeid(arttest::IntProduct)};
+      descriptions.emplace_back(
+        InEvent,
+        TypeLabel{type,
+                  instance,
+                  SupportsView<arttest::IntProduct>::value,
+                  false},
+        moduleLabel,
+        modParams.id(),
+        process());
+    }
+    return ProductTables{descriptions};
+  }
+
+  std::unique_ptr<EventPrincipal>
+  make_event(ProductTables const& tables)
+  {
+    constexpr Timestamp now{1234567UL};
+    EventAuxiliary const aux{EventID{1, 1, 1}, now, true};
+    auto result = std::make_unique<EventPrincipal>(aux, process(), nullptr);
+    result->createGroupsForProducedProducts(tables);
+    result->enableLookupOfProducedProducts();
+    for (auto const& pr : tables.get(InEvent).descriptions) {
+      auto const& pd = pr.second;
+      result->put(pd,
+                  std::make_unique<ProductProvenance const>(
+                    pd.productID(),
+                    productstatus::present(),
+                    std::vector<ProductID>{}),
+                  std::make_unique<Wrapper<arttest::IntProduct>>(
+                    std::make_unique<arttest::IntProduct>(1)),
+                  std::make_unique<RangeSet>(RangeSet::invalid()));
+    }
+    return result;
+  }
+
+  GroupQueryResult
+  get(EventPrincipal const& ep,
+      std::string const& instance,
+      detail::ResolvedProductsSlot& slot)
+  {
+    return ep.getByLabel(ModuleContext::invalid(),
+                         WrappedTypeID::make<arttest::IntProduct>(),
+                         moduleLabel,
+                         instance,
+                         ProcessTag{""s, processName},
+                         &slot);
+  }
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ResolvedProducts_t)
+
+BOOST_AUTO_TEST_CASE(reuse_within_file)
+{
+  auto const tables = make_tables({"a"});
+  detail::ResolvedProductsSlot slot;
+
+  auto const first = make_event(tables);
+  BOOST_TEST(get(*first, "a", slot).succeeded());
+  auto const resolved = slot.load();
+  BOOST_TEST_REQUIRE(resolved != nullptr);
+
+  auto const second = make_event(tables);
+  BOOST_TEST(get(*second, "a", slot).succeeded());
+  BOOST_TEST(slot.load() == resolved);
+}
+
+BOOST_AUTO_TEST_CASE(switch_files)
+{
+  // The tables of both "files" are placed in the same storage, so
+  // that they have the same address.
+  std::optional<ProductTables> tables;
+  detail::ResolvedProductsSlot slotA;
+  detail::ResolvedProductsSlot slotB;
+
+  tables.emplace(make_tables({"a"}));
+  auto const* tableA = &tables->get(InEvent);
+  auto eventA = make_event(*tables);
+  BOOST_TEST(get(*eventA, "a", slotA).succeeded());
+  BOOST_TEST(!get(*eventA, "b", slotB).succeeded());
+  auto const resolvedA = slotA.load();
+  auto const resolvedB = slotB.load();
+  BOOST_TEST_REQUIRE(resolvedA != nullptr);
+  BOOST_TEST_REQUIRE(resolvedB != nullptr);
+  BOOST_TEST(resolvedA->produced.size() == 1ull);
+  BOOST_TEST(resolvedB->produced.empty());
+  eventA.reset();
+
+  // Open the next file, which has a different product set.
+  tables.reset();
+  detail::advance_product_tables_generation();
+  tables.emplace(make_tables({"b"}));
+  BOOST_TEST_REQUIRE(&tables->get(InEvent) == tableA);
+  auto const eventB = make_event(*tables);
+  BOOST_TEST(!get(*eventB, "a", slotA).succeeded());
+  BOOST_TEST(get(*eventB, "b", slotB).succeeded());
+  BOOST_TEST_REQUIRE(slotA.load() != resolvedA);
+  BOOST_TEST_REQUIRE(slotB.load() != resolvedB);
+  BOOST_TEST(slotA.load()->produced.empty());
+  BOOST_TEST(slotB.load()->produced.size() == 1ull);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
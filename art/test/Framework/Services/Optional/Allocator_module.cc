@@ -0,0 +1,34 @@
+// Allocates a buffer of 'numBytes' for each event, and frees the
+// buffer of the previous event, so that the MemoryTracker can be
+// checked against a known allocation.
+
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "fhiclcpp/types/Atom.h"
+
+#include <cstddef>
+#include <memory>
+
+namespace {
+  class Allocator : public art::EDAnalyzer {
+  public:
+    struct Config {
+      fhicl::Atom<std::size_t> numBytes{fhicl::Name{"numBytes"}};
+    };
+    using Parameters = Table<Config>;
+    explicit Allocator(Parameters const& p)
+      : EDAnalyzer{p}, nBytes_{p().numBytes()}
+    {}
+
+  private:
+    void
+    analyze(art::Event const&) override
+    {
+      buffer_ = std::make_unique<char[]>(nBytes_);
+    }
+
+    std::size_t const nBytes_;
+    std::unique_ptr<char[]> buffer_;
+  };
+}
+
+DEFINE_ART_MODULE(Allocator)
@@ -0,0 +1,70 @@
+// vim: set sw=2 expandtab :
+#define BOOST_TEST_MODULE (MemoryTrackerAllocations_r)
+#include "boost/test/unit_test.hpp"
+
+// ======================================================================
+// MemoryTrackerAllocations_r reads the allocation tables written by
+// the MemoryTrackerAllocations_w job, in which the Allocator module a
+// allocates 10 MB (base 10) for each of 5 events.  The counts include
+// a small framework overhead.
+// ======================================================================
+
+#include "sqlite3.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+  constexpr auto db_file = "../MemoryTrackerAllocations_w.d/allocations.db";
+
+  // Each row of the result of the query, which must select doubles.
+  std::vector<std::vector<double>>
+  rows(std::string const& query)
+  {
+    sqlite3* db{nullptr};
+    BOOST_TEST_REQUIRE(sqlite3_open_v2(
+                         db_file, &db, SQLITE_OPEN_READONLY, nullptr) ==
+                       SQLITE_OK);
+    sqlite3_stmt* stmt{nullptr};
+    BOOST_TEST_REQUIRE(
+      sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK);
+    std::vector<std::vector<double>> result;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+      auto& row = result.emplace_back();
+      for (int i{}; i != sqlite3_column_count(stmt); ++i) {
+        row.push_back(sqlite3_column_double(stmt, i));
+      }
+    }
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+    return result;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(MemoryTrackerAllocations_r)
+
+BOOST_AUTO_TEST_CASE(module_allocations)
+{
+  auto const result = rows("SELECT Allocated, HighWater FROM "
+                           "ModuleAllocations WHERE ModuleLabel = 'a'");
+  BOOST_TEST(result.size() == 5ull);
+  for (auto const& row : result) {
+    BOOST_TEST(row[0] >= 10.);
+    BOOST_TEST(row[0] < 11.);
+    BOOST_TEST(row[1] >= 10.);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(event_allocations)
+{
+  auto const result =
+    rows("SELECT Event, Allocated FROM EventAllocations ORDER BY Event");
+  BOOST_TEST_REQUIRE(result.size() == 5ull);
+  for (std::size_t i{}; i != result.size(); ++i) {
+    BOOST_TEST(result[i][0] == static_cast<double>(i + 1));
+    BOOST_TEST(result[i][1] >= 10.);
+    BOOST_TEST(result[i][1] < 11.);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
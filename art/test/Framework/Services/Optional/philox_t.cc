@@ -0,0 +1,35 @@
+#define BOOST_TEST_MODULE (philox_t)
+#include "boost/test/unit_test.hpp"
+
+#include "art/Framework/Services/Optional/detail/philox.h"
+
+using art::detail::philox4x32;
+using art::detail::philox_counter;
+using art::detail::philox_key_for;
+
+BOOST_AUTO_TEST_SUITE(philox_t)
+
+// Known-answer vectors of the Random123 library.
+BOOST_AUTO_TEST_CASE(known_answers)
+{
+  BOOST_TEST(philox4x32({0, 0, 0, 0}, {0, 0}) ==
+             (philox_counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  BOOST_TEST(philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                        {0xffffffff, 0xffffffff}) ==
+             (philox_counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+  BOOST_TEST(philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                        {0xa4093822, 0x299f31d0}) ==
+             (philox_counter{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+BOOST_AUTO_TEST_CASE(keys)
+{
+  auto const key = philox_key_for(13597, "generator", "");
+  BOOST_TEST(key == philox_key_for(13597, "generator", ""));
+  BOOST_TEST(key != philox_key_for(13598, "generator", ""));
+  BOOST_TEST(key != philox_key_for(13597, "digitizer", ""));
+  BOOST_TEST(key != philox_key_for(13597, "generator", "noise"));
+  BOOST_TEST(philox_key_for(1, "ab", "c") != philox_key_for(1, "a", "bc"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
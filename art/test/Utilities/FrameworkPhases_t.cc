@@ -0,0 +1,86 @@
+#define BOOST_TEST_MODULE (FrameworkPhases_t)
+#include "boost/test/unit_test.hpp"
+
+#include "art/Utilities/FrameworkPhases.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+using art::FrameworkPhase;
+using art::FrameworkPhaseSentry;
+using art::ScheduleID;
+
+namespace {
+  auto
+  phase_time(art::FrameworkPhaseTimes const& times, FrameworkPhase const p)
+  {
+    return times[static_cast<std::size_t>(p)];
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(FrameworkPhases_t)
+
+BOOST_AUTO_TEST_CASE(inactive)
+{
+  BOOST_TEST(!art::frameworkPhaseAccountingActive());
+  {
+    FrameworkPhaseSentry const sentry{FrameworkPhase::EventWrite,
+                                      ScheduleID::first()};
+  }
+  auto const times = art::takeFrameworkPhaseTimes(ScheduleID::first());
+  BOOST_TEST(phase_time(times, FrameworkPhase::EventWrite).count() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(nested)
+{
+  art::activateFrameworkPhaseAccounting(2);
+  auto const sid = ScheduleID::first();
+  {
+    FrameworkPhaseSentry const outer{FrameworkPhase::EventWrite, sid};
+    std::this_thread::sleep_for(5ms);
+    FrameworkPhaseSentry const inner{FrameworkPhase::OutputSelection, sid};
+    std::this_thread::sleep_for(20ms);
+  }
+  auto const times = art::takeFrameworkPhaseTimes(sid);
+  auto const write = phase_time(times, FrameworkPhase::EventWrite);
+  auto const selection = phase_time(times, FrameworkPhase::OutputSelection);
+  BOOST_TEST((selection >= 20ms));
+  BOOST_TEST((write >= 5ms));
+  BOOST_TEST((write < 20ms));
+
+  // Taking the times resets them; other schedules are not affected.
+  auto const again = art::takeFrameworkPhaseTimes(sid);
+  BOOST_TEST(phase_time(again, FrameworkPhase::EventWrite).count() == 0);
+  auto const other = art::takeFrameworkPhaseTimes(ScheduleID{1});
+  BOOST_TEST(phase_time(other, FrameworkPhase::OutputSelection).count() == 0);
+  art::deactivateFrameworkPhaseAccounting();
+}
+
+BOOST_AUTO_TEST_CASE(enclosing_schedule)
+{
+  art::activateFrameworkPhaseAccounting(2);
+  ScheduleID const sid{1};
+  {
+    // Outside of any phase, nothing is recorded.
+    FrameworkPhaseSentry const read{FrameworkPhase::ProductRead};
+    std::this_thread::sleep_for(5ms);
+  }
+  for (auto const s : {ScheduleID::first(), sid}) {
+    auto const times = art::takeFrameworkPhaseTimes(s);
+    BOOST_TEST(phase_time(times, FrameworkPhase::ProductRead).count() == 0);
+  }
+  {
+    FrameworkPhaseSentry const lookup{FrameworkPhase::ProductLookup, sid};
+    FrameworkPhaseSentry const read{FrameworkPhase::ProductRead};
+    std::this_thread::sleep_for(20ms);
+  }
+  auto const times = art::takeFrameworkPhaseTimes(sid);
+  auto const lookup = phase_time(times, FrameworkPhase::ProductLookup);
+  auto const read = phase_time(times, FrameworkPhase::ProductRead);
+  BOOST_TEST((read >= 20ms));
+  BOOST_TEST((lookup < 20ms));
+  art::deactivateFrameworkPhaseAccounting();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,59 @@
+#define BOOST_TEST_MODULE (SPSCRingBuffer_t)
+#include "boost/test/unit_test.hpp"
+
+#include "art/Utilities/detail/SPSCRingBuffer.h"
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using art::detail::SPSCRingBuffer;
+
+BOOST_AUTO_TEST_SUITE(SPSCRingBuffer_t)
+
+BOOST_AUTO_TEST_CASE(capacity)
+{
+  BOOST_TEST(SPSCRingBuffer<int>{1}.capacity() == 1u);
+  BOOST_TEST(SPSCRingBuffer<int>{4}.capacity() == 4u);
+  BOOST_TEST(SPSCRingBuffer<int>{5}.capacity() == 8u);
+}
+
+BOOST_AUTO_TEST_CASE(full_and_drain)
+{
+  SPSCRingBuffer<int> ring{4};
+  for (int i{}; i != 4; ++i) {
+    BOOST_TEST(ring.try_push(i));
+  }
+  BOOST_TEST(!ring.try_push(4));
+  std::vector<int> drained;
+  BOOST_TEST(ring.drain([&drained](int const i) { drained.push_back(i); }) ==
+             4u);
+  BOOST_TEST(drained == (std::vector<int>{0, 1, 2, 3}));
+  BOOST_TEST(ring.drain([](int) {}) == 0u);
+  BOOST_TEST(ring.try_push(4));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent)
+{
+  std::size_t constexpr n{100000};
+  SPSCRingBuffer<std::size_t> ring{64};
+  std::thread producer{[&ring] {
+    for (std::size_t i{}; i != n; ++i) {
+      while (!ring.try_push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  }};
+  std::size_t expected{};
+  bool in_order{true};
+  while (expected != n) {
+    ring.drain([&expected, &in_order](std::size_t const i) {
+      in_order = in_order && (i == expected);
+      ++expected;
+    });
+  }
+  producer.join();
+  BOOST_TEST(in_order);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,38 @@
+#define BOOST_TEST_MODULE (SpanStarts_t)
+#include "boost/test/unit_test.hpp"
+
+#include "art/Utilities/detail/SpanStarts.h"
+
+using art::detail::SpanStarts;
+
+namespace {
+  char const a{};
+  char const b{};
+  char const c{};
+}
+
+BOOST_AUTO_TEST_SUITE(SpanStarts_t)
+
+BOOST_AUTO_TEST_CASE(nested)
+{
+  SpanStarts<int> starts;
+  starts.open(&a, 1);
+  starts.open(&b, 2);
+  BOOST_TEST(starts.close(&b).value() == 2);
+  BOOST_TEST(starts.close(&a).value() == 1);
+  BOOST_TEST(!starts.close(&a).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(unclosed)
+{
+  // The span of b is never closed, as if its module had thrown.
+  SpanStarts<int> starts;
+  starts.open(&a, 1);
+  starts.open(&b, 2);
+  starts.open(&c, 3);
+  BOOST_TEST(starts.close(&c).value() == 3);
+  BOOST_TEST(starts.close(&a).value() == 1);
+  BOOST_TEST(!starts.close(&b).has_value());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,29 @@
+#define BOOST_TEST_MODULE (cpu_list_t)
+#include "boost/test/unit_test.hpp"
+
+#include "art/Utilities/detail/cpu_list.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <vector>
+
+using art::detail::parse_cpu_list;
+using cpus = std::vector<unsigned>;
+
+BOOST_AUTO_TEST_SUITE(cpu_list_t)
+
+BOOST_AUTO_TEST_CASE(ranges)
+{
+  BOOST_TEST(parse_cpu_list("").empty());
+  BOOST_TEST(parse_cpu_list("3") == (cpus{3}));
+  BOOST_TEST(parse_cpu_list("0-3") == (cpus{0, 1, 2, 3}));
+  BOOST_TEST(parse_cpu_list("0-1,8,10-11\n") == (cpus{0, 1, 8, 10, 11}));
+}
+
+BOOST_AUTO_TEST_CASE(malformed)
+{
+  BOOST_CHECK_THROW(parse_cpu_list("a"), art::Exception);
+  BOOST_CHECK_THROW(parse_cpu_list("3-1"), art::Exception);
+  BOOST_CHECK_THROW(parse_cpu_list("1:2"), art::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()